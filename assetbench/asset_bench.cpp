@@ -0,0 +1,719 @@
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <filesystem>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "json.hpp"
+#include "asset_core.h"
+#include "mesh_asset.h"
+#include "texture_asset.h"
+#include "block_compression.h"
+#include "texture_mips.h"
+#include "vertex_kernels.h"
+
+constexpr const char* INDENT = "    ";
+constexpr int DEFAULT_ITERATIONS = 20;
+
+namespace fs = std::filesystem;
+namespace timer = std::chrono;
+using namespace assets;
+
+
+// Every heap allocation in the process goes through here, so each benchmark can report how many
+// it made per operation. Worker threads started by the unpackers are counted too.
+static std::atomic<uint64_t> allocCount{ 0 };
+static std::atomic<uint64_t> allocBytes{ 0 };
+
+// GCC sees free() on memory from operator new and warns, not knowing that this operator new is
+// the malloc below; the replacements are a matched pair
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(size_t size)
+{
+	allocCount.fetch_add(1, std::memory_order_relaxed);
+	allocBytes.fetch_add(size, std::memory_order_relaxed);
+	if (void* p = std::malloc(size > 0 ? size : 1))
+		return p;
+	throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+
+struct BenchOptions
+{
+	int iterations{ DEFAULT_ITERATIONS };
+	std::string filter;
+	std::string jsonPath;
+};
+
+struct BenchResult
+{
+	std::string name;
+	std::string asset;
+	int iterations{ 0 };
+	uint64_t bytes{ 0 };		// Bytes processed per operation, 0 where throughput means nothing
+	double nsPerOp{ 0.0 };
+	double minNsPerOp{ 0.0 };
+	double mbPerSec{ 0.0 };
+	double allocsPerOp{ 0.0 };
+	double allocBytesPerOp{ 0.0 };
+};
+
+static BenchOptions options;
+static std::vector<BenchResult> results;
+
+// Results a bench would otherwise drop land here, so the work that makes them can't be optimised away
+static volatile float benchSink = 0.0f;
+
+static void Sink(const MeshBounds& bounds)
+{
+	benchSink = bounds.origin[0] + bounds.origin[1] + bounds.origin[2] + bounds.radius + bounds.extents[0] + bounds.extents[1] + bounds.extents[2];
+}
+
+template<typename F>
+void RunBench(const char* name, const std::string& asset, uint64_t bytes, F&& func)
+{
+	if (!options.filter.empty() && std::string(name).find(options.filter) == std::string::npos)
+		return;
+
+	// Warm the page cache and any lazily grown buffers, so only steady-state work is measured
+	func();
+
+	double totalNs = 0.0;
+	double minNs = 0.0;
+	const uint64_t allocCountStart = allocCount.load();
+	const uint64_t allocBytesStart = allocBytes.load();
+
+	for (int i = 0; i < options.iterations; ++i)
+	{
+		auto start = timer::high_resolution_clock::now();
+		func();
+		double ns = static_cast<double>(timer::duration_cast<timer::nanoseconds>(timer::high_resolution_clock::now() - start).count());
+
+		totalNs += ns;
+		minNs = (i == 0 || ns < minNs) ? ns : minNs;
+	}
+
+	const uint64_t allocCountDiff = allocCount.load() - allocCountStart;
+	const uint64_t allocBytesDiff = allocBytes.load() - allocBytesStart;
+
+	BenchResult result;
+	result.name = name;
+	result.asset = asset;
+	result.iterations = options.iterations;
+	result.bytes = bytes;
+	result.nsPerOp = totalNs / options.iterations;
+	result.minNsPerOp = minNs;
+	result.mbPerSec = (bytes > 0) ? (bytes / (1024.0 * 1024.0)) / (result.nsPerOp / 1e9) : 0.0;
+	result.allocsPerOp = static_cast<double>(allocCountDiff) / options.iterations;
+	result.allocBytesPerOp = static_cast<double>(allocBytesDiff) / options.iterations;
+
+	std::cout << INDENT << std::left << std::setw(28) << name << std::right
+		<< std::fixed << std::setprecision(0) << std::setw(14) << result.nsPerOp << " ns/op"
+		<< std::setprecision(1) << std::setw(10);
+	if (bytes > 0)
+		std::cout << result.mbPerSec << " MB/s";
+	else
+		std::cout << "-" << "     ";
+	std::cout << std::setprecision(1) << std::setw(10) << result.allocsPerOp << " allocs"
+		<< std::setprecision(0) << std::setw(12) << result.allocBytesPerOp << " B/op" << std::endl;
+
+	results.push_back(result);
+}
+
+bool BenchMesh(const fs::path& path)
+{
+	const std::string pathStr = path.u8string();
+	const std::string asset = path.filename().u8string();
+
+	AssetView view;
+	if (!LoadBinaryMapped(pathStr.c_str(), view))
+		return false;
+
+	MeshInfo probeInfo;
+	if (!ReadMeshInfo(&view, probeInfo))
+		return false;
+	const size_t fileSize = view.file.Size();
+	const uint64_t unpackedSize = probeInfo.vertexBufferSize + probeInfo.indexBufferSize;
+
+	// Stand-in for the staging buffers the engine decompresses into
+	std::vector<char> vertexBuffer(probeInfo.vertexBufferSize);
+	std::vector<char> indexBuffer(probeInfo.indexBufferSize);
+	if (!UnpackMesh(&probeInfo, view.blob, view.blobSize, vertexBuffer.data(), indexBuffer.data()))
+		return false;
+
+	RunBench("LoadBinary", asset, fileSize, [&]()
+		{
+			AssetFile file;
+			LoadBinary(pathStr.c_str(), file);
+		});
+
+	RunBench("LoadBinaryMapped", asset, fileSize, [&]()
+		{
+			AssetView mapped;
+			LoadBinaryMapped(pathStr.c_str(), mapped);
+		});
+
+	RunBench("ReadMeshInfo", asset, 0, [&]()
+		{
+			MeshInfo info;
+			ReadMeshInfo(&view, info);
+		});
+
+	RunBench("UnpackMesh", asset, unpackedSize, [&]()
+		{
+			MeshInfo info = probeInfo;
+			UnpackMesh(&info, view.blob, view.blobSize, vertexBuffer.data(), indexBuffer.data());
+		});
+
+	RunBench("UnpackMesh verified", asset, unpackedSize, [&]()
+		{
+			MeshInfo info = probeInfo;
+			UnpackMesh(&info, view.blob, view.blobSize, vertexBuffer.data(), indexBuffer.data(), VerifyContent);
+		});
+
+	RunBench("LoadBinary + UnpackMesh", asset, fileSize, [&]()
+		{
+			AssetFile file;
+			LoadBinary(pathStr.c_str(), file);
+			MeshInfo info;
+			ReadMeshInfo(&file, info);
+			UnpackMesh(&info, file.blob.data(), file.blob.size(), vertexBuffer.data(), indexBuffer.data());
+		});
+
+	RunBench("Mapped + UnpackMesh", asset, fileSize, [&]()
+		{
+			AssetView mapped;
+			LoadBinaryMapped(pathStr.c_str(), mapped, VerifyBlob);
+			MeshInfo info;
+			ReadMeshInfo(&mapped, info);
+			UnpackMesh(&info, mapped.blob, mapped.blobSize, vertexBuffer.data(), indexBuffer.data());
+		});
+
+	RunBench("PackMesh", asset, unpackedSize, [&]()
+		{
+			MeshInfo info = probeInfo;
+			AssetFile packed = PackMesh(&info, vertexBuffer.data(), indexBuffer.data());
+		});
+
+	if (probeInfo.vertexFormat == VertexFormat::PNCV_F32)
+	{
+		const Vertex_PNCV_F32* vertices = reinterpret_cast<const Vertex_PNCV_F32*>(vertexBuffer.data());
+		const size_t vertexCount = probeInfo.vertexBufferSize / sizeof(Vertex_PNCV_F32);
+		RunBench("CalculateBounds", asset, probeInfo.vertexBufferSize, [&]()
+			{
+				Sink(CalculateBounds(vertices, vertexCount));
+			});
+	}
+
+	return true;
+}
+
+bool BenchTexture(const fs::path& path)
+{
+	const std::string pathStr = path.u8string();
+	const std::string asset = path.filename().u8string();
+
+	AssetView view;
+	if (!LoadBinaryMapped(pathStr.c_str(), view))
+		return false;
+
+	TextureInfo probeInfo;
+	if (!ReadTextureInfo(&view, probeInfo))
+		return false;
+	const size_t fileSize = view.file.Size();
+
+	std::vector<char> pixels(probeInfo.dataSize);
+	if (!UnpackTexture(&probeInfo, view.blob, view.blobSize, pixels.data()))
+		return false;
+
+	RunBench("LoadBinary", asset, fileSize, [&]()
+		{
+			AssetFile file;
+			LoadBinary(pathStr.c_str(), file);
+		});
+
+	RunBench("LoadBinaryMapped", asset, fileSize, [&]()
+		{
+			AssetView mapped;
+			LoadBinaryMapped(pathStr.c_str(), mapped);
+		});
+
+	RunBench("ReadTextureInfo", asset, 0, [&]()
+		{
+			TextureInfo info;
+			ReadTextureInfo(&view, info);
+		});
+
+	RunBench("UnpackTexture", asset, probeInfo.dataSize, [&]()
+		{
+			UnpackTexture(&probeInfo, view.blob, view.blobSize, pixels.data());
+		});
+
+	RunBench("UnpackTexture verified", asset, probeInfo.dataSize, [&]()
+		{
+			UnpackTexture(&probeInfo, view.blob, view.blobSize, pixels.data(), VerifyContent);
+		});
+
+	RunBench("UnpackTexturePage", asset, probeInfo.dataSize, [&]()
+		{
+			size_t offset = 0;
+			for (uint32_t i = 0; i < probeInfo.pages.size(); ++i)
+			{
+				UnpackTexturePage(&probeInfo, i, view.blob, view.blobSize, pixels.data() + offset);
+				offset += probeInfo.pages[i].originalSize;
+			}
+		});
+
+	// Low resolution first: everything but the top two mips
+	if (probeInfo.pages.size() > 2)
+	{
+		const uint32_t mipCount = static_cast<uint32_t>(probeInfo.pages.size()) - 2;
+		RunBench("UnpackTextureMips 2..end", asset, GetTextureMipsSize(&probeInfo, 2, mipCount), [&]()
+			{
+				UnpackTextureMips(&probeInfo, 2, mipCount, view.blob, view.blobSize, pixels.data());
+			});
+	}
+
+	RunBench("LoadBinary + UnpackTexture", asset, fileSize, [&]()
+		{
+			AssetFile file;
+			LoadBinary(pathStr.c_str(), file);
+			TextureInfo info;
+			ReadTextureInfo(&file, info);
+			UnpackTexture(&info, file.blob.data(), file.blob.size(), pixels.data());
+		});
+
+	RunBench("Mapped + UnpackTexture", asset, fileSize, [&]()
+		{
+			AssetView mapped;
+			LoadBinaryMapped(pathStr.c_str(), mapped, VerifyBlob);
+			TextureInfo info;
+			ReadTextureInfo(&mapped, info);
+			UnpackTexture(&info, mapped.blob, mapped.blobSize, pixels.data());
+		});
+
+	RunBench("PackTexture", asset, probeInfo.dataSize, [&]()
+		{
+			TextureInfo info = probeInfo;
+			AssetFile packed = PackTexture(&info, pixels.data());
+		});
+
+	// The cooker's block encoders on the top mip, when there are still texels to encode
+	if (probeInfo.textureFormat == TextureFormat::RGBA8)
+	{
+		const PageInfo& top = probeInfo.pages[0];
+		std::vector<char> blocks(GetTextureMipSize(TextureFormat::BC7, top.width, top.height));
+		for (TextureFormat format : { TextureFormat::BC1, TextureFormat::BC7 })
+		{
+			const std::string name = std::string("CompressTextureBlocks ") + TextureFormatName(format);
+			RunBench(name.c_str(), asset, top.originalSize, [&]()
+				{
+					CompressTextureBlocks(format, reinterpret_cast<const uint8_t*>(pixels.data()), top.width, top.height, blocks.data());
+				});
+		}
+	}
+
+	return true;
+}
+
+// Generated vertices through each vertex kernel and its scalar version. Results have to agree
+// before the timings mean anything: integers within one step (rounding ties can go either way
+// when the compiler contracts the scalar maths), floats within a few ulps.
+bool BenchKernels()
+{
+	constexpr size_t vertexCount = 256 * 1024;
+	const std::string asset = std::string("kernels ") + GetVertexKernelPath();
+
+	uint32_t seed = 12345;
+	auto random = [&seed]()
+	{
+		seed = seed * 1664525u + 1013904223u;
+		return static_cast<float>(seed >> 8) / 16777216.0f;
+	};
+
+	// Positions walk a noisy surface in order, the way cooked vertices are laid out, with negative
+	// coordinates since the old bounds code got those wrong. Normals point anywhere.
+	constexpr size_t rowLength = 512;
+	std::vector<Vertex_PNCV_F32> vertices(vertexCount);
+	for (size_t i = 0; i < vertexCount; ++i)
+	{
+		Vertex_PNCV_F32& v = vertices[i];
+		const float x = static_cast<float>(i % rowLength);
+		const float z = static_cast<float>(i / rowLength);
+		v.position[0] = x - 400.0f + random();
+		v.position[1] = std::sin(x * 0.05f) * std::cos(z * 0.05f) * 20.0f + random();
+		v.position[2] = z - 100.0f + random();
+
+		for (int k = 0; k < 3; ++k)
+			v.normal[k] = random() * 2.0f - 1.0f;
+	}
+
+	// The encoder's special cases: zero length, the poles and signed zeroes
+	const float specialNormals[][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, -1.0f }, { -0.0f, 1.0f, -0.0f }, { 1.0f, -0.0f, -1.0f } };
+	for (size_t i = 0; i < std::size(specialNormals); ++i)
+		std::memcpy(vertices[i * 7].normal, specialNormals[i], sizeof(specialNormals[i]));
+
+	const float* positions = vertices[0].position;
+	const float* normals = vertices[0].normal;
+	constexpr size_t stride = sizeof(Vertex_PNCV_F32);
+
+	std::vector<uint8_t> encoded(vertexCount * 2), encodedScalar(vertexCount * 2);
+	std::vector<float> decoded(vertexCount * 3), decodedScalar(vertexCount * 3);
+	std::vector<uint16_t> quantized(vertexCount * 3), quantizedScalar(vertexCount * 3);
+
+	EncodeOctNormals(normals, stride, encoded.data(), 2, vertexCount);
+	EncodeOctNormalsScalar(normals, stride, encodedScalar.data(), 2, vertexCount);
+	DecodeOctNormals(encodedScalar.data(), 2, decoded.data(), 3 * sizeof(float), vertexCount);
+	DecodeOctNormalsScalar(encodedScalar.data(), 2, decodedScalar.data(), 3 * sizeof(float), vertexCount);
+	const MeshBounds bounds = CalculatePositionBounds(positions, stride, vertexCount);
+	const MeshBounds boundsScalar = CalculatePositionBoundsScalar(positions, stride, vertexCount);
+	QuantizePositions(positions, stride, boundsScalar, quantized.data(), 3 * sizeof(uint16_t), vertexCount);
+	QuantizePositionsScalar(positions, stride, boundsScalar, quantizedScalar.data(), 3 * sizeof(uint16_t), vertexCount);
+
+	auto closeInt = [](int a, int b) { return std::abs(a - b) <= 1; };
+	auto closeFloat = [](float a, float b) { return std::fabs(a - b) <= 1e-6f * std::max(1.0f, std::fabs(b)); };
+
+	size_t mismatches = 0;
+	for (size_t i = 0; i < encoded.size(); ++i)
+		mismatches += closeInt(encoded[i], encodedScalar[i]) ? 0 : 1;
+	for (size_t i = 0; i < decoded.size(); ++i)
+		mismatches += closeFloat(decoded[i], decodedScalar[i]) ? 0 : 1;
+	for (size_t i = 0; i < quantized.size(); ++i)
+		mismatches += closeInt(quantized[i], quantizedScalar[i]) ? 0 : 1;
+	for (int k = 0; k < 3; ++k)
+	{
+		mismatches += closeFloat(bounds.origin[k], boundsScalar.origin[k]) ? 0 : 1;
+		mismatches += closeFloat(bounds.extents[k], boundsScalar.extents[k]) ? 0 : 1;
+	}
+	mismatches += closeFloat(bounds.radius, boundsScalar.radius) ? 0 : 1;
+
+	if (mismatches > 0)
+	{
+		std::cout << INDENT << "ERROR: " << mismatches << " values differ between the " << GetVertexKernelPath() << " and scalar vertex kernels" << std::endl;
+		return false;
+	}
+
+	RunBench("EncodeOctNormals", asset, vertexCount * 3 * sizeof(float), [&]()
+		{
+			EncodeOctNormals(normals, stride, encoded.data(), 2, vertexCount);
+		});
+
+	RunBench("EncodeOctNormals scalar", asset, vertexCount * 3 * sizeof(float), [&]()
+		{
+			EncodeOctNormalsScalar(normals, stride, encoded.data(), 2, vertexCount);
+		});
+
+	RunBench("DecodeOctNormals", asset, vertexCount * 2, [&]()
+		{
+			DecodeOctNormals(encodedScalar.data(), 2, decoded.data(), 3 * sizeof(float), vertexCount);
+		});
+
+	RunBench("DecodeOctNormals scalar", asset, vertexCount * 2, [&]()
+		{
+			DecodeOctNormalsScalar(encodedScalar.data(), 2, decoded.data(), 3 * sizeof(float), vertexCount);
+		});
+
+	RunBench("CalculatePositionBounds", asset, vertexCount * 3 * sizeof(float), [&]()
+		{
+			Sink(CalculatePositionBounds(positions, stride, vertexCount));
+		});
+
+	RunBench("CalculatePositionBounds scalar", asset, vertexCount * 3 * sizeof(float), [&]()
+		{
+			Sink(CalculatePositionBoundsScalar(positions, stride, vertexCount));
+		});
+
+	RunBench("QuantizePositions", asset, vertexCount * 3 * sizeof(float), [&]()
+		{
+			QuantizePositions(positions, stride, boundsScalar, quantized.data(), 3 * sizeof(uint16_t), vertexCount);
+		});
+
+	RunBench("QuantizePositions scalar", asset, vertexCount * 3 * sizeof(float), [&]()
+		{
+			QuantizePositionsScalar(positions, stride, boundsScalar, quantized.data(), 3 * sizeof(uint16_t), vertexCount);
+		});
+
+	return true;
+}
+
+// The cooker's mip chain generation on a generated image, vectorized against scalar. Both sum in
+// the same order, so they're expected to match exactly; anything more than one step off is a bug.
+bool BenchMips()
+{
+	constexpr uint32_t dim = 1024;
+	const std::string asset = std::string("mips ") + GetMipKernelPath();
+
+	// Gradients with a hard-edged grid over them, so the filters have both smooth and sharp content
+	std::vector<uint8_t> pixels(static_cast<size_t>(dim) * dim * 4);
+	for (uint32_t y = 0; y < dim; ++y)
+	{
+		for (uint32_t x = 0; x < dim; ++x)
+		{
+			uint8_t* p = &pixels[(static_cast<size_t>(y) * dim + x) * 4];
+			const bool line = (x % 64) < 2 || (y % 64) < 2;
+			p[0] = line ? 255 : static_cast<uint8_t>(x / 4);
+			p[1] = line ? 0 : static_cast<uint8_t>(y / 4);
+			p[2] = static_cast<uint8_t>((x ^ y) & 0xFF);
+			p[3] = static_cast<uint8_t>(255 - x / 8);
+		}
+	}
+
+	std::vector<uint8_t> chain, chainScalar;
+	for (MipFilter filter : { MipFilter::Box, MipFilter::Kaiser, MipFilter::Lanczos })
+	{
+		GenerateMipChain(pixels.data(), dim, dim, filter, true, chain);
+		GenerateMipChainScalar(pixels.data(), dim, dim, filter, true, chainScalar);
+
+		size_t mismatches = 0;
+		for (size_t i = 0; i < chain.size(); ++i)
+			mismatches += (std::abs(chain[i] - chainScalar[i]) <= 1) ? 0 : 1;
+
+		if (mismatches > 0)
+		{
+			std::cout << INDENT << "ERROR: " << mismatches << " bytes differ between the " << GetMipKernelPath() << " and scalar " << MipFilterName(filter) << " mip chains" << std::endl;
+			return false;
+		}
+	}
+
+	for (MipFilter filter : { MipFilter::Box, MipFilter::Kaiser })
+	{
+		const std::string name = std::string("GenerateMipChain ") + MipFilterName(filter);
+		RunBench(name.c_str(), asset, pixels.size(), [&]()
+			{
+				GenerateMipChain(pixels.data(), dim, dim, filter, true, chain);
+			});
+
+		const std::string scalarName = name + " scalar";
+		RunBench(scalarName.c_str(), asset, pixels.size(), [&]()
+			{
+				GenerateMipChainScalar(pixels.data(), dim, dim, filter, true, chain);
+			});
+	}
+
+	return true;
+}
+
+fs::path WriteSyntheticMesh(const fs::path& directory)
+{
+	// A wavy grid compresses roughly like real geometry, unlike random noise
+	constexpr int gridDim = 512;
+
+	std::vector<Vertex_PNCV_F32> vertices;
+	std::vector<uint32_t> indices;
+	vertices.reserve(gridDim * gridDim);
+
+	for (int y = 0; y < gridDim; ++y)
+	{
+		for (int x = 0; x < gridDim; ++x)
+		{
+			Vertex_PNCV_F32 vert{};
+			vert.position[0] = static_cast<float>(x);
+			vert.position[1] = std::sin(x * 0.1f) * std::cos(y * 0.1f);
+			vert.position[2] = static_cast<float>(y);
+			vert.normal[1] = 1.0f;
+			vert.color[0] = vert.color[1] = vert.color[2] = 1.0f;
+			vert.uv[0] = static_cast<float>(x) / gridDim;
+			vert.uv[1] = static_cast<float>(y) / gridDim;
+			vertices.push_back(vert);
+		}
+	}
+
+	for (int y = 0; y < gridDim - 1; ++y)
+	{
+		for (int x = 0; x < gridDim - 1; ++x)
+		{
+			uint32_t i = y * gridDim + x;
+			indices.insert(indices.end(), { i, i + gridDim, i + 1, i + 1, i + gridDim, i + gridDim + 1 });
+		}
+	}
+
+	MeshInfo info{};
+	info.vertexFormat = VertexFormat::PNCV_F32;
+	info.vertexBufferSize = vertices.size() * sizeof(Vertex_PNCV_F32);
+	info.indexBufferSize = indices.size() * sizeof(uint32_t);
+	info.indexSize = sizeof(uint32_t);
+	info.indexEncoding = IndexEncoding::Triangle;
+	info.sourceFile = "synthetic";
+	info.bounds = CalculateBounds(vertices.data(), vertices.size());
+
+	AssetFile asset = PackMesh(&info, vertices.data(), indices.data());
+
+	fs::path path = directory / "assetbench_synthetic.msh";
+	SaveBinary(path.u8string().c_str(), asset);
+	return path;
+}
+
+fs::path WriteSyntheticTexture(const fs::path& directory)
+{
+	// Smooth gradients with a little grain, so it compresses somewhere between flat and noise
+	constexpr uint32_t size = 1024;
+
+	TextureInfo info{};
+	info.textureFormat = TextureFormat::RGBA8;
+	info.sourceFile = "synthetic";
+
+	std::vector<uint8_t> pixels;
+	uint32_t seed = 12345;
+	for (uint32_t mipSize = size; mipSize > 0; mipSize /= 2)
+	{
+		for (uint32_t y = 0; y < mipSize; ++y)
+		{
+			for (uint32_t x = 0; x < mipSize; ++x)
+			{
+				seed = seed * 1664525u + 1013904223u;
+				const uint8_t grain = static_cast<uint8_t>(seed >> 29);
+				pixels.push_back(static_cast<uint8_t>(x * 255 / mipSize + grain));
+				pixels.push_back(static_cast<uint8_t>(y * 255 / mipSize + grain));
+				pixels.push_back(static_cast<uint8_t>((x ^ y) & 0xff));
+				pixels.push_back(255);
+			}
+		}
+
+		PageInfo page{};
+		page.width = mipSize;
+		page.height = mipSize;
+		page.originalSize = mipSize * mipSize * 4;
+		info.pages.push_back(page);
+	}
+	info.dataSize = pixels.size();
+
+	AssetFile asset = PackTexture(&info, pixels.data());
+
+	fs::path path = directory / "assetbench_synthetic.tex";
+	SaveBinary(path.u8string().c_str(), asset);
+	return path;
+}
+
+bool WriteJson(const char* path)
+{
+	nlohmann::json root;
+	root["iterations"] = options.iterations;
+
+	std::vector<nlohmann::json> entries;
+	for (auto& r : results)
+	{
+		nlohmann::json entry;
+		entry["name"] = r.name;
+		entry["asset"] = r.asset;
+		entry["iterations"] = r.iterations;
+		entry["bytes"] = r.bytes;
+		entry["nsPerOp"] = r.nsPerOp;
+		entry["minNsPerOp"] = r.minNsPerOp;
+		entry["mbPerSec"] = r.mbPerSec;
+		entry["allocsPerOp"] = r.allocsPerOp;
+		entry["allocBytesPerOp"] = r.allocBytesPerOp;
+		entries.push_back(entry);
+	}
+	root["results"] = entries;
+
+	std::ofstream outFile(path);
+	outFile << root.dump(1, '\t') << std::endl;
+	return outFile.good();
+}
+
+void PrintUsage()
+{
+	std::cout << "Usage: assetbench [cooked folder] [--json <file>] [--iterations <n>] [--filter <name>]" << std::endl;
+	std::cout << INDENT << "Without a folder, synthetic mesh and texture assets are generated and measured." << std::endl;
+	std::cout << INDENT << "The vertex kernels and mip chain generation are always checked against their scalar versions and measured on generated data." << std::endl;
+}
+
+
+int main(int argc, char* argv[])
+{
+	std::vector<fs::path> files;
+	const char* cookedFolder = nullptr;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const char* arg = argv[i];
+		if (strcmp(arg, "--json") == 0 && i + 1 < argc)
+			options.jsonPath = argv[++i];
+		else if (strcmp(arg, "--iterations") == 0 && i + 1 < argc)
+			options.iterations = std::max(1, atoi(argv[++i]));
+		else if (strcmp(arg, "--filter") == 0 && i + 1 < argc)
+			options.filter = argv[++i];
+		else if (arg[0] != '-' && cookedFolder == nullptr)
+			cookedFolder = arg;
+		else
+		{
+			PrintUsage();
+			return 1;
+		}
+	}
+
+	if (cookedFolder != nullptr)
+	{
+		for (auto& p : fs::recursive_directory_iterator(cookedFolder))
+		{
+			if (p.path().extension() == ".msh" || p.path().extension() == ".tex")
+				files.push_back(p.path());
+		}
+	}
+	else
+	{
+		std::cout << "No cooked folder given, using synthetic assets" << std::endl;
+		files.push_back(WriteSyntheticMesh(fs::temp_directory_path()));
+		files.push_back(WriteSyntheticTexture(fs::temp_directory_path()));
+	}
+
+	bool allOk = true;
+	for (auto& path : files)
+	{
+		std::cout << "File: " << path << " (" << fs::file_size(path) / 1024 << " KB)" << std::endl;
+
+		bool ok = false;
+		if (path.extension() == ".msh")
+			ok = BenchMesh(path);
+		else
+			ok = BenchTexture(path);
+
+		if (!ok)
+		{
+			std::cout << INDENT << "failed to load" << std::endl;
+			allOk = false;
+		}
+	}
+
+	std::cout << "Vertex kernels (" << GetVertexKernelPath() << ")" << std::endl;
+	if (!BenchKernels())
+		allOk = false;
+
+	std::cout << "Mip kernels (" << GetMipKernelPath() << ")" << std::endl;
+	if (!BenchMips())
+		allOk = false;
+
+	if (!options.jsonPath.empty() && !WriteJson(options.jsonPath.c_str()))
+	{
+		std::cout << "ERROR: failed to write " << options.jsonPath << std::endl;
+		return 1;
+	}
+
+	return allOk ? 0 : 1;
+}
\ No newline at end of file
@@ -1,31 +1,42 @@
 #include <iostream>
+#include <iomanip>
 // #include <fstream>
+#include <cstring>
+#include <cctype>
+#include <algorithm>
 #include <filesystem>
 #include <json.hpp>
 #include <lz4.h>
 #include <chrono>
+#include <unordered_map>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 #include "tiny_obj_loader.h"
 
 #include "asset_core.h"
+#include "asset_archive.h"
 #include "texture_asset.h"
+#include "block_compression.h"
+#include "texture_mips.h"
 #include "mesh_asset.h"
+#include "mesh_processing.h"
 #include "material_asset.h"
+#include "obj_parser.h"
 
 // #define TINYGLTF_IMPLEMENTATION
 // #include <tiny_gltf.h>
 
-#include <nvtt.h>
-
 // #include <glm/glm.hpp>
 // #include <glm/gtx/transform.hpp>
 // #include <glm/gtx/quaternion.hpp>
 
 constexpr const char* INDENT = "    ";
 constexpr const char* OUTPUT_FOLDER = "cooked";
+constexpr const char* ARCHIVE_NAME = "assets.pak";
 constexpr bool TIMINGS = true;
+// LOD simplification stops before moving the surface further than this, relative to the mesh size
+constexpr float LOD_MAX_ERROR = 0.05f;
 
 #define START_TIMING(var) \
 	auto _##var##Start = timer::high_resolution_clock::now();
@@ -47,7 +58,34 @@ struct ConverterState
 	fs::path ConvertToExportRelative(fs::path path) const;
 };
 
-bool ConvertImage(const fs::path& inPath, const fs::path& outPath)
+// Codec choice per asset type, set with --codec/--level, and mesh processing switches
+struct CookOptions
+{
+	PackOptions mesh;
+	PackOptions texture;
+	bool optimizeMeshes{ true };
+	uint32_t lodCount{ 3 };			// LODs to generate past the full mesh
+	VertexFormat vertexFormat{ VertexFormat::P16N8C8V16 };	// PNCV_F32, P16N8C8V16 or P32N8C8V32
+	IndexEncoding indexEncoding{ IndexEncoding::Triangle };
+	VertexStreams vertexStreams{ VertexStreams::Interleaved };	// Split only applies to P16N8C8V16 and P32N8C8V32
+	float overdrawThreshold{ 0.0f };	// Allowed ACMR growth for the overdraw sort, 0 skips it
+	TextureFormat textureFormat{ TextureFormat::BC7 };
+	MipFilter mipFilter{ MipFilter::Kaiser };
+	uint32_t tileAbove{ 0 };		// Textures wider or taller than this are cooked tiled, 0 never
+};
+
+// One row of the summary table printed after cooking
+struct CookStats
+{
+	std::string name;
+	CompressionMode compression;
+	int level;
+	uint64_t rawSize;
+	uint64_t packedSize;
+	double decodeMs;
+};
+
+bool ConvertImage(const fs::path& inPath, AssetFile& asset, const CookOptions& options)
 {
 	int width, height, channels;
 
@@ -62,65 +100,59 @@ bool ConvertImage(const fs::path& inPath, const fs::path& outPath)
 	}
 
 	TextureInfo info{};
-	info.textureFormat = TextureFormat::RGBA8;
+	info.textureFormat = options.textureFormat;
 	info.sourceFile = inPath.string();
 
 
-	std::vector<char> fullBuffer;
+	// BC4 and BC5 hold data rather than colour, and are sampled as UNORM
+	const bool srgb = info.textureFormat != TextureFormat::BC4 && info.textureFormat != TextureFormat::BC5;
 
-	struct SimpleHandler : nvtt::OutputHandler
-	{
-		virtual bool writeData(const void* data, int size)
-		{
-			for (int i = 0; i < size; ++i)
-				buffer.push_back((reinterpret_cast<const char*>(data))[i]);
-			return true;
-		}
-		virtual void beginImage(int size, int width, int height, int depth, int face, int mipLevel) {};
-		virtual void endImage() {};
+	START_TIMING(mips)
+	std::vector<uint8_t> chain;
+	const std::vector<MipLevel> levels = GenerateMipChain(pixels, width, height, options.mipFilter, srgb, chain);
+	END_TIMING("Build mipmaps", mips)
 
-		std::vector<char> buffer;
-	};
+	START_TIMING(encode)
+	std::vector<char> fullBuffer;
+	for (const MipLevel& level : levels)
+	{
+		// Mips below 4x4 still take a whole block
+		const size_t offset = fullBuffer.size();
+		fullBuffer.resize(offset + GetTextureMipSize(info.textureFormat, level.width, level.height));
+		CompressTextureBlocks(info.textureFormat, chain.data() + level.offset, level.width, level.height, fullBuffer.data() + offset);
+
+		PageInfo page{};
+		page.width = level.width;
+		page.height = level.height;
+		page.originalSize = static_cast<uint32_t>(fullBuffer.size() - offset);
+		info.pages.push_back(page);
+	}
+	END_TIMING("Encode mipmaps", encode)
 
-	nvtt::Context context;
-	nvtt::CompressionOptions compOptions;
-	nvtt::OutputOptions outOptions;
-	nvtt::Surface surface;
-	SimpleHandler handler;
-	outOptions.setOutputHandler(&handler);
-	surface.setImage(nvtt::InputFormat_BGRA_8UB, width, height, 1, pixels);
+	info.dataSize = fullBuffer.size();
 
-	START_TIMING(mips)
-	// Would need to change this for BCn compression (4 is the min size)
-	do
+	if (options.tileAbove > 0 && std::max(width, height) > static_cast<int>(options.tileAbove))
 	{
-		// Don't need to build anything for the top mip
-		if (!fullBuffer.empty())
-			surface.buildNextMipmap(nvtt::MipmapFilter_Box);
-		compOptions.setFormat(nvtt::Format::Format_RGBA);
-		compOptions.setPixelType(nvtt::PixelType::PixelType_UnsignedNorm);
-		context.compress(surface, 0, 0, compOptions, outOptions);
-
-		info.pages.push_back({});
-		info.pages.back().width = surface.width();
-		info.pages.back().height = surface.height();
-		info.pages.back().originalSize = static_cast<uint32_t>(handler.buffer.size());
-
-		fullBuffer.insert(fullBuffer.end(), handler.buffer.begin(), handler.buffer.end());
-		handler.buffer.clear();
-	} while (surface.canMakeNextMipmap(1));
-
-	END_TIMING("Build mipmaps", mips)
+		START_TIMING(tile)
+		std::vector<char> tiled;
+		if (!TileTexture(&info, fullBuffer.data(), tiled))
+		{
+			stbi_image_free(pixels);
+			return false;
+		}
+		fullBuffer.swap(tiled);
+		END_TIMING("Cut tiles", tile)
 
-	info.dataSize = fullBuffer.size();
+		std::cout << INDENT << INDENT << GetTextureTileColumns(&info, 0) << "x" << GetTextureTileRows(&info, 0) << " tiles of " << info.tileSize << " texels on the top mip" << std::endl;
+	}
 
 	START_TIMING(pack)
-	AssetFile asset = PackTexture(&info, fullBuffer.data());
+	asset = PackTexture(&info, fullBuffer.data(), options.texture);
 	END_TIMING("Pack texture", pack)
 
 	stbi_image_free(pixels);
 
-	return SaveBinary(outPath.u8string().c_str(), asset);
+	return true;
 }
 
 void PackVertex(Vertex_PNCV_F32& newVert, tinyobj::real_t vx, tinyobj::real_t vy, tinyobj::real_t vz, tinyobj::real_t nx, tinyobj::real_t ny, tinyobj::real_t nz, tinyobj::real_t u, tinyobj::real_t v)
@@ -153,63 +185,53 @@ void PackVertex(Vertex_P32N8C8V16& newVert, tinyobj::real_t vx, tinyobj::real_t
 	newVert.uv[1] = 1.0f - v;	// Vulkan V is flipped from OBJ
 }
 
-template<typename V, typename I>
-void ExtractMeshFromObj(const std::vector<tinyobj::shape_t>& shapes, const tinyobj::attrib_t& attrib, std::vector<I>& indices, std::vector<V>& vertices)
+// Vertices are welded on their packed bytes, so only corners that are bit-identical after packing merge
+template<typename V>
+struct PackedVertexHash
 {
-	const bool hasNormals = attrib.normals.size() > 0;
-	const bool hasUVs = attrib.texcoords.size() > 0;
-
-	// Fallback values
-	tinyobj::real_t nx = 0.0f;
-	tinyobj::real_t ny = 1.0f;
-	tinyobj::real_t nz = 0.0f;
-	tinyobj::real_t ux = 0.0f;
-	tinyobj::real_t uy = 0.0f;
+	size_t operator()(const V& v) const { return static_cast<size_t>(HashData(&v, sizeof(V))); }
+};
 
-	for (size_t s = 0; s < shapes.size(); s++)
-	{
-		size_t indexOffset = 0;
-		for (size_t f = 0; f < shapes[s].mesh.num_face_vertices.size(); f++)
-		{
-			// Hard-coding only loading to triangles
-			const int fv = 3;
+template<typename V>
+struct PackedVertexEqual
+{
+	bool operator()(const V& a, const V& b) const { return std::memcmp(&a, &b, sizeof(V)) == 0; }
+};
 
-			for (size_t v = 0; v < fv; v++)
-			{
-				tinyobj::index_t idx = shapes[s].mesh.indices[indexOffset + v];
+template<typename V>
+void ExtractMeshFromObj(const ObjData& obj, std::vector<uint32_t>& indices, std::vector<V>& vertices)
+{
+	// Fallback values, for corners without a normal or UV
+	const float defaultNormal[3] = { 0.0f, 1.0f, 0.0f };
+	const float defaultUV[2] = { 0.0f, 0.0f };
 
-				tinyobj::real_t vx = attrib.vertices[3 * idx.vertex_index + 0];
-				tinyobj::real_t vy = attrib.vertices[3 * idx.vertex_index + 1];
-				tinyobj::real_t vz = attrib.vertices[3 * idx.vertex_index + 2];
+	const size_t cornerCount = obj.positionIndices.size();
 
-				if (hasNormals)
-				{
-					nx = attrib.normals[3 * idx.normal_index + 0];
-					ny = attrib.normals[3 * idx.normal_index + 1];
-					nz = attrib.normals[3 * idx.normal_index + 2];
-				}
+	std::unordered_map<V, uint32_t, PackedVertexHash<V>, PackedVertexEqual<V>> vertexLookup;
+	vertexLookup.reserve(cornerCount);
+	indices.reserve(cornerCount);
 
-				if (hasUVs)
-				{
-					ux = attrib.texcoords[2 * idx.texcoord_index + 0];
-					uy = attrib.texcoords[2 * idx.texcoord_index + 1];
-				}
+	for (size_t i = 0; i < cornerCount; ++i)
+	{
+		const float* position = &obj.positions[3 * static_cast<size_t>(obj.positionIndices[i])];
+		const float* normal = (obj.normalIndices[i] >= 0) ? &obj.normals[3 * static_cast<size_t>(obj.normalIndices[i])] : defaultNormal;
+		const float* uv = (obj.texcoordIndices[i] >= 0) ? &obj.texcoords[2 * static_cast<size_t>(obj.texcoordIndices[i])] : defaultUV;
 
-				V newVert;
-				PackVertex(newVert, vx, vy, vz, nx, ny, nz, ux, uy);
+		// Cleared first so padding bytes can't keep identical vertices apart
+		V newVert;
+		std::memset(&newVert, 0, sizeof(V));
+		PackVertex(newVert, position[0], position[1], position[2], normal[0], normal[1], normal[2], uv[0], uv[1]);
 
-				// Exploded mesh, so indices are just an ascending count
-				indices.push_back(static_cast<I>(vertices.size()));
+		auto [it, inserted] = vertexLookup.try_emplace(newVert, static_cast<uint32_t>(vertices.size()));
+		if (inserted)
+			vertices.push_back(newVert);
 
-				vertices.push_back(newVert);
-			}
-
-			indexOffset += 3;
-		}
+		indices.push_back(it->second);
 	}
 }
 
-bool ConvertMesh(const fs::path& inPath, const fs::path& outPath)
+// Full OBJ loader for files ParseObj doesn't handle, flattened into the same form
+bool LoadObjFallback(const fs::path& inPath, ObjData& obj)
 {
 	tinyobj::attrib_t attrib;
 	std::vector<tinyobj::shape_t> shapes;
@@ -221,9 +243,7 @@ bool ConvertMesh(const fs::path& inPath, const fs::path& outPath)
 	fs::path mtlPath = inPath;
 	mtlPath.remove_filename();
 
-	START_TIMING(load)
 	tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, inPath.u8string().c_str(), mtlPath.u8string().c_str());
-	END_TIMING("Load mesh", load)
 
 	if (!warn.empty())
 	{
@@ -232,32 +252,349 @@ bool ConvertMesh(const fs::path& inPath, const fs::path& outPath)
 
 	if (!err.empty())
 	{
-		std::cout << INDENT << INDENT << "Mesh load error: %s" << warn << std::endl;
+		std::cout << INDENT << INDENT << "Mesh load error: " << err << std::endl;
 		return false;
 	}
 
-	using IndexFormat = uint32_t;
+	obj.positions = std::move(attrib.vertices);
+	obj.normals = std::move(attrib.normals);
+	obj.texcoords = std::move(attrib.texcoords);
+
+	// Faces come back triangulated
+	for (const tinyobj::shape_t& shape : shapes)
+	{
+		for (const tinyobj::index_t& idx : shape.mesh.indices)
+		{
+			obj.positionIndices.push_back(static_cast<uint32_t>(idx.vertex_index));
+			obj.normalIndices.push_back(idx.normal_index);
+			obj.texcoordIndices.push_back(idx.texcoord_index);
+		}
+	}
+
+	return true;
+}
+
+bool ConvertMesh(const fs::path& inPath, AssetFile& asset, const CookOptions& options)
+{
+	ObjData obj;
+	std::string unsupported;
+
+	START_TIMING(load)
+	const bool fastParse = ParseObj(inPath.u8string().c_str(), obj, unsupported);
+	if (!fastParse)
+	{
+		std::cout << INDENT << INDENT << "Fast OBJ parser can't read this file (" << unsupported << "), using tinyobj" << std::endl;
+		obj = ObjData{};
+		if (!LoadObjFallback(inPath, obj))
+			return false;
+	}
+	END_TIMING("Load mesh", load)
+
+	if (TIMINGS)
+	{
+		const double seconds = timer::duration<double>(_loadDiff).count();
+		const double megabytes = static_cast<double>(fs::file_size(inPath)) / (1024.0 * 1024.0);
+		const std::streamsize precision = std::cout.precision();
+		std::cout << INDENT << INDENT << "Parsed " << std::fixed << std::setprecision(1) << megabytes << " MB at " << megabytes / std::max(seconds, 1e-9)
+			<< " MB/s" << (fastParse ? "" : " (tinyobj)") << std::defaultfloat << std::setprecision(precision) << std::endl;
+	}
+
 	using VertexFormat = assets::Vertex_PNCV_F32;
 	constexpr auto VertexFormatEnum = assets::VertexFormat::PNCV_F32;
 
-	std::vector<IndexFormat> indices;
+	std::vector<uint32_t> indices;
 	std::vector<VertexFormat> vertices;
-	ExtractMeshFromObj<VertexFormat, IndexFormat>(shapes, attrib, indices, vertices);
+	START_TIMING(weld)
+	ExtractMeshFromObj<VertexFormat>(obj, indices, vertices);
+	END_TIMING("Weld vertices", weld)
+
+	std::cout << INDENT << INDENT << indices.size() << " corners welded into " << vertices.size() << " vertices" << std::endl;
+
+	std::vector<MeshLod> lods;
+	std::vector<Meshlet> meshlets;
+	if (!indices.empty())
+	{
+		const float* positions = vertices[0].position;
+		const VertexCacheStats before = AnalyzeVertexCache(indices.data(), indices.size(), vertices.size());
+
+		if (options.optimizeMeshes)
+		{
+			START_TIMING(optimize)
+			OptimizeVertexCache(indices.data(), indices.size(), vertices.size());
+			if (options.overdrawThreshold > 0.0f)
+				OptimizeOverdraw(indices.data(), indices.size(), positions, sizeof(VertexFormat), vertices.size(), options.overdrawThreshold);
+			END_TIMING("Optimize mesh", optimize)
+		}
+
+		// Each level halves the last one's triangles, all simplified from LOD 0 and appended after it
+		lods.push_back({ 0, static_cast<uint32_t>(indices.size()), 0, 0, 0.0f });
+		if (options.lodCount > 0)
+		{
+			START_TIMING(simplify)
+			std::vector<uint32_t> lodIndices(indices.size());
+			for (uint32_t level = 1; level <= options.lodCount; ++level)
+			{
+				const MeshLod previous = lods.back();
+
+				float error = 0.0f;
+				const size_t count = SimplifyMesh(lodIndices.data(), indices.data(), lods[0].indexCount, positions, sizeof(VertexFormat), vertices.size(),
+					previous.indexCount / 6 * 3, LOD_MAX_ERROR, &error);
+
+				// Stuck on locked seams or the error limit; a level this close to the last isn't worth storing
+				if (count == 0 || count > previous.indexCount / 4 * 3)
+					break;
+
+				if (options.optimizeMeshes)
+					OptimizeVertexCache(lodIndices.data(), count, vertices.size());
+
+				MeshLod lod{};
+				lod.firstIndex = static_cast<uint32_t>(indices.size());
+				lod.indexCount = static_cast<uint32_t>(count);
+				lod.error = std::max(error, previous.error);
+				indices.insert(indices.end(), lodIndices.begin(), lodIndices.begin() + count);
+				lods.push_back(lod);
+
+				std::cout << INDENT << INDENT << "LOD " << level << ": " << count / 3 << " triangles, error " << lod.error << std::endl;
+			}
+			END_TIMING("Build LODs", simplify)
+		}
+
+		if (options.optimizeMeshes)
+		{
+			START_TIMING(meshlets)
+			for (MeshLod& lod : lods)
+			{
+				std::vector<Meshlet> lodMeshlets = BuildMeshlets(indices.data() + lod.firstIndex, lod.indexCount, positions, sizeof(VertexFormat), vertices.size());
+				lod.firstMeshlet = static_cast<uint32_t>(meshlets.size());
+				lod.meshletCount = static_cast<uint32_t>(lodMeshlets.size());
+				for (Meshlet& meshlet : lodMeshlets)
+				{
+					meshlet.firstIndex += lod.firstIndex;
+					meshlets.push_back(meshlet);
+				}
+			}
+			END_TIMING("Build meshlets", meshlets)
+
+			// LOD 0 comes first, so its vertices end up in draw order
+			vertices.resize(OptimizeVertexFetch(vertices.data(), vertices.size(), sizeof(VertexFormat), indices.data(), indices.size()));
+
+			const VertexCacheStats after = AnalyzeVertexCache(indices.data(), lods[0].indexCount, vertices.size());
+			std::cout << INDENT << INDENT << std::fixed << std::setprecision(3) << "ACMR " << before.acmr << " -> " << after.acmr
+				<< ", ATVR " << before.atvr << " -> " << after.atvr << std::defaultfloat << std::endl;
+			std::cout << INDENT << INDENT << lods[0].meshletCount << " meshlets, " << lods[0].indexCount / 3 / lods[0].meshletCount << " triangles each on average" << std::endl;
+		}
+	}
+
+	// 16-bit indices whenever every vertex can be addressed with them
+	std::vector<uint16_t> shortIndices;
+	const bool useShortIndices = vertices.size() <= UINT16_MAX;
+	if (useShortIndices)
+		shortIndices.assign(indices.begin(), indices.end());
 
 	MeshInfo info{};
-	info.vertexFormat = VertexFormatEnum;
-	info.vertexBufferSize = vertices.size() * sizeof(VertexFormat);
-	info.indexBufferSize = indices.size() * sizeof(IndexFormat);
-	info.indexSize = sizeof(IndexFormat);
+	info.indexSize = useShortIndices ? sizeof(uint16_t) : sizeof(uint32_t);
+	info.indexEncoding = options.indexEncoding;
+	info.indexBufferSize = indices.size() * info.indexSize;
 	info.sourceFile = inPath.string();
 
 	info.bounds = CalculateBounds(vertices.data(), vertices.size());
+	info.lods = std::move(lods);
+	info.meshlets = std::move(meshlets);
+
+	info.vertexFormat = VertexFormatEnum;
+	info.vertexBufferSize = vertices.size() * sizeof(VertexFormat);
+	void* vertexData = vertices.data();
+
+	std::vector<Vertex_P16N8C8V16> quantizedVertices;
+	if (options.vertexFormat == assets::VertexFormat::P16N8C8V16)
+	{
+		START_TIMING(quantize)
+		quantizedVertices.resize(vertices.size());
+		QuantizeVertices(vertices.data(), vertices.size(), info.bounds, quantizedVertices.data());
+		END_TIMING("Quantize vertices", quantize)
+
+		std::cout << INDENT << INDENT << "Vertex data " << info.vertexBufferSize / 1024 << " KB -> " << quantizedVertices.size() * sizeof(Vertex_P16N8C8V16) / 1024 << " KB" << std::endl;
+
+		info.vertexFormat = assets::VertexFormat::P16N8C8V16;
+		info.vertexBufferSize = quantizedVertices.size() * sizeof(Vertex_P16N8C8V16);
+		vertexData = quantizedVertices.data();
+	}
+
+	std::vector<Vertex_P32N8C8V32> packedVertices;
+	if (options.vertexFormat == assets::VertexFormat::P32N8C8V32)
+	{
+		START_TIMING(packVertices)
+		packedVertices.resize(vertices.size());
+		PackVertices(vertices.data(), vertices.size(), packedVertices.data());
+		END_TIMING("Pack vertices", packVertices)
+
+		std::cout << INDENT << INDENT << "Vertex data " << info.vertexBufferSize / 1024 << " KB -> " << packedVertices.size() * sizeof(Vertex_P32N8C8V32) / 1024 << " KB" << std::endl;
+
+		info.vertexFormat = assets::VertexFormat::P32N8C8V32;
+		info.vertexBufferSize = packedVertices.size() * sizeof(Vertex_P32N8C8V32);
+		vertexData = packedVertices.data();
+	}
+
+	// Positions ahead of everything else, for passes that only need them
+	std::vector<char> splitVertices;
+	if (options.vertexStreams == VertexStreams::Split && info.vertexFormat != assets::VertexFormat::PNCV_F32)
+	{
+		splitVertices.resize(info.vertexBufferSize);
+		SplitVertexStreams(vertexData, vertices.size(), GetVertexSize(info.vertexFormat), GetPositionSize(info.vertexFormat), splitVertices.data());
+
+		info.vertexStreams = VertexStreams::Split;
+		vertexData = splitVertices.data();
+	}
+
+	void* indexData = useShortIndices ? static_cast<void*>(shortIndices.data()) : static_cast<void*>(indices.data());
 
 	START_TIMING(pack)
-	AssetFile asset = PackMesh(&info, vertices.data(), indices.data());
+	asset = PackMesh(&info, vertexData, indexData, options.mesh);
 	END_TIMING("Pack mesh", pack)
 
-	return SaveBinary(outPath.u8string().c_str(), asset);
+	return true;
+}
+
+
+// Decodes a freshly packed asset the same way the engine will, best of a few runs
+bool MeasureDecode(AssetFile& asset, CookStats& stats)
+{
+	constexpr int runs = 3;
+
+	stats.packedSize = asset.blob.size();
+	stats.decodeMs = 0.0;
+
+	if (std::memcmp(asset.type, "MESH", 4) == 0)
+	{
+		MeshInfo info;
+		if (!ReadMeshInfo(&asset, info))
+			return false;
+		stats.compression = info.compressionMode;
+		stats.rawSize = info.vertexBufferSize + info.indexBufferSize;
+
+		std::vector<char> vertexBuffer(info.vertexBufferSize);
+		std::vector<char> indexBuffer(info.indexBufferSize);
+		for (int i = 0; i < runs; ++i)
+		{
+			auto start = timer::high_resolution_clock::now();
+			if (!UnpackMesh(&info, asset.blob.data(), asset.blob.size(), vertexBuffer.data(), indexBuffer.data()))
+				return false;
+			double ms = timer::duration_cast<timer::nanoseconds>(timer::high_resolution_clock::now() - start).count() / 1000000.0;
+			stats.decodeMs = (i == 0) ? ms : std::min(stats.decodeMs, ms);
+		}
+		return true;
+	}
+
+	if (std::memcmp(asset.type, "TXTR", 4) == 0)
+	{
+		TextureInfo info;
+		if (!ReadTextureInfo(&asset, info))
+			return false;
+		stats.compression = info.compressionMode;
+		stats.rawSize = info.dataSize;
+
+		std::vector<char> pixels(info.dataSize);
+		for (int i = 0; i < runs; ++i)
+		{
+			auto start = timer::high_resolution_clock::now();
+			if (!UnpackTexture(&info, asset.blob.data(), asset.blob.size(), pixels.data()))
+				return false;
+			double ms = timer::duration_cast<timer::nanoseconds>(timer::high_resolution_clock::now() - start).count() / 1000000.0;
+			stats.decodeMs = (i == 0) ? ms : std::min(stats.decodeMs, ms);
+		}
+		return true;
+	}
+
+	return false;
+}
+
+void PrintCookStats(const std::vector<CookStats>& allStats)
+{
+	if (allStats.empty())
+		return;
+
+	std::cout << std::endl << std::left << std::setw(32) << "Asset" << std::setw(7) << "Codec" << std::right << std::setw(6) << "Level"
+		<< std::setw(12) << "Raw KB" << std::setw(12) << "Packed KB" << std::setw(8) << "Ratio" << std::setw(14) << "Decode MB/s" << std::endl;
+
+	uint64_t totalRaw = 0;
+	uint64_t totalPacked = 0;
+	for (auto& stats : allStats)
+	{
+		const double ratio = stats.packedSize > 0 ? static_cast<double>(stats.rawSize) / stats.packedSize : 0.0;
+		const double decodeSpeed = stats.decodeMs > 0.0 ? (stats.rawSize / (1024.0 * 1024.0)) / (stats.decodeMs / 1000.0) : 0.0;
+
+		std::cout << std::left << std::setw(32) << stats.name << std::setw(7) << CompressionName(stats.compression) << std::right << std::setw(6) << stats.level
+			<< std::fixed << std::setprecision(1) << std::setw(12) << stats.rawSize / 1024.0 << std::setw(12) << stats.packedSize / 1024.0
+			<< std::setprecision(2) << std::setw(8) << ratio << std::setprecision(0) << std::setw(14) << decodeSpeed << std::endl;
+
+		totalRaw += stats.rawSize;
+		totalPacked += stats.packedSize;
+	}
+
+	std::cout << std::left << std::setw(45) << "Total" << std::right << std::fixed << std::setprecision(1)
+		<< std::setw(12) << totalRaw / 1024.0 << std::setw(12) << totalPacked / 1024.0
+		<< std::setprecision(2) << std::setw(8) << (totalPacked > 0 ? static_cast<double>(totalRaw) / totalPacked : 0.0) << std::endl;
+}
+
+// Accepts "<value>" for every asset type, or "mesh=<value>" / "texture=<value>" for one of them
+bool ParseTypedArg(const char* arg, std::string& value, bool& forMesh, bool& forTexture)
+{
+	std::string str = arg;
+	size_t split = str.find('=');
+	forMesh = forTexture = true;
+	if (split != std::string::npos)
+	{
+		std::string type = str.substr(0, split);
+		forMesh = (type == "mesh");
+		forTexture = (type == "texture");
+		if (!forMesh && !forTexture)
+			return false;
+		str = str.substr(split + 1);
+	}
+	value = str;
+	return !value.empty();
+}
+
+bool ParseCodecArg(const char* arg, CookOptions& options)
+{
+	std::string value;
+	bool forMesh, forTexture;
+	if (!ParseTypedArg(arg, value, forMesh, forTexture))
+		return false;
+
+	for (auto& c : value)
+		c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+
+	CompressionMode mode;
+	if (value == "NONE")
+		mode = CompressionMode::None;
+	else if (value == "LZ4")
+		mode = CompressionMode::LZ4;
+	else if (value == "LZ4HC")
+		mode = CompressionMode::LZ4HC;
+	else
+		return false;
+
+	if (forMesh)
+		options.mesh.compression = mode;
+	if (forTexture)
+		options.texture.compression = mode;
+	return true;
+}
+
+bool ParseLevelArg(const char* arg, CookOptions& options)
+{
+	std::string value;
+	bool forMesh, forTexture;
+	if (!ParseTypedArg(arg, value, forMesh, forTexture))
+		return false;
+
+	int level = std::atoi(value.c_str());
+	if (forMesh)
+		options.mesh.level = level;
+	if (forTexture)
+		options.texture.level = level;
+	return true;
 }
 
 
@@ -265,7 +602,23 @@ int main(int argc, char* argv[])
 {
 	if (argc < 2)
 	{
-		std::cout << "Usage: " << argv[0] << " <asset_folder>";
+		std::cout << "Usage: " << argv[0] << " <asset_folder> [--archive] [--json] [--codec [type=]<codec>] [--level [type=]<n>] [--no-mesh-opt] [--overdraw <threshold>] [--lods <n>] [--vertex-format <format>] [--split-streams] [--raw-indices] [--texture-format <format>] [--mip-filter <filter>] [--tile-above <size>]";
+		std::cout << std::endl << "    --archive    write a single " << ARCHIVE_NAME << " instead of one file per asset";
+		std::cout << std::endl << "    --json       write a <asset>.json side-car describing each loose asset, for tooling";
+		std::cout << std::endl << "    --codec      none, lz4 (default) or lz4hc; lz4hc is smaller and decodes as fast, for shipping builds";
+		std::cout << std::endl << "    --level      lz4 acceleration, or lz4hc level 3-12 (0 = codec default)";
+		std::cout << std::endl << "                 type is mesh or texture, e.g. --codec mesh=lz4hc --level mesh=12 --codec texture=none";
+		std::cout << std::endl << "    --no-mesh-opt  keep the OBJ triangle and vertex order instead of optimizing for the vertex cache; no meshlets";
+		std::cout << std::endl << "    --overdraw   also sort triangle clusters to reduce overdraw, allowing ACMR to grow by threshold (e.g. 1.05)";
+		std::cout << std::endl << "    --lods       how many simplified LODs to generate per mesh, each about half the last (default 3, 0 = none)";
+		std::cout << std::endl << "    --vertex-format  p16n8c8v16 (default, quantized, 20 bytes), p32n8c8v32 (the engine's Vertex, float positions and UVs, 28 bytes)";
+		std::cout << std::endl << "                 or pncv_f32 (full precision, 44 bytes, converted on load)";
+		std::cout << std::endl << "    --split-streams  store all vertex positions ahead of the other attributes, for position-only passes (not with pncv_f32)";
+		std::cout << std::endl << "    --raw-indices  store index buffers as-is instead of through the triangle index codec";
+		std::cout << std::endl << "    --texture-format  bc7 (default, RGBA, 1 byte per texel), bc1 (RGB, half a byte), bc3 (RGBA, 1 byte), bc4 (red only, half a byte),";
+		std::cout << std::endl << "                 bc5 (red and green, 1 byte) or rgba8 (uncompressed, 4 bytes)";
+		std::cout << std::endl << "    --mip-filter  kaiser (default), lanczos (sharper, rings a little more) or box (softest)";
+		std::cout << std::endl << "    --tile-above  cook textures wider or taller than size as " << TEXTURE_TILE_SIZE << " texel tiles, for streaming through a tile cache";
 
 		std::cout << std::endl << "Press enter to continue...";
 		int a = std::getchar();
@@ -273,6 +626,90 @@ int main(int argc, char* argv[])
 		return -1;
 	}
 
+	bool writeArchive = false;
+	bool writeJson = false;
+	CookOptions options;
+	for (int i = 2; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "--archive") == 0)
+			writeArchive = true;
+		else if (strcmp(argv[i], "--json") == 0)
+			writeJson = true;
+		else if (strcmp(argv[i], "--codec") == 0 && i + 1 < argc)
+		{
+			if (!ParseCodecArg(argv[++i], options))
+			{
+				std::cout << "ERROR: unknown codec: " << argv[i] << std::endl;
+				return -1;
+			}
+		}
+		else if (strcmp(argv[i], "--level") == 0 && i + 1 < argc)
+		{
+			if (!ParseLevelArg(argv[++i], options))
+			{
+				std::cout << "ERROR: invalid level: " << argv[i] << std::endl;
+				return -1;
+			}
+		}
+		else if (strcmp(argv[i], "--lods") == 0 && i + 1 < argc)
+			options.lodCount = static_cast<uint32_t>(std::max(0, atoi(argv[++i])));
+		else if (strcmp(argv[i], "--vertex-format") == 0 && i + 1 < argc)
+		{
+			std::string name = argv[++i];
+			for (auto& c : name)
+				c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+
+			options.vertexFormat = ParseVertexFormat(name.c_str());
+			if (options.vertexFormat != VertexFormat::PNCV_F32 && options.vertexFormat != VertexFormat::P16N8C8V16 && options.vertexFormat != VertexFormat::P32N8C8V32)
+			{
+				std::cout << "ERROR: unsupported vertex format: " << argv[i] << std::endl;
+				return -1;
+			}
+		}
+		else if (strcmp(argv[i], "--texture-format") == 0 && i + 1 < argc)
+		{
+			std::string name = argv[++i];
+			for (auto& c : name)
+				c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+
+			options.textureFormat = ParseTextureFormat(name.c_str());
+			if (options.textureFormat == TextureFormat::Unknown)
+			{
+				std::cout << "ERROR: unsupported texture format: " << argv[i] << std::endl;
+				return -1;
+			}
+		}
+		else if (strcmp(argv[i], "--mip-filter") == 0 && i + 1 < argc)
+		{
+			if (!ParseMipFilter(argv[++i], options.mipFilter))
+			{
+				std::cout << "ERROR: unknown mip filter: " << argv[i] << std::endl;
+				return -1;
+			}
+		}
+		else if (strcmp(argv[i], "--tile-above") == 0 && i + 1 < argc)
+			options.tileAbove = static_cast<uint32_t>(std::max(0, atoi(argv[++i])));
+		else if (strcmp(argv[i], "--no-mesh-opt") == 0)
+			options.optimizeMeshes = false;
+		else if (strcmp(argv[i], "--split-streams") == 0)
+			options.vertexStreams = VertexStreams::Split;
+		else if (strcmp(argv[i], "--raw-indices") == 0)
+			options.indexEncoding = IndexEncoding::Raw;
+		else if (strcmp(argv[i], "--overdraw") == 0 && i + 1 < argc)
+		{
+			options.overdrawThreshold = static_cast<float>(atof(argv[++i]));
+			if (options.overdrawThreshold < 1.0f)
+			{
+				std::cout << "ERROR: overdraw threshold must be at least 1: " << argv[i] << std::endl;
+				return -1;
+			}
+		}
+	}
+
+	std::cout << "Mesh codec: " << CompressionName(options.mesh.compression) << " (level " << options.mesh.level << "), texture codec: "
+		<< CompressionName(options.texture.compression) << " (level " << options.texture.level << "), texture format: " << TextureFormatName(options.textureFormat)
+		<< ", mip filter: " << MipFilterName(options.mipFilter) << " (" << GetMipKernelPath() << ")" << std::endl;
+
 	fs::path path{ argv[1] };
 
 	fs::path directory = path;
@@ -282,6 +719,20 @@ int main(int argc, char* argv[])
 
 	std::cout << "Processing asset directory at " << directory << std::endl;
 
+	ArchiveWriter archive;
+	if (writeArchive)
+	{
+		if (!fs::is_directory(exportDir))
+			fs::create_directory(exportDir);
+
+		fs::path archivePath = exportDir / ARCHIVE_NAME;
+		if (!archive.Open(archivePath.u8string().c_str()))
+			return -1;
+		std::cout << "Writing archive " << archivePath << std::endl;
+	}
+
+	std::vector<CookStats> allStats;
+
 	START_TIMING(cook)
 
 	for (auto& p : fs::recursive_directory_iterator(directory))
@@ -291,35 +742,69 @@ int main(int argc, char* argv[])
 		auto relative = p.path().lexically_proximate(directory);
 		auto exportPath = exportDir / relative;
 
-		if (!fs::is_directory(exportPath.parent_path()))
+		if (!writeArchive && !fs::is_directory(exportPath.parent_path()))
 			fs::create_directory(exportPath.parent_path());
 
+		AssetFile asset;
+		bool converted = false;
+		int level = 0;
+
 		if (p.path().extension() == ".png")
 		{
 			std::cout << " converting texture..." << std::endl;
 
-			auto newPath = exportPath;
-			newPath.replace_extension(".tex");
-			if (!ConvertImage(p.path(), newPath))
-				std::cout << " done." << std::endl;
+			relative.replace_extension(".tex");
+			converted = ConvertImage(p.path(), asset, options);
+			level = options.texture.level;
 		}
 		else if (p.path().extension() == ".obj")
 		{
 			std::cout << " converting mesh..." << std::endl;
 
-			auto newPath = exportPath;
-			newPath.replace_extension(".msh");
-			if (!ConvertMesh(p.path(), newPath))
-				std::cout << " done." << std::endl;
+			relative.replace_extension(".msh");
+			converted = ConvertMesh(p.path(), asset, options);
+			level = options.mesh.level;
 		}
 		else
 		{
 			std::cout << " skipping." << std::endl;
+			continue;
 		}
+
+		if (!converted)
+			continue;
+
+		CookStats stats{};
+		stats.name = relative.generic_u8string();
+		stats.level = level;
+		if (MeasureDecode(asset, stats))
+			allStats.push_back(stats);
+
+		bool saved = false;
+		if (writeArchive)
+			saved = archive.AddAsset(relative.generic_u8string().c_str(), asset);
+		else
+			saved = SaveBinary((exportDir / relative).u8string().c_str(), asset);
+
+		if (saved && writeJson && !writeArchive)
+			SaveJsonSidecar((exportDir / relative).u8string().c_str(), asset);
+
+		if (saved)
+			std::cout << INDENT << INDENT << "done." << std::endl;
+	}
+
+	if (writeArchive)
+	{
+		if (!archive.Close())
+			std::cout << "ERROR: failed to write archive" << std::endl;
+		else
+			std::cout << "Archived " << archive.GetEntryCount() << " assets" << std::endl;
 	}
 
 	END_TIMING("Cook", cook)
 
+	PrintCookStats(allStats);
+
 	std::cout << std::endl << "Press enter to continue...";
 	int a = std::getchar();
 
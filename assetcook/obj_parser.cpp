@@ -0,0 +1,416 @@
+#include "obj_parser.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include "asset_core.h"
+#include "asset_parallel.h"
+
+
+namespace
+{
+	enum class LineType
+	{
+		Other,
+		Position,
+		Normal,
+		Texcoord,
+		Face
+	};
+
+	// One line-aligned slice of the file and what was found in it
+	struct ObjRange
+	{
+		const char* begin;
+		const char* end;
+
+		size_t positionCount{ 0 };
+		size_t normalCount{ 0 };
+		size_t texcoordCount{ 0 };
+
+		// Attributes declared in earlier ranges
+		size_t positionBase{ 0 };
+		size_t normalBase{ 0 };
+		size_t texcoordBase{ 0 };
+
+		std::vector<uint32_t> positionIndices;
+		std::vector<int32_t> normalIndices;
+		std::vector<int32_t> texcoordIndices;
+		std::vector<uint32_t> quads;	// First of the two triangles each quad was split into
+
+		std::string error;
+	};
+
+	bool IsSpace(char c)
+	{
+		return c == ' ' || c == '\t' || c == '\r';
+	}
+
+	const char* SkipSpaces(const char* p, const char* lineEnd)
+	{
+		while (p != lineEnd && IsSpace(*p))
+			++p;
+		return p;
+	}
+
+	const char* FindLineEnd(const char* p, const char* end)
+	{
+		const char* lineEnd = static_cast<const char*>(memchr(p, '\n', end - p));
+		return (lineEnd != nullptr) ? lineEnd : end;
+	}
+
+	const char* NextLine(const char* lineEnd, const char* end)
+	{
+		return (lineEnd != end) ? lineEnd + 1 : end;
+	}
+
+	// Moves p past the statement keyword
+	LineType Classify(const char*& p, const char* lineEnd)
+	{
+		p = SkipSpaces(p, lineEnd);
+		const size_t length = lineEnd - p;
+		if (length >= 2 && p[0] == 'v' && IsSpace(p[1]))
+		{
+			p += 1;
+			return LineType::Position;
+		}
+		if (length >= 3 && p[0] == 'v' && p[1] == 'n' && IsSpace(p[2]))
+		{
+			p += 2;
+			return LineType::Normal;
+		}
+		if (length >= 3 && p[0] == 'v' && p[1] == 't' && IsSpace(p[2]))
+		{
+			p += 2;
+			return LineType::Texcoord;
+		}
+		if (length >= 2 && p[0] == 'f' && IsSpace(p[1]))
+		{
+			p += 1;
+			return LineType::Face;
+		}
+		return LineType::Other;
+	}
+
+	// Reads up to count floats and returns how many the line had, or -1 if something else was in the
+	// way. Anything after them (w, vertex colours) is ignored.
+	int ParseFloats(const char* p, const char* lineEnd, float* values, int count)
+	{
+		int parsed = 0;
+		for (; parsed < count; ++parsed)
+		{
+			p = SkipSpaces(p, lineEnd);
+			if (p == lineEnd)
+				break;
+			if (*p == '+')
+				++p;
+
+			const std::from_chars_result result = std::from_chars(p, lineEnd, values[parsed]);
+			if (result.ec != std::errc() || (result.ptr != lineEnd && !IsSpace(*result.ptr)))
+				return -1;
+			p = result.ptr;
+		}
+		return parsed;
+	}
+
+	bool ParseIndex(const char*& p, const char* lineEnd, int64_t& index)
+	{
+		const bool negative = (p != lineEnd && *p == '-');
+		if (negative)
+			++p;
+
+		const char* start = p;
+		int64_t value = 0;
+		while (p != lineEnd && *p >= '0' && *p <= '9' && value < INT32_MAX)
+			value = value * 10 + (*p++ - '0');
+
+		index = negative ? -value : value;
+		return p != start;
+	}
+
+	// 1-based indices count from the start of the file, negative ones back from the current attribute
+	bool ResolveIndex(int64_t index, size_t declared, size_t total, int64_t& resolved)
+	{
+		resolved = (index > 0) ? index - 1 : static_cast<int64_t>(declared) + index;
+		return index != 0 && resolved >= 0 && resolved < static_cast<int64_t>(total);
+	}
+
+	constexpr int MAX_FACE_CORNERS = 4;
+
+	bool ParseFace(const char* p, const char* lineEnd, ObjRange& range, size_t positionTotal, size_t normalTotal, size_t texcoordTotal)
+	{
+		int64_t positions[MAX_FACE_CORNERS];
+		int64_t normals[MAX_FACE_CORNERS];
+		int64_t texcoords[MAX_FACE_CORNERS];
+		int corners = 0;
+
+		for (p = SkipSpaces(p, lineEnd); p != lineEnd; p = SkipSpaces(p, lineEnd))
+		{
+			if (corners == MAX_FACE_CORNERS)
+			{
+				range.error = "faces with more than 4 corners";
+				return false;
+			}
+
+			// p, p/t, p//n or p/t/n
+			int64_t index;
+			normals[corners] = -1;
+			texcoords[corners] = -1;
+			if (!ParseIndex(p, lineEnd, index) || !ResolveIndex(index, range.positionBase + range.positionCount, positionTotal, positions[corners]))
+				break;
+
+			if (p != lineEnd && *p == '/')
+			{
+				++p;
+				if (p != lineEnd && *p != '/'
+					&& (!ParseIndex(p, lineEnd, index) || !ResolveIndex(index, range.texcoordBase + range.texcoordCount, texcoordTotal, texcoords[corners])))
+					break;
+
+				if (p != lineEnd && *p == '/')
+				{
+					++p;
+					if (!ParseIndex(p, lineEnd, index) || !ResolveIndex(index, range.normalBase + range.normalCount, normalTotal, normals[corners]))
+						break;
+				}
+			}
+
+			if (p != lineEnd && !IsSpace(*p))
+				break;
+			++corners;
+		}
+
+		if (p != lineEnd || corners < 3)
+		{
+			range.error = "malformed face";
+			return false;
+		}
+
+		// Quads are split along 0-2 for now, and recut once all positions are known if that was concave
+		if (corners == MAX_FACE_CORNERS)
+			range.quads.push_back(static_cast<uint32_t>(range.positionIndices.size() / 3));
+
+		const int triangles[2][3] = { { 0, 1, 2 }, { 0, 2, 3 } };
+		for (int t = 0; t < corners - 2; ++t)
+		{
+			for (int k : triangles[t])
+			{
+				range.positionIndices.push_back(static_cast<uint32_t>(positions[k]));
+				range.normalIndices.push_back(static_cast<int32_t>(normals[k]));
+				range.texcoordIndices.push_back(static_cast<int32_t>(texcoords[k]));
+			}
+		}
+		return true;
+	}
+
+	void CountAttributes(ObjRange& range)
+	{
+		for (const char* p = range.begin; p < range.end; )
+		{
+			const char* lineEnd = FindLineEnd(p, range.end);
+			switch (Classify(p, lineEnd))
+			{
+			case LineType::Position:
+				++range.positionCount;
+				break;
+			case LineType::Normal:
+				++range.normalCount;
+				break;
+			case LineType::Texcoord:
+				++range.texcoordCount;
+				break;
+			default:
+				break;
+			}
+			p = NextLine(lineEnd, range.end);
+		}
+	}
+
+	// Attributes go straight into their final place in obj; faces are kept in the range until merged
+	void ParseRange(ObjRange& range, ObjData& obj)
+	{
+		const size_t positionTotal = obj.positions.size() / 3;
+		const size_t normalTotal = obj.normals.size() / 3;
+		const size_t texcoordTotal = obj.texcoords.size() / 2;
+
+		range.positionCount = 0;
+		range.normalCount = 0;
+		range.texcoordCount = 0;
+
+		for (const char* p = range.begin; p < range.end; )
+		{
+			const char* lineEnd = FindLineEnd(p, range.end);
+			bool parsed = true;
+			switch (Classify(p, lineEnd))
+			{
+			case LineType::Position:
+				parsed = ParseFloats(p, lineEnd, &obj.positions[(range.positionBase + range.positionCount++) * 3], 3) == 3;
+				break;
+			case LineType::Normal:
+				parsed = ParseFloats(p, lineEnd, &obj.normals[(range.normalBase + range.normalCount++) * 3], 3) == 3;
+				break;
+			case LineType::Texcoord:
+			{
+				// v is optional, for 1D textures
+				float* texcoord = &obj.texcoords[(range.texcoordBase + range.texcoordCount++) * 2];
+				texcoord[1] = 0.0f;
+				parsed = ParseFloats(p, lineEnd, texcoord, 2) >= 1;
+				break;
+			}
+			case LineType::Face:
+				if (!ParseFace(p, lineEnd, range, positionTotal, normalTotal, texcoordTotal))
+					return;
+				break;
+			default:
+				break;
+			}
+
+			if (!parsed)
+			{
+				range.error = "malformed vertex attribute";
+				return;
+			}
+			p = NextLine(lineEnd, range.end);
+		}
+	}
+
+	// A quad split along 0-2 folds over itself when corner 1 or 3 is concave, or leaves a sliver when
+	// one is flat; 1-3 is the right cut then
+	void FixQuad(ObjData& obj, size_t firstIndex)
+	{
+		uint32_t* positionIndices = &obj.positionIndices[firstIndex];
+		const uint32_t corners[4] = { positionIndices[0], positionIndices[1], positionIndices[2], positionIndices[5] };
+
+		float points[4][3];
+		for (int k = 0; k < 4; ++k)
+			memcpy(points[k], &obj.positions[static_cast<size_t>(corners[k]) * 3], sizeof(points[k]));
+
+		// Newell's method, which holds up for non-planar and concave quads
+		float normal[3] = { 0.0f, 0.0f, 0.0f };
+		for (int k = 0; k < 4; ++k)
+		{
+			const float* a = points[k];
+			const float* b = points[(k + 1) % 4];
+			normal[0] += (a[1] - b[1]) * (a[2] + b[2]);
+			normal[1] += (a[2] - b[2]) * (a[0] + b[0]);
+			normal[2] += (a[0] - b[0]) * (a[1] + b[1]);
+		}
+
+		auto isConcaveOrFlat = [&](int k)
+		{
+			const float* previous = points[(k + 3) % 4];
+			const float* corner = points[k];
+			const float* next = points[(k + 1) % 4];
+			const float e0[3] = { corner[0] - previous[0], corner[1] - previous[1], corner[2] - previous[2] };
+			const float e1[3] = { next[0] - corner[0], next[1] - corner[1], next[2] - corner[2] };
+			const float cross[3] = { e0[1] * e1[2] - e0[2] * e1[1], e0[2] * e1[0] - e0[0] * e1[2], e0[0] * e1[1] - e0[1] * e1[0] };
+			return cross[0] * normal[0] + cross[1] * normal[1] + cross[2] * normal[2] <= 0.0f;
+		};
+
+		if (!isConcaveOrFlat(1) && !isConcaveOrFlat(3))
+			return;
+
+		// (0, 1, 2), (0, 2, 3) becomes (1, 2, 3), (1, 3, 0)
+		auto recut = [firstIndex](auto& indices)
+		{
+			const auto c0 = indices[firstIndex + 0];
+			const auto c1 = indices[firstIndex + 1];
+			const auto c2 = indices[firstIndex + 2];
+			const auto c3 = indices[firstIndex + 5];
+			const decltype(c0) cut[6] = { c1, c2, c3, c1, c3, c0 };
+			for (size_t i = 0; i < 6; ++i)
+				indices[firstIndex + i] = cut[i];
+		};
+		recut(obj.positionIndices);
+		recut(obj.normalIndices);
+		recut(obj.texcoordIndices);
+	}
+}
+
+
+bool ParseObj(const char* path, ObjData& obj, std::string& error)
+{
+	assets::MappedFile file;
+	if (!file.Open(path))
+	{
+		error = "can't open file";
+		return false;
+	}
+
+	// Line-aligned ranges: each one ends just past a line break
+	std::vector<ObjRange> ranges;
+	const char* data = file.Data();
+	const char* end = data + file.Size();
+	for (const char* begin = data; begin < end; )
+	{
+		const char* rangeEnd = begin + std::min(OBJ_PARSE_RANGE_SIZE, static_cast<size_t>(end - begin));
+		rangeEnd = NextLine(FindLineEnd(rangeEnd, end), end);
+
+		ObjRange range;
+		range.begin = begin;
+		range.end = rangeEnd;
+		ranges.push_back(std::move(range));
+		begin = rangeEnd;
+	}
+
+	// Counting first lets every range write its attributes in place, and resolve relative indices
+	assets::ParallelFor(ranges.size(), [&](size_t r) { CountAttributes(ranges[r]); });
+
+	size_t positionCount = 0;
+	size_t normalCount = 0;
+	size_t texcoordCount = 0;
+	for (ObjRange& range : ranges)
+	{
+		range.positionBase = positionCount;
+		range.normalBase = normalCount;
+		range.texcoordBase = texcoordCount;
+		positionCount += range.positionCount;
+		normalCount += range.normalCount;
+		texcoordCount += range.texcoordCount;
+	}
+
+	obj.positions.resize(positionCount * 3);
+	obj.normals.resize(normalCount * 3);
+	obj.texcoords.resize(texcoordCount * 2);
+
+	assets::ParallelFor(ranges.size(), [&](size_t r) { ParseRange(ranges[r], obj); });
+
+	size_t indexCount = 0;
+	for (const ObjRange& range : ranges)
+	{
+		if (!range.error.empty())
+		{
+			error = range.error;
+			return false;
+		}
+		indexCount += range.positionIndices.size();
+	}
+
+	obj.positionIndices.resize(indexCount);
+	obj.normalIndices.resize(indexCount);
+	obj.texcoordIndices.resize(indexCount);
+
+	std::vector<size_t> firstIndices(ranges.size());
+	for (size_t r = 0, first = 0; r < ranges.size(); ++r)
+	{
+		firstIndices[r] = first;
+		first += ranges[r].positionIndices.size();
+	}
+
+	assets::ParallelFor(ranges.size(), [&](size_t r)
+		{
+			const ObjRange& range = ranges[r];
+			const size_t first = firstIndices[r];
+			const size_t count = range.positionIndices.size();
+			if (count == 0)
+				return;
+
+			memcpy(&obj.positionIndices[first], range.positionIndices.data(), count * sizeof(uint32_t));
+			memcpy(&obj.normalIndices[first], range.normalIndices.data(), count * sizeof(int32_t));
+			memcpy(&obj.texcoordIndices[first], range.texcoordIndices.data(), count * sizeof(int32_t));
+
+			for (uint32_t quad : range.quads)
+				FixQuad(obj, first + static_cast<size_t>(quad) * 3);
+		});
+
+	return true;
+}
\ No newline at end of file
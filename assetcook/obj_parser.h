@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Geometry read from an OBJ file: one flat array per attribute, and one index array per attribute
+// with an entry for every triangle corner. Groups, objects and materials are not kept.
+struct ObjData
+{
+	std::vector<float> positions;	// x, y, z
+	std::vector<float> normals;		// x, y, z
+	std::vector<float> texcoords;	// u, v as stored in the file
+	std::vector<uint32_t> positionIndices;
+	std::vector<int32_t> normalIndices;		// -1 for corners without one
+	std::vector<int32_t> texcoordIndices;	// -1 for corners without one
+};
+
+// Bytes of the file each parse job takes, cut at the next line break
+constexpr size_t OBJ_PARSE_RANGE_SIZE = 1024 * 1024;
+
+// Memory-maps the file and parses it on all cores. Only handles v, vn, vt and triangle or quad
+// faces (other statements are skipped); returns false with the reason in error for anything else,
+// so the caller can fall back to a full OBJ loader.
+bool ParseObj(const char* path, ObjData& obj, std::string& error);
\ No newline at end of file
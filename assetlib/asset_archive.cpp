@@ -0,0 +1,186 @@
+#include "asset_archive.h"
+
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+
+#define ARCHIVE_VERSION 1
+
+static const char ARCHIVE_MAGIC[4] = { 'X', 'P', 'A', 'K' };
+
+
+uint64_t assets::HashAssetName(const char* name)
+{
+	// FNV-1a 64-bit; path separators are normalized so names match across platforms
+	uint64_t hash = 14695981039346656037ull;
+	for (const char* c = name; *c; ++c)
+	{
+		char ch = (*c == '\\') ? '/' : *c;
+		hash ^= static_cast<uint8_t>(ch);
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+
+static void PadTo(std::ofstream& outFile, uint64_t alignment)
+{
+	static const char zeros[assets::ARCHIVE_ALIGNMENT] = {};
+	uint64_t pos = static_cast<uint64_t>(outFile.tellp());
+	uint64_t padding = (alignment - (pos % alignment)) % alignment;
+	outFile.write(zeros, padding);
+}
+
+
+bool assets::ArchiveWriter::Open(const char* path)
+{
+	outFile.open(path, std::ofstream::binary | std::ofstream::trunc);
+	if (!outFile.is_open())
+	{
+		std::cout << "ERROR: Archive: failed to open for writing: " << path << std::endl;
+		return false;
+	}
+
+	entries.clear();
+
+	// Placeholder header, rewritten once the table of contents is known
+	ArchiveHeader header{};
+	outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	return true;
+}
+
+bool assets::ArchiveWriter::AddAsset(const char* name, const AssetFile& file)
+{
+	ArchiveEntry entry{};
+	entry.nameHash = HashAssetName(name);
+
+	for (auto& e : entries)
+	{
+		if (e.nameHash == entry.nameHash)
+		{
+			std::cout << "ERROR: Archive: duplicate or colliding asset name: " << name << std::endl;
+			return false;
+		}
+	}
+
+	PadTo(outFile, ARCHIVE_ALIGNMENT);
+
+	entry.offset = static_cast<uint64_t>(outFile.tellp());
+	WriteBinary(outFile, file);
+	entry.size = static_cast<uint64_t>(outFile.tellp()) - entry.offset;
+	std::memcpy(entry.type, file.type, 4);
+	entry.version = file.version;
+
+	entries.push_back(entry);
+
+	return outFile.good();
+}
+
+bool assets::ArchiveWriter::Close()
+{
+	std::sort(entries.begin(), entries.end(), [](const ArchiveEntry& a, const ArchiveEntry& b)
+		{
+			return a.nameHash < b.nameHash;
+		});
+
+	PadTo(outFile, alignof(ArchiveEntry));
+
+	ArchiveHeader header{};
+	std::memcpy(header.magic, ARCHIVE_MAGIC, 4);
+	header.version = ARCHIVE_VERSION;
+	header.entryCount = entries.size();
+	header.tocOffset = static_cast<uint64_t>(outFile.tellp());
+
+	outFile.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(ArchiveEntry));
+
+	outFile.seekp(0);
+	outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	bool ok = outFile.good();
+	outFile.close();
+
+	return ok;
+}
+
+
+bool assets::ArchiveReader::Open(const char* archivePath)
+{
+	Close();
+
+	if (!file.Open(archivePath))
+		return false;
+
+	ArchiveHeader header{};
+	if (file.Size() < sizeof(header))
+	{
+		std::cout << "ERROR: Archive: too small for header: " << archivePath << std::endl;
+		Close();
+		return false;
+	}
+	std::memcpy(&header, file.Data(), sizeof(header));
+
+	if (std::memcmp(header.magic, ARCHIVE_MAGIC, 4) != 0 || header.version != ARCHIVE_VERSION)
+	{
+		std::cout << "ERROR: Archive: invalid header or version: " << archivePath << std::endl;
+		Close();
+		return false;
+	}
+
+	if (header.tocOffset % alignof(ArchiveEntry) != 0 || header.tocOffset > file.Size() || header.entryCount > (file.Size() - header.tocOffset) / sizeof(ArchiveEntry))
+	{
+		std::cout << "ERROR: Archive: truncated table of contents: " << archivePath << std::endl;
+		Close();
+		return false;
+	}
+
+	entries = reinterpret_cast<const ArchiveEntry*>(file.Data() + header.tocOffset);
+	entryCount = static_cast<size_t>(header.entryCount);
+	path = archivePath;
+
+	return true;
+}
+
+void assets::ArchiveReader::Close()
+{
+	file.Close();
+	path.clear();
+	entries = nullptr;
+	entryCount = 0;
+}
+
+const assets::ArchiveEntry* assets::ArchiveReader::Find(const char* name) const
+{
+	const uint64_t hash = HashAssetName(name);
+	const ArchiveEntry* end = entries + entryCount;
+
+	const ArchiveEntry* it = std::lower_bound(entries, end, hash, [](const ArchiveEntry& e, uint64_t h)
+		{
+			return e.nameHash < h;
+		});
+
+	if (it == end || it->nameHash != hash)
+		return nullptr;
+	return it;
+}
+
+bool assets::ArchiveReader::LoadAsset(const ArchiveEntry* entry, AssetView& asset, uint32_t verify) const
+{
+	if (entry == nullptr || entry->offset > file.Size() || entry->size > file.Size() - entry->offset)
+		return false;
+
+	return ParseBinary(file.Data() + entry->offset, static_cast<size_t>(entry->size), asset, verify);
+}
+
+bool assets::ArchiveReader::LoadAsset(const char* name, AssetView& asset, uint32_t verify) const
+{
+	return LoadAsset(Find(name), asset, verify);
+}
+
+void assets::ArchiveReader::SortByOffset(std::vector<const ArchiveEntry*>& batch)
+{
+	std::sort(batch.begin(), batch.end(), [](const ArchiveEntry* a, const ArchiveEntry* b)
+		{
+			return a->offset < b->offset;
+		});
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <fstream>
+#include "asset_core.h"
+
+namespace assets
+{
+	// Entries start on page boundaries so each one can be mapped or read independently
+	constexpr uint64_t ARCHIVE_ALIGNMENT = 4096;
+
+	struct ArchiveHeader
+	{
+		char magic[4];
+		uint32_t version;
+		uint64_t entryCount;
+		uint64_t tocOffset;
+	};
+
+	// Table of contents entry; the table is stored sorted by nameHash
+	struct ArchiveEntry
+	{
+		uint64_t nameHash;
+		uint64_t offset;
+		uint64_t size;
+		char type[4];
+		uint32_t version;
+	};
+
+	uint64_t HashAssetName(const char* name);
+
+	class ArchiveWriter
+	{
+	public:
+		bool Open(const char* path);
+		bool AddAsset(const char* name, const AssetFile& file);
+		bool Close();
+
+		size_t GetEntryCount() const { return entries.size(); }
+
+	private:
+		std::ofstream outFile;
+		std::vector<ArchiveEntry> entries;
+	};
+
+	class ArchiveReader
+	{
+	public:
+		bool Open(const char* path);
+		void Close();
+		bool IsOpen() const { return file.IsOpen(); }
+
+		// Binary search of the table of contents, nullptr if missing
+		const ArchiveEntry* Find(const char* name) const;
+
+		// The view points into the archive's mapping, so it's valid while the reader stays open
+		bool LoadAsset(const ArchiveEntry* entry, AssetView& asset, uint32_t verify = VerifyNone) const;
+		bool LoadAsset(const char* name, AssetView& asset, uint32_t verify = VerifyNone) const;
+
+		const ArchiveEntry* GetEntries() const { return entries; }
+		const std::string& GetPath() const { return path; }
+		size_t GetEntryCount() const { return entryCount; }
+
+		// Orders a batch of lookups by file position, so loads walk the archive front to back
+		static void SortByOffset(std::vector<const ArchiveEntry*>& batch);
+
+	private:
+		MappedFile file;
+		std::string path;
+		const ArchiveEntry* entries{ nullptr };
+		size_t entryCount{ 0 };
+	};
+}
\ No newline at end of file
@@ -2,8 +2,79 @@
 
 #include <iostream>
 #include <fstream>
+#include <cstring>
+#include <cstddef>
+#include <algorithm>
+#define XXH_STATIC_LINKING_ONLY
+#include "xxhash.h"
+#include "lz4.h"
+#include "lz4hc.h"
 
-#define ASSET_VERSION 1
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define ASSET_VERSION 2
+#define ASSET_VERSION_JSON 1
+
+// Format version 1 header: type, packed version, json length, blob length
+constexpr size_t ASSET_HEADER_SIZE_V1 = 4 + 3 * sizeof(uint32_t);
+
+// Format version 2 header, followed by the binary metadata and then the blob
+struct AssetHeader
+{
+	char type[4];
+	uint32_t version;		// ASSET_VERSION << 16 | content version
+	uint32_t headerSize;	// Bytes of header written, so fields can be appended without a version bump
+	uint32_t metaSize;
+	uint64_t blobSize;
+	uint64_t blobHash;		// XXH64 of the stored blob, 0 if absent
+	uint64_t contentHash;	// XXH64 of the uncompressed payload, 0 if absent
+};
+static_assert(sizeof(AssetHeader) == 40, "AssetHeader layout is part of the file format");
+
+
+uint64_t assets::HashData(const void* data, size_t size)
+{
+	return XXH64(data, size, 0);
+}
+
+static_assert(sizeof(assets::StreamHash::state) >= sizeof(XXH64_state_t), "StreamHash storage too small for XXH64 state");
+
+assets::StreamHash::StreamHash()
+{
+	XXH64_reset(reinterpret_cast<XXH64_state_t*>(state), 0);
+}
+
+void assets::StreamHash::Update(const void* data, size_t size)
+{
+	XXH64_update(reinterpret_cast<XXH64_state_t*>(state), data, size);
+}
+
+uint64_t assets::StreamHash::Digest() const
+{
+	return XXH64_digest(reinterpret_cast<const XXH64_state_t*>(state));
+}
+
+static bool CheckBlobHash(uint64_t expected, const char* blob, size_t size)
+{
+	if (expected == 0)
+		return true;
+
+	if (assets::HashData(blob, size) != expected)
+	{
+		std::cout << "ERROR: Asset: blob checksum mismatch, file is corrupt or truncated" << std::endl;
+		return false;
+	}
+	return true;
+}
 
 
 bool assets::SaveBinary(const char* path, const AssetFile& file)
@@ -16,57 +87,255 @@ bool assets::SaveBinary(const char* path, const AssetFile& file)
 		return false;
 	}
 
-	outFile.write(reinterpret_cast<const char*>(&file.type), 4);
+	WriteBinary(outFile, file);
+
+	outFile.close();
 
-	uint32_t assetVersion = ASSET_VERSION << 16;
-	uint32_t contentVersion = file.version & 0x0000ffff;
-	uint32_t versionPacked = assetVersion | contentVersion;
-	outFile.write(reinterpret_cast<const char*>(&versionPacked), sizeof(uint32_t));
+	return true;
+}
 
-	uint32_t jsonLen = static_cast<uint32_t>(file.json.size());
-	outFile.write(reinterpret_cast<const char*>(&jsonLen), sizeof(uint32_t));
-	uint32_t blobLen = static_cast<uint32_t>(file.blob.size());
-	outFile.write(reinterpret_cast<const char*>(&blobLen), sizeof(uint32_t));
+bool assets::SaveJsonSidecar(const char* path, const AssetFile& file)
+{
+	std::string sidecarPath = std::string(path) + ".json";
 
-	outFile.write(file.json.data(), jsonLen);
-	outFile.write(file.blob.data(), blobLen);
+	std::ofstream outFile;
+	outFile.open(sidecarPath, std::ofstream::trunc);
+	if (!outFile.is_open())
+	{
+		std::cout << "ERROR: Asset: failed to open for writing: " << sidecarPath << std::endl;
+		return false;
+	}
 
+	outFile << file.json;
 	outFile.close();
 
 	return true;
 }
 
-bool assets::LoadBinary(const char* path, AssetFile& asset)
+void assets::WriteBinary(std::ostream& outFile, const AssetFile& file)
 {
-	std::ifstream inFile;
-	inFile.open(path, std::ifstream::binary);
+	AssetHeader header{};
+	std::memcpy(header.type, file.type, 4);
+	header.version = (ASSET_VERSION << 16) | (file.version & 0x0000ffff);
+	header.headerSize = sizeof(AssetHeader);
+	header.metaSize = static_cast<uint32_t>(file.meta.size());
+	header.blobSize = file.blob.size();
+	header.blobHash = HashData(file.blob.data(), file.blob.size());
+	header.contentHash = file.contentHash;
 
-	if (!inFile.is_open())
+	outFile.write(reinterpret_cast<const char*>(&header), sizeof(AssetHeader));
+	outFile.write(file.meta.data(), file.meta.size());
+	outFile.write(file.blob.data(), file.blob.size());
+}
+
+// Reads everything up to the blob of an asset starting at offset, leaving the stream at the blob
+static bool ReadHeaderAndMeta(std::ifstream& inFile, uint64_t offset, assets::AssetFile& asset, uint64_t& blobSize)
+{
+	// Every size in the header is checked against what the file holds before anything is sized from it
+	inFile.seekg(0, std::ios::end);
+	const uint64_t fileSize = static_cast<uint64_t>(inFile.tellg());
+	if (!inFile.good() || offset > fileSize || fileSize - offset < ASSET_HEADER_SIZE_V1)
+	{
+		std::cout << "ERROR: Asset: Too small for header" << std::endl;
 		return false;
+	}
+	const uint64_t size = fileSize - offset;
 
-	inFile.seekg(0);
+	inFile.seekg(offset);
 
 	inFile.read(asset.type, 4);
 
 	uint32_t versionPacked = 0;
 	inFile.read(reinterpret_cast<char*>(&versionPacked), sizeof(uint32_t));
 	uint32_t assetVersion = (versionPacked >> 16);
+	asset.version = versionPacked & 0x0000ffff;
+
+	if (assetVersion == ASSET_VERSION_JSON)
+	{
+		uint32_t jsonLen = 0;
+		inFile.read(reinterpret_cast<char*>(&jsonLen), sizeof(uint32_t));
+		uint32_t blobLen = 0;
+		inFile.read(reinterpret_cast<char*>(&blobLen), sizeof(uint32_t));
+
+		if (jsonLen > size - ASSET_HEADER_SIZE_V1 || blobLen > size - ASSET_HEADER_SIZE_V1 - jsonLen)
+		{
+			std::cout << "ERROR: Asset: Truncated data" << std::endl;
+			return false;
+		}
+
+		asset.json.resize(jsonLen);
+		inFile.read(asset.json.data(), jsonLen);
+		asset.meta.clear();
+		asset.blobHash = 0;
+		asset.contentHash = 0;
+		blobSize = blobLen;
+
+		return inFile.good();
+	}
+
 	if (assetVersion != ASSET_VERSION)
 	{
 		std::cout << "ERROR: Asset: Invalid version: read " << assetVersion << ", need " << ASSET_VERSION << std::endl;
 		return false;
 	}
+
+	AssetHeader header{};
+	uint32_t headerSize = 0;
+	inFile.read(reinterpret_cast<char*>(&headerSize), sizeof(uint32_t));
+	if (headerSize < offsetof(AssetHeader, blobSize) + sizeof(uint64_t) || headerSize > size)
+	{
+		std::cout << "ERROR: Asset: Invalid header size " << headerSize << std::endl;
+		return false;
+	}
+
+	// Read the fields this build knows about, and skip any newer ones
+	const size_t knownSize = std::min<size_t>(headerSize, sizeof(AssetHeader));
+	inFile.read(reinterpret_cast<char*>(&header) + 12, knownSize - 12);
+	inFile.seekg(offset + headerSize, std::ios::beg);
+
+	if (header.metaSize > size - headerSize || header.blobSize > size - headerSize - header.metaSize)
+	{
+		std::cout << "ERROR: Asset: Truncated data" << std::endl;
+		return false;
+	}
+
+	asset.json.clear();
+	asset.meta.resize(header.metaSize);
+	inFile.read(asset.meta.data(), header.metaSize);
+	asset.blobHash = header.blobHash;
+	asset.contentHash = header.contentHash;
+	blobSize = header.blobSize;
+
+	return inFile.good();
+}
+
+bool assets::LoadBinary(const char* path, AssetFile& asset, uint32_t verify)
+{
+	std::ifstream inFile;
+	inFile.open(path, std::ifstream::binary);
+
+	if (!inFile.is_open())
+		return false;
+
+	uint64_t blobSize = 0;
+	if (!ReadHeaderAndMeta(inFile, 0, asset, blobSize))
+		return false;
+
+	asset.blob.resize(blobSize);
+	inFile.read(asset.blob.data(), blobSize);
+
+	if (!inFile.good())
+		return false;
+
+	if ((verify & VerifyBlob) && !CheckBlobHash(asset.blobHash, asset.blob.data(), asset.blob.size()))
+		return false;
+
+	return true;
+}
+
+bool assets::LoadBinaryHeader(const char* path, uint64_t offset, AssetFile& asset, uint64_t& blobOffset, uint64_t& blobSize)
+{
+	std::ifstream inFile;
+	inFile.open(path, std::ifstream::binary);
+
+	if (!inFile.is_open())
+		return false;
+
+	if (!ReadHeaderAndMeta(inFile, offset, asset, blobSize))
+		return false;
+
+	asset.blob.clear();
+	blobOffset = static_cast<uint64_t>(inFile.tellg());
+	return true;
+}
+
+bool assets::LoadBinaryMapped(const char* path, AssetView& asset, uint32_t verify)
+{
+	if (!asset.file.Open(path))
+		return false;
+
+	if (!ParseBinary(asset.file.Data(), asset.file.Size(), asset, verify))
+	{
+		std::cout << "ERROR: Asset: failed to parse: " << path << std::endl;
+		asset.file.Close();
+		return false;
+	}
+
+	return true;
+}
+
+bool assets::ParseBinary(const char* data, size_t size, AssetView& asset, uint32_t verify)
+{
+	if (size < ASSET_HEADER_SIZE_V1)
+	{
+		std::cout << "ERROR: Asset: Too small for header" << std::endl;
+		return false;
+	}
+
+	std::memcpy(asset.type, data, 4);
+
+	uint32_t versionPacked = 0;
+	std::memcpy(&versionPacked, data + 4, sizeof(uint32_t));
+	uint32_t assetVersion = (versionPacked >> 16);
 	asset.version = versionPacked & 0x0000ffff;
 
-	uint32_t jsonLen = 0;
-	inFile.read(reinterpret_cast<char*>(&jsonLen), sizeof(uint32_t));
-	uint32_t blobLen = 0;
-	inFile.read(reinterpret_cast<char*>(&blobLen), sizeof(uint32_t));
+	if (assetVersion == ASSET_VERSION_JSON)
+	{
+		uint32_t jsonLen = 0;
+		std::memcpy(&jsonLen, data + 8, sizeof(uint32_t));
+		uint32_t blobLen = 0;
+		std::memcpy(&blobLen, data + 12, sizeof(uint32_t));
+
+		if (jsonLen > size - ASSET_HEADER_SIZE_V1 || blobLen > size - ASSET_HEADER_SIZE_V1 - jsonLen)
+		{
+			std::cout << "ERROR: Asset: Truncated data" << std::endl;
+			return false;
+		}
+
+		asset.json = std::string_view(data + ASSET_HEADER_SIZE_V1, jsonLen);
+		asset.meta = nullptr;
+		asset.metaSize = 0;
+		asset.blob = data + ASSET_HEADER_SIZE_V1 + jsonLen;
+		asset.blobSize = blobLen;
+		asset.blobHash = 0;
+		asset.contentHash = 0;
+
+		return true;
+	}
+
+	if (assetVersion != ASSET_VERSION)
+	{
+		std::cout << "ERROR: Asset: Invalid version: read " << assetVersion << ", need " << ASSET_VERSION << std::endl;
+		return false;
+	}
+
+	AssetHeader header{};
+	uint32_t headerSize = 0;
+	std::memcpy(&headerSize, data + 8, sizeof(uint32_t));
+	if (headerSize < offsetof(AssetHeader, blobSize) + sizeof(uint64_t) || headerSize > size)
+	{
+		std::cout << "ERROR: Asset: Invalid header size " << headerSize << std::endl;
+		return false;
+	}
+	std::memcpy(&header, data, std::min<size_t>(headerSize, sizeof(AssetHeader)));
+
+	// Subtracted rather than summed, so a corrupt blobSize can't wrap around and pass
+	if (header.metaSize > size - headerSize || header.blobSize > size - headerSize - header.metaSize)
+	{
+		std::cout << "ERROR: Asset: Truncated data" << std::endl;
+		return false;
+	}
+
+	asset.json = std::string_view();
+	asset.meta = data + headerSize;
+	asset.metaSize = header.metaSize;
+	asset.blob = data + headerSize + header.metaSize;
+	asset.blobSize = static_cast<size_t>(header.blobSize);
+	asset.blobHash = header.blobHash;
+	asset.contentHash = header.contentHash;
 
-	asset.json.resize(jsonLen);
-	inFile.read(asset.json.data(), jsonLen);
-	asset.blob.resize(blobLen);
-	inFile.read(asset.blob.data(), blobLen);
+	if ((verify & VerifyBlob) && !CheckBlobHash(asset.blobHash, asset.blob, asset.blobSize))
+		return false;
 
 	return true;
 }
@@ -75,5 +344,150 @@ assets::CompressionMode assets::ParseCompression(const char* string)
 {
 	if (strcmp(string, "LZ4") == 0)
 		return CompressionMode::LZ4;
+	if (strcmp(string, "LZ4HC") == 0)
+		return CompressionMode::LZ4HC;
 	return CompressionMode::None;
+}
+
+const char* assets::CompressionName(CompressionMode mode)
+{
+	switch (mode)
+	{
+	case CompressionMode::LZ4:
+		return "LZ4";
+	case CompressionMode::LZ4HC:
+		return "LZ4HC";
+	default:
+		return "None";
+	}
+}
+
+int assets::CompressBound(int sourceSize)
+{
+	return LZ4_compressBound(sourceSize);
+}
+
+int assets::CompressBlock(const PackOptions& options, const char* source, int sourceSize, char* destination, int destinationCapacity)
+{
+	switch (options.compression)
+	{
+	case CompressionMode::LZ4:
+		return LZ4_compress_fast(source, destination, sourceSize, destinationCapacity, options.level > 0 ? options.level : 1);
+	case CompressionMode::LZ4HC:
+		return LZ4_compress_HC(source, destination, sourceSize, destinationCapacity, options.level > 0 ? options.level : LZ4HC_CLEVEL_DEFAULT);
+	default:
+		return 0;
+	}
+}
+
+
+assets::MappedFile::~MappedFile()
+{
+	Close();
+}
+
+assets::MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+	*this = std::move(other);
+}
+
+assets::MappedFile& assets::MappedFile::operator=(MappedFile&& other) noexcept
+{
+	if (this != &other)
+	{
+		Close();
+
+		data = other.data;
+		size = other.size;
+		other.data = nullptr;
+		other.size = 0;
+#ifdef _WIN32
+		fileHandle = other.fileHandle;
+		mappingHandle = other.mappingHandle;
+		other.fileHandle = nullptr;
+		other.mappingHandle = nullptr;
+#endif
+	}
+	return *this;
+}
+
+bool assets::MappedFile::Open(const char* path)
+{
+	Close();
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER fileSize{};
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping == nullptr)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (view == nullptr)
+	{
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+
+	fileHandle = file;
+	mappingHandle = mapping;
+	data = reinterpret_cast<const char*>(view);
+	size = static_cast<size_t>(fileSize.QuadPart);
+#else
+	int fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	struct stat st {};
+	if (fstat(fd, &st) != 0 || st.st_size == 0)
+	{
+		close(fd);
+		return false;
+	}
+
+	void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	// The mapping holds its own reference to the file
+	close(fd);
+	if (view == MAP_FAILED)
+		return false;
+
+	madvise(view, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+
+	data = reinterpret_cast<const char*>(view);
+	size = static_cast<size_t>(st.st_size);
+#endif
+
+	return true;
+}
+
+void assets::MappedFile::Close()
+{
+	if (data == nullptr)
+		return;
+
+#ifdef _WIN32
+	UnmapViewOfFile(data);
+	CloseHandle(mappingHandle);
+	CloseHandle(fileHandle);
+	mappingHandle = nullptr;
+	fileHandle = nullptr;
+#else
+	munmap(const_cast<char*>(data), size);
+#endif
+
+	data = nullptr;
+	size = 0;
 }
\ No newline at end of file
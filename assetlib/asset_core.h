@@ -1,24 +1,213 @@
 #pragma once
 
+#include <cstdint>
+#include <cstring>
+#include <iosfwd>
 #include <string>
+#include <string_view>
 #include <vector>
 
+// Binary metadata is stored little-endian and read back with memcpy
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#error "assetlib binary metadata assumes a little-endian host"
+#endif
+
 namespace assets
 {
 	enum CompressionMode : uint32_t
 	{
 		None = 0,
-		LZ4
+		LZ4,
+		LZ4HC		// Same block format as LZ4, so it decodes just as fast; only packing is slower
+	};
+
+	// Cook-time codec choice. level is the LZ4 acceleration (higher is faster and larger) or the
+	// LZ4HC compression level (3-12); 0 picks the codec's default.
+	struct PackOptions
+	{
+		CompressionMode compression{ CompressionMode::LZ4 };
+		int level{ 0 };
+	};
+
+	// Per-load checks; the hashes are XXH64 and cost little next to LZ4 decoding
+	enum VerifyFlags : uint32_t
+	{
+		VerifyNone = 0,
+		VerifyBlob = 1 << 0,		// Hash the stored (compressed) blob on load
+		VerifyContent = 1 << 1,		// Hash the unpacked payload after decompression
 	};
 
 	struct AssetFile {
 		char type[4];
 		uint32_t version;
-		std::string json;
+		std::string json;		// Format version 1 metadata; otherwise only kept for the tooling side-car
+		std::vector<char> meta;	// Binary metadata, see MetaWriter
 		std::vector<char> blob;
+		uint64_t blobHash{ 0 };		// Computed by WriteBinary, read back by LoadBinary; 0 when not stored
+		uint64_t contentHash{ 0 };	// Hash of the uncompressed payload, filled by the Pack functions
+	};
+
+	// Read-only memory mapping of a whole file
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		MappedFile(MappedFile&& other) noexcept;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+
+		bool Open(const char* path);
+		void Close();
+
+		const char* Data() const { return data; }
+		size_t Size() const { return size; }
+		bool IsOpen() const { return data != nullptr; }
+
+	private:
+		const char* data{ nullptr };
+		size_t size{ 0 };
+#ifdef _WIN32
+		void* fileHandle{ nullptr };
+		void* mappingHandle{ nullptr };
+#endif
+	};
+
+	// Zero-copy alternative to AssetFile: json and blob point straight into the mapped file,
+	// so they're only valid for as long as the view is alive
+	struct AssetView {
+		char type[4];
+		uint32_t version;
+		std::string_view json;
+		const char* meta{ nullptr };
+		size_t metaSize{ 0 };
+		const char* blob{ nullptr };
+		size_t blobSize{ 0 };
+		uint64_t blobHash{ 0 };
+		uint64_t contentHash{ 0 };	// Stable key for caches, independent of compression
+
+		MappedFile file;
+	};
+
+	// Location of an array or string inside a binary metadata section
+	struct MetaRange
+	{
+		uint32_t offset;
+		uint32_t count;		// Elements for arrays, bytes for strings
+	};
+
+	// Builds a binary metadata section: a fixed-layout POD header at offset 0, followed by the
+	// arrays and strings it references through MetaRanges. Every header starts with a uint32_t
+	// holding its own size, so fields can be appended later without breaking older files.
+	class MetaWriter
+	{
+	public:
+		explicit MetaWriter(size_t headerSize) : data(AlignUp(headerSize), 0) {}
+
+		template<typename T>
+		MetaRange AppendArray(const T* items, size_t count)
+		{
+			MetaRange range{ static_cast<uint32_t>(data.size()), static_cast<uint32_t>(count) };
+			data.resize(AlignUp(data.size() + sizeof(T) * count), 0);
+			if (count > 0)
+				std::memcpy(data.data() + range.offset, items, sizeof(T) * count);
+			return range;
+		}
+
+		MetaRange AppendString(std::string_view str)
+		{
+			return AppendArray(str.data(), str.size());
+		}
+
+		template<typename T>
+		std::vector<char> Finish(const T& header)
+		{
+			std::memcpy(data.data(), &header, sizeof(T));
+			return std::move(data);
+		}
+
+	private:
+		static size_t AlignUp(size_t size) { return (size + 7) & ~size_t(7); }
+
+		std::vector<char> data;
+	};
+
+	class MetaReader
+	{
+	public:
+		MetaReader(const char* data, size_t size) : data(data), size(size) {}
+
+		// Copies the header, zero-filling any fields newer than the file
+		template<typename T>
+		bool ReadHeader(T& header) const
+		{
+			uint32_t writtenSize = 0;
+			if (size < sizeof(uint32_t))
+				return false;
+			std::memcpy(&writtenSize, data, sizeof(uint32_t));
+			if (writtenSize > size)
+				return false;
+
+			header = {};
+			std::memcpy(&header, data, writtenSize < sizeof(T) ? writtenSize : sizeof(T));
+			return true;
+		}
+
+		template<typename T>
+		bool ReadArray(MetaRange range, std::vector<T>& out) const
+		{
+			if (static_cast<size_t>(range.offset) + sizeof(T) * range.count > size)
+				return false;
+			out.resize(range.count);
+			if (range.count > 0)
+				std::memcpy(out.data(), data + range.offset, sizeof(T) * range.count);
+			return true;
+		}
+
+		bool ReadString(MetaRange range, std::string& out) const
+		{
+			if (static_cast<size_t>(range.offset) + range.count > size)
+				return false;
+			out.assign(data + range.offset, range.count);
+			return true;
+		}
+
+	private:
+		const char* data;
+		size_t size;
+	};
+
+	uint64_t HashData(const void* data, size_t size);
+
+	// Incremental HashData, for data that's never in memory all at once
+	class StreamHash
+	{
+	public:
+		StreamHash();
+		void Update(const void* data, size_t size);
+		uint64_t Digest() const;
+
+		alignas(8) unsigned char state[96];
 	};
 
 	bool SaveBinary(const char* path, const AssetFile& file);
-	bool LoadBinary(const char* path, AssetFile& asset);
+	// Writes the json description next to the asset as <path>.json, for tooling only
+	bool SaveJsonSidecar(const char* path, const AssetFile& file);
+	void WriteBinary(std::ostream& out, const AssetFile& file);
+	bool LoadBinary(const char* path, AssetFile& asset, uint32_t verify = VerifyNone);
+	// Reads the header and metadata of the asset stored at offset in path, but leaves the blob on
+	// disk; blobOffset/blobSize locate it for callers that stream it in a piece at a time
+	bool LoadBinaryHeader(const char* path, uint64_t offset, AssetFile& asset, uint64_t& blobOffset, uint64_t& blobSize);
+	bool LoadBinaryMapped(const char* path, AssetView& asset, uint32_t verify = VerifyNone);
+	// Fills json/meta/blob of the view from an in-memory asset image, leaving view.file untouched
+	bool ParseBinary(const char* data, size_t size, AssetView& asset, uint32_t verify = VerifyNone);
 	CompressionMode ParseCompression(const char* string);
+	const char* CompressionName(CompressionMode mode);
+
+	// Worst-case output size of CompressBlock
+	int CompressBound(int sourceSize);
+	// Returns the compressed size, 0 on failure or when options.compression is None
+	int CompressBlock(const PackOptions& options, const char* source, int sourceSize, char* destination, int destinationCapacity);
 }
\ No newline at end of file
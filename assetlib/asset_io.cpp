@@ -0,0 +1,539 @@
+#include "asset_io.h"
+
+#include <iostream>
+#include <algorithm>
+#include <cerrno>
+#include "asset_archive.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define ASSET_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+#endif
+
+// Largest single read handed to the OS; bigger requests are split
+constexpr uint64_t MAX_READ_CHUNK = 1ull << 30;
+constexpr unsigned RING_ENTRIES = 64;
+
+typedef intptr_t FileHandle;
+constexpr FileHandle INVALID_FILE = -1;
+
+
+static FileHandle OpenForRead(const char* path, uint64_t& size)
+{
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return INVALID_FILE;
+
+	LARGE_INTEGER fileSize{};
+	if (!GetFileSizeEx(file, &fileSize))
+	{
+		CloseHandle(file);
+		return INVALID_FILE;
+	}
+	size = static_cast<uint64_t>(fileSize.QuadPart);
+	return reinterpret_cast<FileHandle>(file);
+#else
+	int fd = open(path, O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return INVALID_FILE;
+
+	struct stat st {};
+	if (fstat(fd, &st) != 0)
+	{
+		close(fd);
+		return INVALID_FILE;
+	}
+	size = static_cast<uint64_t>(st.st_size);
+	return fd;
+#endif
+}
+
+static void CloseFile(FileHandle file)
+{
+	if (file == INVALID_FILE)
+		return;
+#ifdef _WIN32
+	CloseHandle(reinterpret_cast<HANDLE>(file));
+#else
+	close(static_cast<int>(file));
+#endif
+}
+
+static bool ReadAt(FileHandle file, char* destination, uint64_t size, uint64_t offset)
+{
+	while (size > 0)
+	{
+		const uint64_t chunk = std::min(size, MAX_READ_CHUNK);
+#ifdef _WIN32
+		OVERLAPPED overlapped{};
+		overlapped.Offset = static_cast<DWORD>(offset);
+		overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+		DWORD bytesRead = 0;
+		if (!ReadFile(reinterpret_cast<HANDLE>(file), destination, static_cast<DWORD>(chunk), &bytesRead, &overlapped) || bytesRead == 0)
+			return false;
+#else
+		ssize_t bytesRead = pread(static_cast<int>(file), destination, static_cast<size_t>(chunk), static_cast<off_t>(offset));
+		if (bytesRead < 0 && errno == EINTR)
+			continue;
+		if (bytesRead <= 0)
+			return false;
+#endif
+		destination += bytesRead;
+		offset += bytesRead;
+		size -= bytesRead;
+	}
+	return true;
+}
+
+
+struct assets::AssetIO::Job
+{
+	AssetRead read;
+	Callback callback;
+	FileHandle file{ INVALID_FILE };
+	uint64_t bytesDone{ 0 };
+	bool readDone{ false };
+};
+
+
+#ifdef ASSET_IO_URING
+
+// Minimal io_uring driven through the raw syscalls, so there's no dependency on liburing.
+// One submitter at a time (submitMutex) and a single reaping thread.
+struct assets::AssetIO::Ring
+{
+	int fd{ -1 };
+	unsigned entries{ 0 };
+	unsigned jobs{ 0 };			// Jobs with a read outstanding, guarded by AssetIO::mutex
+
+	unsigned* sqHead{ nullptr };
+	unsigned* sqTail{ nullptr };
+	unsigned* sqMask{ nullptr };
+	unsigned* sqArray{ nullptr };
+	io_uring_sqe* sqes{ nullptr };
+
+	unsigned* cqHead{ nullptr };
+	unsigned* cqTail{ nullptr };
+	unsigned* cqMask{ nullptr };
+	io_uring_cqe* cqes{ nullptr };
+
+	void* sqRing{ MAP_FAILED };
+	size_t sqRingSize{ 0 };
+	void* cqRing{ MAP_FAILED };
+	size_t cqRingSize{ 0 };
+	size_t sqesSize{ 0 };
+
+	std::mutex submitMutex;
+
+	~Ring()
+	{
+		if (sqes != nullptr)
+			munmap(sqes, sqesSize);
+		if (cqRing != MAP_FAILED && cqRing != sqRing)
+			munmap(cqRing, cqRingSize);
+		if (sqRing != MAP_FAILED)
+			munmap(sqRing, sqRingSize);
+		if (fd >= 0)
+			close(fd);
+	}
+
+	bool Init(unsigned requestedEntries)
+	{
+		io_uring_params params{};
+		fd = static_cast<int>(syscall(__NR_io_uring_setup, requestedEntries, &params));
+		if (fd < 0)
+			return false;
+
+#ifdef IORING_FEAT_FAST_POLL
+		// Also the first kernel (5.7) where IORING_OP_READ is dependable
+		if (!(params.features & IORING_FEAT_FAST_POLL))
+			return false;
+#else
+		return false;
+#endif
+
+		entries = params.sq_entries;
+		sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+		cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+		if (params.features & IORING_FEAT_SINGLE_MMAP)
+			sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+
+		sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+		if (sqRing == MAP_FAILED)
+			return false;
+
+		if (params.features & IORING_FEAT_SINGLE_MMAP)
+			cqRing = sqRing;
+		else
+			cqRing = mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+		if (cqRing == MAP_FAILED)
+			return false;
+
+		sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+		void* sqeMap = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+		if (sqeMap == MAP_FAILED)
+			return false;
+		sqes = reinterpret_cast<io_uring_sqe*>(sqeMap);
+
+		char* sq = reinterpret_cast<char*>(sqRing);
+		sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+		sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+		sqMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+		sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+		char* cq = reinterpret_cast<char*>(cqRing);
+		cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+		cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+		cqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+		cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+		return true;
+	}
+
+	// Queues the next chunk of a job's read, or a no-op wake-up when job is null
+	bool Submit(Job* job)
+	{
+		std::lock_guard<std::mutex> lock(submitMutex);
+
+		unsigned tail = *sqTail;
+		unsigned index = tail & *sqMask;
+		io_uring_sqe* sqe = &sqes[index];
+		std::memset(sqe, 0, sizeof(*sqe));
+
+		if (job != nullptr)
+		{
+			sqe->opcode = IORING_OP_READ;
+			sqe->fd = static_cast<int>(job->file);
+			sqe->addr = reinterpret_cast<uint64_t>(job->read.data.data() + job->bytesDone);
+			sqe->len = static_cast<uint32_t>(std::min(job->read.size - job->bytesDone, MAX_READ_CHUNK));
+			sqe->off = job->read.offset + job->bytesDone;
+		}
+		else
+		{
+			sqe->opcode = IORING_OP_NOP;
+		}
+		sqe->user_data = reinterpret_cast<uint64_t>(job);
+
+		sqArray[index] = index;
+		__atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+
+		for (;;)
+		{
+			long submitted = syscall(__NR_io_uring_enter, fd, 1, 0, 0, nullptr, 0);
+			if (submitted >= 0)
+				return true;
+			if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+				return false;
+		}
+	}
+
+	bool WaitForCompletion()
+	{
+		long result = syscall(__NR_io_uring_enter, fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+		return result >= 0 || errno == EINTR;
+	}
+};
+
+#else
+
+struct assets::AssetIO::Ring
+{
+	bool Init(unsigned) { return false; }
+};
+
+#endif
+
+
+assets::AssetIO::~AssetIO()
+{
+	Stop();
+}
+
+bool assets::AssetIO::Start(uint32_t workerCount, size_t maxBytes)
+{
+	Stop();
+
+	if (workerCount == 0)
+		workerCount = std::max(1u, std::thread::hardware_concurrency());
+
+	maxBytesInFlight = maxBytes;
+
+	ring = new Ring;
+	if (!ring->Init(RING_ENTRIES))
+	{
+		delete ring;
+		ring = nullptr;
+	}
+
+#ifdef ASSET_IO_URING
+	if (ring != nullptr)
+		ringThread = std::thread(&AssetIO::RingLoop, this);
+#endif
+
+	for (uint32_t i = 0; i < workerCount; ++i)
+		workers.emplace_back(&AssetIO::WorkerLoop, this);
+
+	return true;
+}
+
+void assets::AssetIO::Stop()
+{
+	if (!IsRunning())
+		return;
+
+	WaitIdle();
+
+#ifdef ASSET_IO_URING
+	if (ring != nullptr)
+	{
+		// A null job tells the reaping thread to exit
+		ring->Submit(nullptr);
+		ringThread.join();
+	}
+#endif
+	delete ring;
+	ring = nullptr;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	workAvailable.notify_all();
+
+	for (auto& worker : workers)
+		worker.join();
+	workers.clear();
+
+	stopping = false;
+}
+
+bool assets::AssetIO::Request(const char* path, Callback callback)
+{
+	return Submit(path, 0, 0, true, std::move(callback));
+}
+
+bool assets::AssetIO::Request(const ArchiveReader& archive, const ArchiveEntry* entry, Callback callback)
+{
+	if (entry == nullptr)
+		return false;
+
+	return Submit(archive.GetPath(), entry->offset, entry->size, false, std::move(callback));
+}
+
+bool assets::AssetIO::Request(const char* path, uint64_t offset, uint64_t size, Callback callback)
+{
+	return Submit(path, offset, size, false, std::move(callback));
+}
+
+void assets::AssetIO::WaitIdle()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	jobFinished.wait(lock, [this]() { return pendingJobs == 0; });
+}
+
+bool assets::AssetIO::Submit(const std::string& path, uint64_t offset, uint64_t size, bool wholeFile, Callback&& callback)
+{
+	if (!IsRunning())
+	{
+		std::cout << "ERROR: AssetIO: request before Start: " << path << std::endl;
+		return false;
+	}
+
+	uint64_t fileSize = 0;
+	FileHandle file = OpenForRead(path.c_str(), fileSize);
+	if (file == INVALID_FILE)
+	{
+		std::cout << "ERROR: AssetIO: failed to open: " << path << std::endl;
+		return false;
+	}
+
+	if (wholeFile)
+		size = fileSize;
+
+	if (offset + size > fileSize)
+	{
+		std::cout << "ERROR: AssetIO: read past end of file: " << path << std::endl;
+		CloseFile(file);
+		return false;
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		jobFinished.wait(lock, [&]()
+			{
+#ifdef ASSET_IO_URING
+				if (ring != nullptr && ring->jobs >= ring->entries)
+					return false;
+#endif
+				return bytesInFlight == 0 || bytesInFlight + size <= maxBytesInFlight;
+			});
+		bytesInFlight += size;
+		++pendingJobs;
+#ifdef ASSET_IO_URING
+		if (ring != nullptr)
+			++ring->jobs;
+#endif
+	}
+
+	Job* job = new Job;
+	job->read.path = path;
+	job->read.offset = offset;
+	job->read.size = size;
+	job->read.data.resize(size);
+	job->callback = std::move(callback);
+	job->file = file;
+
+#ifdef ASSET_IO_URING
+	if (ring != nullptr && size > 0)
+	{
+		if (!ring->Submit(job))
+		{
+			std::cout << "ERROR: AssetIO: io_uring submit failed: " << path << std::endl;
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				--ring->jobs;
+			}
+			job->readDone = true;
+		}
+		else
+		{
+			return true;
+		}
+	}
+	else if (ring != nullptr)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		--ring->jobs;
+		job->read.ok = true;
+		job->readDone = true;
+	}
+#endif
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		queue.push_back(job);
+	}
+	workAvailable.notify_one();
+
+	return true;
+}
+
+void assets::AssetIO::WorkerLoop()
+{
+	for (;;)
+	{
+		Job* job = nullptr;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			workAvailable.wait(lock, [this]() { return stopping || !queue.empty(); });
+			if (queue.empty())
+				return;
+			job = queue.front();
+			queue.pop_front();
+		}
+
+		if (!job->readDone)
+		{
+			job->read.ok = ReadAt(job->file, job->read.data.data(), job->read.size, job->read.offset);
+			job->readDone = true;
+		}
+
+		Finish(job);
+	}
+}
+
+void assets::AssetIO::RingLoop()
+{
+#ifdef ASSET_IO_URING
+	bool exitRequested = false;
+	while (!exitRequested)
+	{
+		if (!ring->WaitForCompletion())
+		{
+			std::cout << "ERROR: AssetIO: io_uring wait failed (" << errno << ")" << std::endl;
+			continue;
+		}
+
+		unsigned head = *ring->cqHead;
+		const unsigned tail = __atomic_load_n(ring->cqTail, __ATOMIC_ACQUIRE);
+
+		std::vector<Job*> completed;
+		for (; head != tail; ++head)
+		{
+			const io_uring_cqe& cqe = ring->cqes[head & *ring->cqMask];
+			Job* job = reinterpret_cast<Job*>(cqe.user_data);
+			if (job == nullptr)
+			{
+				exitRequested = true;
+				continue;
+			}
+
+			if (cqe.res > 0)
+				job->bytesDone += static_cast<uint64_t>(cqe.res);
+
+			const bool failed = cqe.res <= 0;
+			if (!failed && job->bytesDone < job->read.size)
+			{
+				// Short read, queue the rest
+				if (ring->Submit(job))
+					continue;
+			}
+
+			job->read.ok = !failed && job->bytesDone == job->read.size;
+			job->readDone = true;
+			completed.push_back(job);
+		}
+		__atomic_store_n(ring->cqHead, head, __ATOMIC_RELEASE);
+
+		if (!completed.empty())
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				ring->jobs -= static_cast<unsigned>(completed.size());
+				queue.insert(queue.end(), completed.begin(), completed.end());
+			}
+			// Ring slots were freed as well as work queued
+			jobFinished.notify_all();
+			workAvailable.notify_all();
+		}
+	}
+#endif
+}
+
+void assets::AssetIO::Finish(Job* job)
+{
+	CloseFile(job->file);
+	job->file = INVALID_FILE;
+
+	if (!job->read.ok)
+		std::cout << "ERROR: AssetIO: read failed: " << job->read.path << std::endl;
+
+	if (job->callback)
+		job->callback(job->read);
+
+	const uint64_t size = job->read.size;
+	delete job;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		bytesInFlight -= size;
+		--pendingJobs;
+	}
+	jobFinished.notify_all();
+}
\ No newline at end of file
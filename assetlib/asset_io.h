@@ -0,0 +1,82 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "asset_core.h"
+
+namespace assets
+{
+	struct ArchiveEntry;
+	class ArchiveReader;
+
+	struct AssetRead
+	{
+		std::string path;
+		uint64_t offset{ 0 };
+		uint64_t size{ 0 };
+		std::vector<char> data;
+		bool ok{ false };
+	};
+
+	// Background reads of whole asset files or archive entries. On Linux reads go through io_uring
+	// when the kernel allows it, otherwise a pool of workers does blocking positional reads.
+	// Callbacks always run on a worker thread, so they can parse and decompress; anything that has
+	// to happen on the caller's thread (GPU uploads) should be queued back from there.
+	class AssetIO
+	{
+	public:
+		using Callback = std::function<void(AssetRead& read)>;
+
+		static constexpr size_t DEFAULT_MAX_BYTES_IN_FLIGHT = 64ull * 1024 * 1024;
+
+		AssetIO() = default;
+		~AssetIO();
+
+		AssetIO(const AssetIO&) = delete;
+		AssetIO& operator=(const AssetIO&) = delete;
+
+		// workerCount 0 uses one worker per hardware thread
+		bool Start(uint32_t workerCount = 0, size_t maxBytesInFlight = DEFAULT_MAX_BYTES_IN_FLIGHT);
+		// Waits for outstanding requests, then shuts the workers down
+		void Stop();
+
+		// Blocks while the in-flight budget is used up, so don't call it from inside a callback.
+		// A single read larger than the budget is still allowed once nothing else is in flight.
+		bool Request(const char* path, Callback callback);
+		bool Request(const ArchiveReader& archive, const ArchiveEntry* entry, Callback callback);
+		// Just size bytes at offset, for part of an asset such as a run of texture mips
+		bool Request(const char* path, uint64_t offset, uint64_t size, Callback callback);
+
+		void WaitIdle();
+
+		bool IsRunning() const { return !workers.empty(); }
+		bool UsingIoUring() const { return ring != nullptr; }
+
+	private:
+		struct Job;
+		struct Ring;
+
+		bool Submit(const std::string& path, uint64_t offset, uint64_t size, bool wholeFile, Callback&& callback);
+		void WorkerLoop();
+		void RingLoop();
+		void Finish(Job* job);
+
+		std::vector<std::thread> workers;
+		std::thread ringThread;
+		Ring* ring{ nullptr };
+
+		std::mutex mutex;
+		std::condition_variable workAvailable;
+		std::condition_variable jobFinished;
+		std::deque<Job*> queue;
+		size_t maxBytesInFlight{ 0 };
+		size_t bytesInFlight{ 0 };
+		size_t pendingJobs{ 0 };
+		bool stopping{ false };
+	};
+}
\ No newline at end of file
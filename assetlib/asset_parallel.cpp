@@ -0,0 +1,38 @@
+#include "asset_parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+
+void assets::ParallelFor(size_t count, const std::function<void(size_t index)>& func, uint32_t maxThreads)
+{
+	if (maxThreads == 0)
+		maxThreads = std::thread::hardware_concurrency();
+
+	const size_t threadCount = std::min<size_t>(count, maxThreads);
+	if (threadCount <= 1)
+	{
+		for (size_t i = 0; i < count; ++i)
+			func(i);
+		return;
+	}
+
+	std::atomic<size_t> next{ 0 };
+	auto worker = [&]()
+	{
+		for (size_t i = next++; i < count; i = next++)
+			func(i);
+	};
+
+	std::vector<std::thread> threads;
+	threads.reserve(threadCount - 1);
+	for (size_t t = 1; t < threadCount; ++t)
+		threads.emplace_back(worker);
+
+	worker();
+
+	for (auto& thread : threads)
+		thread.join();
+}
\ No newline at end of file
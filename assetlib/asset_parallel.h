@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace assets
+{
+	// Runs func(i) for every i in [0, count) across up to maxThreads threads (0 = one per hardware
+	// thread), including the calling one, and returns once all of them are done. Items are handed
+	// out one at a time, so uneven work still balances.
+	void ParallelFor(size_t count, const std::function<void(size_t index)>& func, uint32_t maxThreads = 0);
+}
\ No newline at end of file
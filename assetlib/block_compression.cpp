@@ -0,0 +1,565 @@
+#include "block_compression.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "asset_parallel.h"
+
+
+namespace
+{
+	constexpr int BLOCK_TEXELS = 16;
+
+	// Least squares passes after the principal axis fit; later ones rarely find anything
+	constexpr int REFINE_PASSES = 2;
+
+	// BC7 4-bit index interpolation weights, out of 64
+	constexpr int BC7_WEIGHTS[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+	// Direction of greatest variance through the block's colours in the first N channels, found by
+	// power iteration from the covariance column with the most variance
+	template<int N>
+	void PrincipalAxis(const float points[BLOCK_TEXELS][4], float mean[4], float axis[4])
+	{
+		for (int c = 0; c < N; ++c)
+		{
+			mean[c] = 0.0f;
+			for (int i = 0; i < BLOCK_TEXELS; ++i)
+				mean[c] += points[i][c];
+			mean[c] /= BLOCK_TEXELS;
+		}
+
+		float covariance[N][N] = {};
+		for (int i = 0; i < BLOCK_TEXELS; ++i)
+		{
+			float d[N];
+			for (int c = 0; c < N; ++c)
+				d[c] = points[i][c] - mean[c];
+			for (int a = 0; a < N; ++a)
+			{
+				for (int b = 0; b < N; ++b)
+					covariance[a][b] += d[a] * d[b];
+			}
+		}
+
+		int largest = 0;
+		for (int c = 1; c < N; ++c)
+		{
+			if (covariance[c][c] > covariance[largest][largest])
+				largest = c;
+		}
+
+		float v[N];
+		for (int c = 0; c < N; ++c)
+			v[c] = covariance[largest][c];
+
+		for (int iteration = 0; iteration < 8; ++iteration)
+		{
+			float next[N] = {};
+			float scale = 0.0f;
+			for (int a = 0; a < N; ++a)
+			{
+				for (int b = 0; b < N; ++b)
+					next[a] += covariance[a][b] * v[b];
+				scale = std::max(scale, std::fabs(next[a]));
+			}
+			if (scale == 0.0f)
+				break;
+			for (int c = 0; c < N; ++c)
+				v[c] = next[c] / scale;
+		}
+
+		float length = 0.0f;
+		for (int c = 0; c < N; ++c)
+			length += v[c] * v[c];
+		length = std::sqrt(length);
+		for (int c = 0; c < N; ++c)
+			axis[c] = (length > 0.0f) ? v[c] / length : 0.0f;
+	}
+
+	// The two ends of the block's projection onto axis, a at the high end
+	template<int N>
+	void AxisEndpoints(const float points[BLOCK_TEXELS][4], const float mean[4], const float axis[4], float a[4], float b[4])
+	{
+		float minT = 0.0f;
+		float maxT = 0.0f;
+		for (int i = 0; i < BLOCK_TEXELS; ++i)
+		{
+			float t = 0.0f;
+			for (int c = 0; c < N; ++c)
+				t += (points[i][c] - mean[c]) * axis[c];
+			minT = std::min(minT, t);
+			maxT = std::max(maxT, t);
+		}
+
+		for (int c = 0; c < N; ++c)
+		{
+			a[c] = mean[c] + axis[c] * maxT;
+			b[c] = mean[c] + axis[c] * minT;
+		}
+	}
+
+	// Best endpoints for fixed indices, each texel being weight * a + (1 - weight) * b. Fails when
+	// every texel has the same weight, since then any pair through that point fits.
+	template<int N>
+	bool LeastSquaresEndpoints(const float points[BLOCK_TEXELS][4], const float weights[BLOCK_TEXELS], float a[4], float b[4])
+	{
+		float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+		float ax[N] = {}, bx[N] = {};
+		for (int i = 0; i < BLOCK_TEXELS; ++i)
+		{
+			const float wa = weights[i];
+			const float wb = 1.0f - wa;
+			aa += wa * wa;
+			ab += wa * wb;
+			bb += wb * wb;
+			for (int c = 0; c < N; ++c)
+			{
+				ax[c] += wa * points[i][c];
+				bx[c] += wb * points[i][c];
+			}
+		}
+
+		const float determinant = aa * bb - ab * ab;
+		if (std::fabs(determinant) < 1e-6f)
+			return false;
+
+		for (int c = 0; c < N; ++c)
+		{
+			a[c] = (bb * ax[c] - ab * bx[c]) / determinant;
+			b[c] = (aa * bx[c] - ab * ax[c]) / determinant;
+		}
+		return true;
+	}
+
+	int Quantize(float value, int maxValue, float scale)
+	{
+		return std::clamp(static_cast<int>(value * scale + 0.5f), 0, maxValue);
+	}
+
+	uint16_t PackColor565(const float color[4])
+	{
+		return static_cast<uint16_t>((Quantize(color[0], 31, 31.0f / 255.0f) << 11) | (Quantize(color[1], 63, 63.0f / 255.0f) << 5)
+			| Quantize(color[2], 31, 31.0f / 255.0f));
+	}
+
+	void UnpackColor565(uint16_t packed, int color[3])
+	{
+		const int r = (packed >> 11) & 31;
+		const int g = (packed >> 5) & 63;
+		const int b = packed & 31;
+		color[0] = (r << 3) | (r >> 2);
+		color[1] = (g << 2) | (g >> 4);
+		color[2] = (b << 3) | (b >> 2);
+	}
+
+	// Nearest of the four-colour palette for each texel, returning the total squared error
+	uint32_t FitColorIndices(const uint8_t texels[BLOCK_TEXELS][4], uint16_t color0, uint16_t color1, uint8_t indices[BLOCK_TEXELS])
+	{
+		int palette[4][3];
+		UnpackColor565(color0, palette[0]);
+		UnpackColor565(color1, palette[1]);
+		for (int c = 0; c < 3; ++c)
+		{
+			palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+			palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+		}
+
+		uint32_t total = 0;
+		for (int i = 0; i < BLOCK_TEXELS; ++i)
+		{
+			uint32_t best = ~0u;
+			for (uint8_t k = 0; k < 4; ++k)
+			{
+				uint32_t error = 0;
+				for (int c = 0; c < 3; ++c)
+				{
+					const int d = texels[i][c] - palette[k][c];
+					error += static_cast<uint32_t>(d * d);
+				}
+				if (error < best)
+				{
+					best = error;
+					indices[i] = k;
+				}
+			}
+			total += best;
+		}
+		return total;
+	}
+
+	// BC1 block, always in four-colour mode so it can also be BC3's colour half
+	void EncodeColorBlock(const uint8_t texels[BLOCK_TEXELS][4], uint8_t* block)
+	{
+		constexpr float INDEX_WEIGHTS[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+
+		float points[BLOCK_TEXELS][4];
+		for (int i = 0; i < BLOCK_TEXELS; ++i)
+		{
+			for (int c = 0; c < 4; ++c)
+				points[i][c] = texels[i][c];
+		}
+
+		float mean[4], axis[4], a[4], b[4];
+		PrincipalAxis<3>(points, mean, axis);
+		AxisEndpoints<3>(points, mean, axis, a, b);
+
+		uint16_t color0 = 0, color1 = 0;
+		uint8_t indices[BLOCK_TEXELS];
+		uint32_t bestError = ~0u;
+		for (int pass = 0; pass <= REFINE_PASSES; ++pass)
+		{
+			const uint16_t packed0 = PackColor565(a);
+			const uint16_t packed1 = PackColor565(b);
+			uint8_t fitted[BLOCK_TEXELS];
+			const uint32_t error = FitColorIndices(texels, packed0, packed1, fitted);
+			if (error < bestError)
+			{
+				bestError = error;
+				color0 = packed0;
+				color1 = packed1;
+				std::memcpy(indices, fitted, sizeof(indices));
+			}
+			if (error == 0)
+				break;
+
+			float weights[BLOCK_TEXELS];
+			for (int i = 0; i < BLOCK_TEXELS; ++i)
+				weights[i] = INDEX_WEIGHTS[fitted[i]];
+			if (!LeastSquaresEndpoints<3>(points, weights, a, b))
+				break;
+		}
+
+		// color0 <= color1 would select the three-colour mode with transparent black; swapping the
+		// endpoints swaps indices 0/1 and 2/3
+		if (color0 < color1)
+		{
+			std::swap(color0, color1);
+			for (auto& index : indices)
+				index ^= 1;
+		}
+		else if (color0 == color1)
+		{
+			std::memset(indices, 0, sizeof(indices));
+		}
+
+		uint32_t bits = 0;
+		for (int i = 0; i < BLOCK_TEXELS; ++i)
+			bits |= static_cast<uint32_t>(indices[i]) << (i * 2);
+
+		block[0] = static_cast<uint8_t>(color0);
+		block[1] = static_cast<uint8_t>(color0 >> 8);
+		block[2] = static_cast<uint8_t>(color1);
+		block[3] = static_cast<uint8_t>(color1 >> 8);
+		for (int k = 0; k < 4; ++k)
+			block[4 + k] = static_cast<uint8_t>(bits >> (k * 8));
+	}
+
+	// Nearest BC4 palette entry for each value; value0 > value1 selects eight interpolated values,
+	// otherwise six plus 0 and 255
+	uint32_t FitChannelIndices(const uint8_t values[BLOCK_TEXELS], int value0, int value1, uint8_t indices[BLOCK_TEXELS])
+	{
+		int palette[8] = { value0, value1 };
+		if (value0 > value1)
+		{
+			for (int k = 1; k < 7; ++k)
+				palette[k + 1] = ((7 - k) * value0 + k * value1 + 3) / 7;
+		}
+		else
+		{
+			for (int k = 1; k < 5; ++k)
+				palette[k + 1] = ((5 - k) * value0 + k * value1 + 2) / 5;
+			palette[6] = 0;
+			palette[7] = 255;
+		}
+
+		uint32_t total = 0;
+		for (int i = 0; i < BLOCK_TEXELS; ++i)
+		{
+			uint32_t best = ~0u;
+			for (uint8_t k = 0; k < 8; ++k)
+			{
+				const int d = values[i] - palette[k];
+				const uint32_t error = static_cast<uint32_t>(d * d);
+				if (error < best)
+				{
+					best = error;
+					indices[i] = k;
+				}
+			}
+			total += best;
+		}
+		return total;
+	}
+
+	// BC4 block. Tries the eight-value mode across the whole range, refined like the colour
+	// endpoints, and the six-value mode across the values other than 0 and 255, which it can
+	// represent exactly.
+	void EncodeChannelBlock(const uint8_t values[BLOCK_TEXELS], uint8_t* block)
+	{
+		constexpr float INDEX_WEIGHTS[8] = { 1.0f, 0.0f, 6.0f / 7.0f, 5.0f / 7.0f, 4.0f / 7.0f, 3.0f / 7.0f, 2.0f / 7.0f, 1.0f / 7.0f };
+
+		int minValue = 255, maxValue = 0;
+		int minInner = 255, maxInner = 0;
+		for (int i = 0; i < BLOCK_TEXELS; ++i)
+		{
+			minValue = std::min<int>(minValue, values[i]);
+			maxValue = std::max<int>(maxValue, values[i]);
+			if (values[i] != 0 && values[i] != 255)
+			{
+				minInner = std::min<int>(minInner, values[i]);
+				maxInner = std::max<int>(maxInner, values[i]);
+			}
+		}
+		if (minInner > maxInner)
+			minInner = maxInner = 0;
+
+		uint8_t indices[BLOCK_TEXELS];
+		int value0 = minInner, value1 = maxInner;
+		uint32_t bestError = FitChannelIndices(values, value0, value1, indices);
+
+		if (maxValue > minValue && bestError > 0)
+		{
+			float points[BLOCK_TEXELS][4];
+			for (int i = 0; i < BLOCK_TEXELS; ++i)
+				points[i][0] = values[i];
+
+			float a[4] = { static_cast<float>(maxValue) }, b[4] = { static_cast<float>(minValue) };
+			for (int pass = 0; pass <= REFINE_PASSES; ++pass)
+			{
+				const int high = Quantize(a[0], 255, 1.0f);
+				const int low = Quantize(b[0], 255, 1.0f);
+				if (high <= low)
+					break;
+
+				uint8_t fitted[BLOCK_TEXELS];
+				const uint32_t error = FitChannelIndices(values, high, low, fitted);
+				if (error < bestError)
+				{
+					bestError = error;
+					value0 = high;
+					value1 = low;
+					std::memcpy(indices, fitted, sizeof(indices));
+				}
+				if (error == 0)
+					break;
+
+				float weights[BLOCK_TEXELS];
+				for (int i = 0; i < BLOCK_TEXELS; ++i)
+					weights[i] = INDEX_WEIGHTS[fitted[i]];
+				if (!LeastSquaresEndpoints<1>(points, weights, a, b))
+					break;
+			}
+		}
+
+		uint64_t bits = 0;
+		for (int i = 0; i < BLOCK_TEXELS; ++i)
+			bits |= static_cast<uint64_t>(indices[i]) << (i * 3);
+
+		block[0] = static_cast<uint8_t>(value0);
+		block[1] = static_cast<uint8_t>(value1);
+		for (int k = 0; k < 6; ++k)
+			block[2 + k] = static_cast<uint8_t>(bits >> (k * 8));
+	}
+
+	// A mode 6 endpoint: 7 bits per channel plus a shared low bit, picked for the smaller error
+	struct Bc7Endpoint
+	{
+		int values[4];	// 7-bit
+		int pbit;
+		int expanded[4];	// values << 1 | pbit
+	};
+
+	Bc7Endpoint QuantizeBc7Endpoint(const float color[4])
+	{
+		Bc7Endpoint best{};
+		float bestError = -1.0f;
+		for (int pbit = 0; pbit < 2; ++pbit)
+		{
+			Bc7Endpoint endpoint{};
+			endpoint.pbit = pbit;
+			float error = 0.0f;
+			for (int c = 0; c < 4; ++c)
+			{
+				endpoint.values[c] = Quantize((color[c] - pbit) * 0.5f, 127, 1.0f);
+				endpoint.expanded[c] = (endpoint.values[c] << 1) | pbit;
+				const float d = endpoint.expanded[c] - color[c];
+				error += d * d;
+			}
+			if (bestError < 0.0f || error < bestError)
+			{
+				bestError = error;
+				best = endpoint;
+			}
+		}
+		return best;
+	}
+
+	uint32_t FitBc7Indices(const uint8_t texels[BLOCK_TEXELS][4], const Bc7Endpoint& endpoint0, const Bc7Endpoint& endpoint1, uint8_t indices[BLOCK_TEXELS])
+	{
+		int palette[16][4];
+		for (int k = 0; k < 16; ++k)
+		{
+			for (int c = 0; c < 4; ++c)
+				palette[k][c] = ((64 - BC7_WEIGHTS[k]) * endpoint0.expanded[c] + BC7_WEIGHTS[k] * endpoint1.expanded[c] + 32) >> 6;
+		}
+
+		uint32_t total = 0;
+		for (int i = 0; i < BLOCK_TEXELS; ++i)
+		{
+			uint32_t best = ~0u;
+			for (uint8_t k = 0; k < 16; ++k)
+			{
+				uint32_t error = 0;
+				for (int c = 0; c < 4; ++c)
+				{
+					const int d = texels[i][c] - palette[k][c];
+					error += static_cast<uint32_t>(d * d);
+				}
+				if (error < best)
+				{
+					best = error;
+					indices[i] = k;
+				}
+			}
+			total += best;
+		}
+		return total;
+	}
+
+	struct BitWriter
+	{
+		uint8_t* data;
+		uint32_t position{ 0 };
+
+		void Write(uint32_t value, uint32_t count)
+		{
+			for (uint32_t i = 0; i < count; ++i, ++position)
+				data[position >> 3] |= static_cast<uint8_t>(((value >> i) & 1) << (position & 7));
+		}
+	};
+
+	// BC7 mode 6 block
+	void EncodeBc7Block(const uint8_t texels[BLOCK_TEXELS][4], uint8_t* block)
+	{
+		float points[BLOCK_TEXELS][4];
+		for (int i = 0; i < BLOCK_TEXELS; ++i)
+		{
+			for (int c = 0; c < 4; ++c)
+				points[i][c] = texels[i][c];
+		}
+
+		float mean[4], axis[4], a[4], b[4];
+		PrincipalAxis<4>(points, mean, axis);
+		AxisEndpoints<4>(points, mean, axis, a, b);
+
+		Bc7Endpoint endpoint0{}, endpoint1{};
+		uint8_t indices[BLOCK_TEXELS];
+		uint32_t bestError = ~0u;
+		for (int pass = 0; pass <= REFINE_PASSES; ++pass)
+		{
+			const Bc7Endpoint quantized0 = QuantizeBc7Endpoint(a);
+			const Bc7Endpoint quantized1 = QuantizeBc7Endpoint(b);
+			uint8_t fitted[BLOCK_TEXELS];
+			const uint32_t error = FitBc7Indices(texels, quantized0, quantized1, fitted);
+			if (error < bestError)
+			{
+				bestError = error;
+				endpoint0 = quantized0;
+				endpoint1 = quantized1;
+				std::memcpy(indices, fitted, sizeof(indices));
+			}
+			if (error == 0)
+				break;
+
+			float weights[BLOCK_TEXELS];
+			for (int i = 0; i < BLOCK_TEXELS; ++i)
+				weights[i] = (64 - BC7_WEIGHTS[fitted[i]]) / 64.0f;
+			if (!LeastSquaresEndpoints<4>(points, weights, a, b))
+				break;
+		}
+
+		// The first index is stored without its top bit, which swapping the endpoints clears
+		if (indices[0] & 8)
+		{
+			std::swap(endpoint0, endpoint1);
+			for (auto& index : indices)
+				index = 15 - index;
+		}
+
+		std::memset(block, 0, 16);
+		BitWriter writer{ block };
+		writer.Write(1 << 6, 7);
+		for (int c = 0; c < 4; ++c)
+		{
+			writer.Write(endpoint0.values[c], 7);
+			writer.Write(endpoint1.values[c], 7);
+		}
+		writer.Write(endpoint0.pbit, 1);
+		writer.Write(endpoint1.pbit, 1);
+		writer.Write(indices[0], 3);
+		for (int i = 1; i < BLOCK_TEXELS; ++i)
+			writer.Write(indices[i], 4);
+	}
+}
+
+
+void assets::CompressTextureBlocks(TextureFormat format, const uint8_t* pixels, uint32_t width, uint32_t height, void* destination)
+{
+	if (!IsBlockCompressed(format))
+	{
+		std::memcpy(destination, pixels, GetTextureMipSize(format, width, height));
+		return;
+	}
+
+	const uint32_t blocksWide = (width + 3) / 4;
+	const uint32_t blockBytes = GetTextureBlockBytes(format);
+	uint8_t* output = reinterpret_cast<uint8_t*>(destination);
+
+	ParallelFor(GetTextureBlockRows(format, height), [&](size_t blockRow)
+		{
+			uint8_t texels[BLOCK_TEXELS][4];
+			uint8_t channel[BLOCK_TEXELS];
+
+			for (uint32_t blockColumn = 0; blockColumn < blocksWide; ++blockColumn)
+			{
+				for (uint32_t y = 0; y < 4; ++y)
+				{
+					const uint32_t row = std::min(static_cast<uint32_t>(blockRow) * 4 + y, height - 1);
+					for (uint32_t x = 0; x < 4; ++x)
+					{
+						const uint32_t column = std::min(blockColumn * 4 + x, width - 1);
+						std::memcpy(texels[y * 4 + x], pixels + (static_cast<size_t>(row) * width + column) * 4, 4);
+					}
+				}
+
+				uint8_t* block = output + (blockRow * blocksWide + blockColumn) * blockBytes;
+				switch (format)
+				{
+				case TextureFormat::BC1:
+					EncodeColorBlock(texels, block);
+					break;
+				case TextureFormat::BC3:
+					for (int i = 0; i < BLOCK_TEXELS; ++i)
+						channel[i] = texels[i][3];
+					EncodeChannelBlock(channel, block);
+					EncodeColorBlock(texels, block + 8);
+					break;
+				case TextureFormat::BC4:
+				case TextureFormat::BC5:
+					for (int c = 0; c < (format == TextureFormat::BC5 ? 2 : 1); ++c)
+					{
+						for (int i = 0; i < BLOCK_TEXELS; ++i)
+							channel[i] = texels[i][c];
+						EncodeChannelBlock(channel, block + c * 8);
+					}
+					break;
+				case TextureFormat::BC7:
+					EncodeBc7Block(texels, block);
+					break;
+				default:
+					break;
+				}
+			}
+		});
+}
\ No newline at end of file
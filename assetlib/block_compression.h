@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+#include "texture_asset.h"
+
+// CPU encoders for the BCn block formats, so the cooker doesn't depend on a vendor library. Each
+// 4x4 block fits its endpoints along the principal axis of its colours, then refines them with a
+// least squares fit to the indices they produced. BC7 uses mode 6 only (one subset, 4-bit indices,
+// RGBA endpoints), which handles smooth content and alpha well but not blocks with two distinct
+// colour groups.
+namespace assets
+{
+	// Encodes a width x height RGBA8 image with tightly packed rows into
+	// GetTextureMipSize(format, width, height) bytes, one row of blocks after another. Blocks that
+	// hang off the right or bottom edge repeat the last column or row. BC4 keeps red and BC5 red
+	// and green. Rows of blocks are spread across all cores.
+	void CompressTextureBlocks(TextureFormat format, const uint8_t* pixels, uint32_t width, uint32_t height, void* destination);
+}
\ No newline at end of file
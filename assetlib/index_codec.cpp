@@ -0,0 +1,322 @@
+#include "index_codec.h"
+
+#include <cstring>
+
+
+namespace
+{
+	constexpr uint32_t EDGE_FIFO_SIZE = 16;
+	constexpr uint32_t VERTEX_FIFO_SIZE = 16;
+	constexpr uint32_t INVALID_INDEX = ~0u;
+
+	// Codes below CODE_NO_EDGE are edge << 4 | third, with edge a FIFO position (0-14) and third:
+	constexpr uint8_t THIRD_NEXT = 0;			// The next unused vertex
+	constexpr uint8_t THIRD_FIFO_LAST = 14;		// 1-14: vertex FIFO position 0-13
+	constexpr uint8_t THIRD_EXPLICIT = 15;		// A zigzag varint delta from the last explicit index
+
+	// Triangles sharing no recent edge: the low three bits flag which of its vertices are the next
+	// unused one, the rest each take a data byte with a vertex FIFO position (0-14) or
+	// VERTEX_EXPLICIT followed by a delta.
+	constexpr uint8_t CODE_NO_EDGE = 0xf0;
+	constexpr uint8_t VERTEX_EXPLICIT = 15;
+
+	// The oldest vertex FIFO slot is never referenced, so the decoder can write it unconditionally
+	// and only advance when the vertex was really pushed
+	constexpr uint32_t VERTEX_FIFO_REFERENCES = VERTEX_FIFO_SIZE - 1;
+
+	// Coder state, identical on both sides as long as they see the same triangles
+	struct CodecState
+	{
+		uint32_t edges[EDGE_FIFO_SIZE][2];
+		uint32_t vertices[VERTEX_FIFO_SIZE];
+		uint32_t edgeOffset{ 0 };
+		uint32_t vertexOffset{ 0 };
+		uint32_t next{ 0 };
+		uint32_t last{ 0 };
+
+		CodecState()
+		{
+			memset(edges, 0xff, sizeof(edges));
+			memset(vertices, 0xff, sizeof(vertices));
+		}
+
+		// Position 0 is the most recently pushed entry
+		const uint32_t* Edge(uint32_t position) const { return edges[(edgeOffset - 1 - position) & (EDGE_FIFO_SIZE - 1)]; }
+		uint32_t Vertex(uint32_t position) const { return vertices[(vertexOffset - 1 - position) & (VERTEX_FIFO_SIZE - 1)]; }
+
+		void PushEdge(uint32_t a, uint32_t b)
+		{
+			uint32_t* edge = edges[edgeOffset & (EDGE_FIFO_SIZE - 1)];
+			edge[0] = a;
+			edge[1] = b;
+			++edgeOffset;
+		}
+
+		void PushVertex(uint32_t v)
+		{
+			vertices[vertexOffset & (VERTEX_FIFO_SIZE - 1)] = v;
+			++vertexOffset;
+		}
+
+		int FindVertex(uint32_t v, uint32_t limit) const
+		{
+			for (uint32_t i = 0; i < limit; ++i)
+			{
+				if (Vertex(i) == v)
+					return static_cast<int>(i);
+			}
+			return -1;
+		}
+	};
+
+	void WriteExplicit(std::vector<char>& data, CodecState& state, uint32_t v)
+	{
+		const int32_t delta = static_cast<int32_t>(v - state.last);
+		uint32_t zigzag = (static_cast<uint32_t>(delta) << 1) ^ static_cast<uint32_t>(delta >> 31);
+		while (zigzag >= 0x80)
+		{
+			data.push_back(static_cast<char>((zigzag & 0x7f) | 0x80));
+			zigzag >>= 7;
+		}
+		data.push_back(static_cast<char>(zigzag));
+
+		state.last = v;
+	}
+
+	bool ReadExplicit(const uint8_t*& data, const uint8_t* end, CodecState& state, uint32_t& v)
+	{
+		if (data == end)
+			return false;
+
+		uint32_t zigzag = *data++;
+		if (zigzag >= 0x80)
+		{
+			zigzag &= 0x7f;
+			for (int shift = 7; ; shift += 7)
+			{
+				if (data == end || shift > 28)
+					return false;
+
+				const uint8_t byte = *data++;
+				zigzag |= static_cast<uint32_t>(byte & 0x7f) << shift;
+				if (byte < 0x80)
+					break;
+			}
+		}
+
+		const int32_t delta = static_cast<int32_t>(zigzag >> 1) ^ -static_cast<int32_t>(zigzag & 1);
+		v = state.last + static_cast<uint32_t>(delta);
+		state.last = v;
+		return true;
+	}
+
+	template<typename T>
+	bool DecodeTriangles(const uint8_t* codes, const uint8_t* data, const uint8_t* end, T* indices, size_t triangleCount)
+	{
+		CodecState state;
+
+		for (size_t t = 0; t < triangleCount; ++t)
+		{
+			const uint8_t code = codes[t];
+			uint32_t a, b, c;
+
+			if (code < CODE_NO_EDGE)
+			{
+				// Stored edges run the other way round in the triangle that shares them
+				const uint32_t* edge = state.Edge(code >> 4);
+				a = edge[1];
+				b = edge[0];
+
+				const uint32_t third = code & 0xf;
+				if (third != THIRD_EXPLICIT)
+				{
+					// Next or FIFO without a branch; the FIFO read is harmless for THIRD_NEXT
+					const uint32_t isNext = (third == THIRD_NEXT) ? 1 : 0;
+					c = isNext ? state.next : state.Vertex(third - 1);
+					state.next += isNext;
+					state.vertices[state.vertexOffset & (VERTEX_FIFO_SIZE - 1)] = c;
+					state.vertexOffset += isNext;
+				}
+				else
+				{
+					if (!ReadExplicit(data, end, state, c))
+						return false;
+					state.PushVertex(c);
+				}
+
+				state.PushEdge(b, c);
+				state.PushEdge(c, a);
+			}
+			else
+			{
+				if (code & 0x8)
+					return false;
+
+				uint32_t triangle[3];
+				for (int k = 0; k < 3; ++k)
+				{
+					if (code & (1 << k))
+					{
+						triangle[k] = state.next++;
+						state.PushVertex(triangle[k]);
+						continue;
+					}
+
+					if (data == end)
+						return false;
+
+					const uint8_t position = *data++;
+					if (position < VERTEX_FIFO_REFERENCES)
+						triangle[k] = state.Vertex(position);
+					else if (position == VERTEX_EXPLICIT && ReadExplicit(data, end, state, triangle[k]))
+						state.PushVertex(triangle[k]);
+					else
+						return false;
+				}
+
+				a = triangle[0];
+				b = triangle[1];
+				c = triangle[2];
+
+				state.PushEdge(a, b);
+				state.PushEdge(b, c);
+				state.PushEdge(c, a);
+			}
+
+			indices[t * 3 + 0] = static_cast<T>(a);
+			indices[t * 3 + 1] = static_cast<T>(b);
+			indices[t * 3 + 2] = static_cast<T>(c);
+		}
+
+		return data == end;
+	}
+}
+
+
+void assets::EncodeIndexBlock(const void* indices, size_t indexCount, uint8_t indexSize, std::vector<char>& encoded)
+{
+	auto read = [indices, indexSize](size_t i) -> uint32_t
+	{
+		if (indexSize == sizeof(uint16_t))
+			return reinterpret_cast<const uint16_t*>(indices)[i];
+		return reinterpret_cast<const uint32_t*>(indices)[i];
+	};
+
+	const size_t triangleCount = indexCount / 3;
+	const size_t codeStart = encoded.size();
+	encoded.resize(codeStart + triangleCount);
+
+	std::vector<char> data;
+	CodecState state;
+
+	for (size_t t = 0; t < triangleCount; ++t)
+	{
+		uint32_t a = read(t * 3 + 0);
+		uint32_t b = read(t * 3 + 1);
+		uint32_t c = read(t * 3 + 2);
+
+		// Look for a recent edge in any rotation, then rotate it to the front
+		int edgePosition = -1;
+		for (uint32_t i = 0; i < EDGE_FIFO_SIZE - 1 && edgePosition < 0; ++i)
+		{
+			const uint32_t* edge = state.Edge(i);
+			if (edge[0] == b && edge[1] == a)
+				edgePosition = static_cast<int>(i);
+			else if (edge[0] == c && edge[1] == b)
+			{
+				edgePosition = static_cast<int>(i);
+				const uint32_t first = a;
+				a = b;
+				b = c;
+				c = first;
+			}
+			else if (edge[0] == a && edge[1] == c)
+			{
+				edgePosition = static_cast<int>(i);
+				const uint32_t first = a;
+				a = c;
+				c = b;
+				b = first;
+			}
+		}
+
+		uint8_t code;
+		if (edgePosition >= 0)
+		{
+			uint8_t third;
+			const int position = state.FindVertex(c, THIRD_FIFO_LAST);
+			if (c == state.next)
+			{
+				third = THIRD_NEXT;
+				++state.next;
+				state.PushVertex(c);
+			}
+			else if (position >= 0)
+			{
+				third = static_cast<uint8_t>(position + 1);
+			}
+			else
+			{
+				third = THIRD_EXPLICIT;
+				WriteExplicit(data, state, c);
+				state.PushVertex(c);
+			}
+
+			code = static_cast<uint8_t>((edgePosition << 4) | third);
+			state.PushEdge(b, c);
+			state.PushEdge(c, a);
+		}
+		else
+		{
+			code = CODE_NO_EDGE;
+			const uint32_t triangle[3] = { a, b, c };
+			for (int k = 0; k < 3; ++k)
+			{
+				const uint32_t v = triangle[k];
+				if (v == state.next)
+				{
+					code |= static_cast<uint8_t>(1 << k);
+					++state.next;
+					state.PushVertex(v);
+					continue;
+				}
+
+				const int position = state.FindVertex(v, VERTEX_FIFO_REFERENCES);
+				if (position >= 0)
+				{
+					data.push_back(static_cast<char>(position));
+				}
+				else
+				{
+					data.push_back(static_cast<char>(VERTEX_EXPLICIT));
+					WriteExplicit(data, state, v);
+					state.PushVertex(v);
+				}
+			}
+
+			state.PushEdge(a, b);
+			state.PushEdge(b, c);
+			state.PushEdge(c, a);
+		}
+
+		encoded[codeStart + t] = static_cast<char>(code);
+	}
+
+	encoded.insert(encoded.end(), data.begin(), data.end());
+}
+
+bool assets::DecodeIndexBlock(const char* encoded, size_t encodedSize, void* indices, size_t indexCount, uint8_t indexSize)
+{
+	const size_t triangleCount = indexCount / 3;
+	if (indexCount % 3 != 0 || encodedSize < triangleCount)
+		return false;
+
+	const uint8_t* codes = reinterpret_cast<const uint8_t*>(encoded);
+	const uint8_t* end = codes + encodedSize;
+
+	if (indexSize == sizeof(uint16_t))
+		return DecodeTriangles(codes, codes + triangleCount, end, reinterpret_cast<uint16_t*>(indices), triangleCount);
+	if (indexSize == sizeof(uint32_t))
+		return DecodeTriangles(codes, codes + triangleCount, end, reinterpret_cast<uint32_t*>(indices), triangleCount);
+	return false;
+}
\ No newline at end of file
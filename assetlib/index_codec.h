@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Triangle index compression in the style of meshoptimizer's index codec. Each triangle is one code
+// byte that names an edge it shares with a recent triangle and where its remaining vertex comes
+// from: the next vertex not used yet, a recently used one, or an explicit delta. Vertex buffers in
+// first-use order (OptimizeVertexFetch) make most triangles cost just their code byte, and the code
+// stream still compresses well with LZ4 afterwards.
+//
+// Triangles may come back rotated so a shared edge leads, which keeps their winding and order.
+namespace assets
+{
+	// Triangles per independently decodable block; a mesh stores each block as one chunk
+	constexpr uint32_t INDEX_BLOCK_TRIANGLES = 8192;
+
+	// Appends the encoding of indexCount indices (a multiple of 3), read as indexSize-byte values
+	void EncodeIndexBlock(const void* indices, size_t indexCount, uint8_t indexSize, std::vector<char>& encoded);
+
+	// Writes indexCount indices of indexSize bytes each. Fails on malformed input rather than
+	// reading or writing out of bounds.
+	bool DecodeIndexBlock(const char* encoded, size_t encodedSize, void* indices, size_t indexCount, uint8_t indexSize);
+}
\ No newline at end of file
@@ -1,17 +1,18 @@
 #include "material_asset.h"
+#include <iostream>
 #include "json.hpp"
 #include "lz4.h"
 
-#define MATERIAL_ASSET_VERSION 1
+#define MATERIAL_ASSET_VERSION 2
 
 using namespace assets;
 
 
-MaterialInfo assets::ReadMaterialInfo(AssetFile* asset)
+static MaterialInfo ParseMaterialInfo(std::string_view json)
 {
 	MaterialInfo info{};
 
-	nlohmann::json materialMeta = nlohmann::json::parse(asset->json);
+	nlohmann::json materialMeta = nlohmann::json::parse(json);
 	info.baseEffect = materialMeta["baseEffect"];
 
 	for (auto& [key, value] : materialMeta["textures"].items())
@@ -36,6 +37,70 @@ MaterialInfo assets::ReadMaterialInfo(AssetFile* asset)
 }
 
 
+static bool ReadStringMap(const MetaReader& reader, MetaRange range, std::unordered_map<std::string, std::string>& out)
+{
+	std::vector<MetaStringPair> pairs;
+	if (!reader.ReadArray(range, pairs))
+		return false;
+
+	std::string key;
+	for (auto& pair : pairs)
+	{
+		if (!reader.ReadString(pair.key, key) || !reader.ReadString(pair.value, out[key]))
+			return false;
+	}
+	return true;
+}
+
+
+static MaterialInfo ReadMaterialMeta(const char* data, size_t size)
+{
+	MaterialInfo info{};
+
+	MetaReader reader(data, size);
+	MaterialMeta meta;
+	if (!reader.ReadHeader(meta)
+		|| !reader.ReadString(meta.baseEffect, info.baseEffect)
+		|| !ReadStringMap(reader, meta.textures, info.textures)
+		|| !ReadStringMap(reader, meta.customProps, info.customProps))
+	{
+		std::cout << "ERROR: Material: invalid binary metadata" << std::endl;
+		return MaterialInfo{};
+	}
+
+	info.transparency = meta.transparency;
+
+	return info;
+}
+
+
+MaterialInfo assets::ReadMaterialInfo(AssetFile* asset)
+{
+	if (!asset->meta.empty())
+		return ReadMaterialMeta(asset->meta.data(), asset->meta.size());
+	return ParseMaterialInfo(asset->json);
+}
+
+
+MaterialInfo assets::ReadMaterialInfo(const AssetView* view)
+{
+	if (view->meta != nullptr)
+		return ReadMaterialMeta(view->meta, view->metaSize);
+	return ParseMaterialInfo(view->json);
+}
+
+
+static MetaRange AppendStringMap(MetaWriter& writer, const std::unordered_map<std::string, std::string>& map)
+{
+	std::vector<MetaStringPair> pairs;
+	pairs.reserve(map.size());
+	for (auto& [key, value] : map)
+		pairs.push_back({ writer.AppendString(key), writer.AppendString(value) });
+
+	return writer.AppendArray(pairs.data(), pairs.size());
+}
+
+
 AssetFile assets::PackMaterial(MaterialInfo* info)
 {
 	nlohmann::json materialMeta;
@@ -64,5 +129,15 @@ AssetFile assets::PackMaterial(MaterialInfo* info)
 	std::string stringified = materialMeta.dump();
 	asset.json = stringified;
 
+	MaterialMeta meta{};
+	meta.size = sizeof(MaterialMeta);
+	meta.transparency = info->transparency;
+
+	MetaWriter metaWriter(sizeof(MaterialMeta));
+	meta.baseEffect = metaWriter.AppendString(info->baseEffect);
+	meta.textures = AppendStringMap(metaWriter, info->textures);
+	meta.customProps = AppendStringMap(metaWriter, info->customProps);
+	asset.meta = metaWriter.Finish(meta);
+
 	return asset;
 }
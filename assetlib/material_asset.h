@@ -21,6 +21,25 @@ namespace assets
 		TransparencyMode transparency;
 	};
 
+	struct MetaStringPair
+	{
+		MetaRange key;
+		MetaRange value;
+	};
+
+	// Fixed-layout binary form of MaterialInfo, stored little-endian in the asset's metadata section
+	struct MaterialMeta
+	{
+		uint32_t size;
+		TransparencyMode transparency;
+		uint8_t padding[3];
+		MetaRange baseEffect;
+		MetaRange textures;		// MetaStringPair[]
+		MetaRange customProps;	// MetaStringPair[]
+	};
+	static_assert(sizeof(MaterialMeta) == 32, "MaterialMeta layout is part of the file format");
+
 	MaterialInfo ReadMaterialInfo(AssetFile* asset);
+	MaterialInfo ReadMaterialInfo(const AssetView* view);
 	AssetFile PackMaterial(MaterialInfo* info);
 }
\ No newline at end of file
@@ -3,16 +3,30 @@
 #include <iostream>
 #include <cstring>
 #include <vector>
+#include <atomic>
+#include <algorithm>
 #include "json.hpp"
 #include "lz4.h"
+#include "asset_parallel.h"
+#include "index_codec.h"
+#include "vertex_kernels.h"
+#define XXH_STATIC_LINKING_ONLY
+#include "xxhash.h"
 
-#define MESH_ASSET_VERSION 1
+#define MESH_ASSET_VERSION 2
 
-assets::MeshInfo assets::ReadMeshInfo(AssetFile* file)
+static bool ParseMeshInfo(std::string_view json, assets::MeshInfo& info)
 {
-	MeshInfo info;
+	using namespace assets;
 
-	nlohmann::json meshMeta = nlohmann::json::parse(file->json);
+	info = MeshInfo{};
+
+	nlohmann::json meshMeta = nlohmann::json::parse(json, nullptr, false);
+	if (meshMeta.is_discarded())
+	{
+		std::cout << "ERROR: Mesh: invalid JSON metadata" << std::endl;
+		return false;
+	}
 
 	std::string formatStr = meshMeta["format"];
 	info.vertexFormat = assets::ParseVertexFormat(formatStr.c_str());
@@ -23,11 +37,18 @@ assets::MeshInfo assets::ReadMeshInfo(AssetFile* file)
 	info.vertexBufferSize = meshMeta["vbSize"];
 	info.indexBufferSize = meshMeta["ibSize"];
 	info.indexSize = static_cast<uint8_t>(meshMeta["indexSize"]);
+	info.indexEncoding = (meshMeta.value("indexEncoding", "raw") == "triangle") ? IndexEncoding::Triangle : IndexEncoding::Raw;
+	info.vertexStreams = (meshMeta.value("vertexStreams", "interleaved") == "split") ? VertexStreams::Split : VertexStreams::Interleaved;
 	info.sourceFile = meshMeta["sourceFile"];
 
 	std::vector<float> boundsData;
 	boundsData.reserve(sizeof(MeshBounds) / sizeof(float));
 	boundsData = meshMeta["bounds"].get<std::vector<float>>();
+	if (boundsData.size() < 7)
+	{
+		std::cout << "ERROR: Mesh: invalid JSON metadata" << std::endl;
+		return false;
+	}
 	info.bounds.origin[0] = boundsData[0];
 	info.bounds.origin[1] = boundsData[1];
 	info.bounds.origin[2] = boundsData[2];
@@ -36,26 +57,280 @@ assets::MeshInfo assets::ReadMeshInfo(AssetFile* file)
 	info.bounds.extents[1] = boundsData[5];
 	info.bounds.extents[2] = boundsData[6];
 
-	return info;
+	if (meshMeta.contains("chunks"))
+	{
+		for (auto& [key, value] : meshMeta["chunks"].items())
+		{
+			MeshChunk chunk;
+			chunk.compressedSize = value["compressedSize"];
+			chunk.originalSize = value["originalSize"];
+			info.chunks.push_back(chunk);
+		}
+	}
+
+	return true;
 }
 
-void assets::UnpackMesh(MeshInfo* info, const char* sourceBuffer, size_t sourceSize, char* vertexBuffer, char* indexBuffer)
+static bool ReadMeshMeta(const char* data, size_t size, assets::MeshInfo& info)
 {
-	if (info->compressionMode == CompressionMode::LZ4)
+	using namespace assets;
+
+	info = MeshInfo{};
+
+	MetaReader reader(data, size);
+	MeshMeta meta;
+	if (!reader.ReadHeader(meta) || !reader.ReadString(meta.sourceFile, info.sourceFile) || !reader.ReadArray(meta.chunks, info.chunks)
+		|| !reader.ReadArray(meta.meshlets, info.meshlets) || !reader.ReadArray(meta.lods, info.lods))
+	{
+		std::cout << "ERROR: Mesh: invalid binary metadata" << std::endl;
+		return false;
+	}
+
+	const uint64_t indexCount = (meta.indexSize != 0) ? meta.indexBufferSize / meta.indexSize : 0;
+	for (const Meshlet& meshlet : info.meshlets)
+	{
+		if (static_cast<uint64_t>(meshlet.firstIndex) + meshlet.indexCount > indexCount)
+		{
+			std::cout << "ERROR: Mesh: meshlet outside the index buffer" << std::endl;
+			info.meshlets.clear();
+			break;
+		}
+	}
+
+	for (const MeshLod& lod : info.lods)
+	{
+		if (static_cast<uint64_t>(lod.firstIndex) + lod.indexCount > indexCount
+			|| (lod.meshletCount > 0 && static_cast<uint64_t>(lod.firstMeshlet) + lod.meshletCount > info.meshlets.size()))
+		{
+			std::cout << "ERROR: Mesh: LOD outside the index buffer or meshlet table" << std::endl;
+			info.lods.clear();
+			break;
+		}
+	}
+
+	info.vertexBufferSize = meta.vertexBufferSize;
+	info.indexBufferSize = meta.indexBufferSize;
+	info.vertexFormat = meta.vertexFormat;
+	info.bounds = meta.bounds;
+	info.indexSize = meta.indexSize;
+	info.indexEncoding = meta.indexEncoding;
+	info.vertexStreams = meta.vertexStreams;
+	info.compressionMode = meta.compressionMode;
+
+	return true;
+}
+
+// Missing or mistyped JSON fields throw, which counts as corrupt metadata too
+static bool ReadMeshInfoFrom(const char* meta, size_t metaSize, std::string_view json, assets::MeshInfo& info)
+{
+	try
+	{
+		return (meta != nullptr) ? ReadMeshMeta(meta, metaSize, info) : ParseMeshInfo(json, info);
+	}
+	catch (const nlohmann::json::exception& e)
+	{
+		std::cout << "ERROR: Mesh: invalid JSON metadata: " << e.what() << std::endl;
+		return false;
+	}
+}
+
+bool assets::ReadMeshInfo(AssetFile* file, MeshInfo& info)
+{
+	if (!ReadMeshInfoFrom(!file->meta.empty() ? file->meta.data() : nullptr, file->meta.size(), file->json, info))
+		return false;
+	info.contentHash = file->contentHash;
+	return true;
+}
+
+bool assets::ReadMeshInfo(const AssetView* view, MeshInfo& info)
+{
+	if (!ReadMeshInfoFrom(view->meta, view->metaSize, view->json, info))
+		return false;
+	info.contentHash = view->contentHash;
+	return true;
+}
+
+// Vertex data followed by index data, matching the order they're packed in
+static uint64_t HashMeshContent(const char* vertexData, size_t vertexSize, const char* indexData, size_t indexSize)
+{
+	XXH64_state_t state;
+	XXH64_reset(&state, 0);
+	XXH64_update(&state, vertexData, vertexSize);
+	XXH64_update(&state, indexData, indexSize);
+	return XXH64_digest(&state);
+}
+
+static bool UnpackMeshChunks(const assets::MeshInfo* info, const char* sourceBuffer, size_t sourceSize, char* vertexBuffer, char* indexBuffer)
+{
+	using namespace assets;
+
+	// Work out where every chunk lives in the blob and where it lands, then decode them all at once
+	struct ChunkJob
+	{
+		const char* source;
+		char* destination;
+		MeshChunk chunk;
+		uint32_t indexCount;	// Encoded index block to decode after decompression, 0 for plain data
+	};
+	std::vector<ChunkJob> jobs;
+	jobs.reserve(info->chunks.size());
+
+	const bool encodedIndices = (info->indexEncoding == IndexEncoding::Triangle);
+	if (!encodedIndices && info->indexEncoding != IndexEncoding::Raw)
+	{
+		std::cout << "ERROR: Mesh: unknown index encoding " << static_cast<int>(info->indexEncoding) << std::endl;
+		return false;
+	}
+
+	const uint64_t indexCount = (info->indexSize != 0) ? info->indexBufferSize / info->indexSize : 0;
+	const uint64_t blockIndices = static_cast<uint64_t>(INDEX_BLOCK_TRIANGLES) * 3;
+
+	uint64_t sourceOffset = 0;
+	uint64_t unpackedOffset = 0;
+	uint64_t decodedIndices = 0;
+	for (const MeshChunk& chunk : info->chunks)
+	{
+		ChunkJob job;
+		job.source = sourceBuffer + sourceOffset;
+		job.chunk = chunk;
+		job.indexCount = 0;
+		if (unpackedOffset < info->vertexBufferSize)
+		{
+			job.destination = vertexBuffer + unpackedOffset;
+			if (unpackedOffset + chunk.originalSize > info->vertexBufferSize)
+				break;
+			unpackedOffset += chunk.originalSize;
+		}
+		else if (encodedIndices)
+		{
+			// Every block but the last holds exactly INDEX_BLOCK_TRIANGLES
+			if (decodedIndices >= indexCount)
+				break;
+			job.destination = indexBuffer + decodedIndices * info->indexSize;
+			job.indexCount = static_cast<uint32_t>(std::min(blockIndices, indexCount - decodedIndices));
+			decodedIndices += job.indexCount;
+		}
+		else
+		{
+			job.destination = indexBuffer + (unpackedOffset - info->vertexBufferSize);
+			unpackedOffset += chunk.originalSize;
+		}
+		jobs.push_back(job);
+
+		sourceOffset += chunk.compressedSize;
+	}
+
+	if (encodedIndices)
+		unpackedOffset += decodedIndices * info->indexSize;
+
+	if (jobs.size() != info->chunks.size() || unpackedOffset != info->vertexBufferSize + info->indexBufferSize || sourceOffset > sourceSize)
+	{
+		std::cout << "ERROR: Mesh: chunk table doesn't match the stored data" << std::endl;
+		return false;
+	}
+
+	std::atomic<bool> failed{ false };
+	ParallelFor(jobs.size(), [&](size_t i)
+		{
+			const ChunkJob& job = jobs[i];
+			const bool stored = (job.chunk.compressedSize == job.chunk.originalSize);
+
+			if (job.indexCount == 0)
+			{
+				if (stored)
+				{
+					memcpy(job.destination, job.source, job.chunk.originalSize);
+					return;
+				}
+
+				int decompressed = LZ4_decompress_safe(job.source, job.destination, static_cast<int>(job.chunk.compressedSize), static_cast<int>(job.chunk.originalSize));
+				if (decompressed != static_cast<int>(job.chunk.originalSize))
+					failed = true;
+				return;
+			}
+
+			// Encoded indices decompress to a scratch block first, unless they were stored as-is
+			std::vector<char> scratch;
+			const char* encoded = job.source;
+			if (!stored)
+			{
+				scratch.resize(job.chunk.originalSize);
+				int decompressed = LZ4_decompress_safe(job.source, scratch.data(), static_cast<int>(job.chunk.compressedSize), static_cast<int>(job.chunk.originalSize));
+				if (decompressed != static_cast<int>(job.chunk.originalSize))
+				{
+					failed = true;
+					return;
+				}
+				encoded = scratch.data();
+			}
+
+			if (!DecodeIndexBlock(encoded, job.chunk.originalSize, job.destination, job.indexCount, info->indexSize))
+				failed = true;
+		});
+
+	if (failed)
+	{
+		std::cout << "ERROR: Mesh: chunk decode failed, data is corrupt or truncated" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+bool assets::UnpackMesh(MeshInfo* info, const char* sourceBuffer, size_t sourceSize, char* vertexBuffer, char* indexBuffer, uint32_t verify)
+{
+	if (!info->chunks.empty())
+	{
+		if (!UnpackMeshChunks(info, sourceBuffer, sourceSize, vertexBuffer, indexBuffer))
+			return false;
+	}
+	else if (info->indexEncoding != IndexEncoding::Raw)
+	{
+		std::cout << "ERROR: Mesh: encoded indices without a chunk table" << std::endl;
+		return false;
+	}
+	else if (info->compressionMode != CompressionMode::None && info->vertexBufferSize + info->indexBufferSize > 0)
 	{
+		// Files cooked before chunking hold one merged block
 		std::vector<char> decompressBuffer;
 		decompressBuffer.resize(info->vertexBufferSize + info->indexBufferSize);
-		LZ4_decompress_safe(sourceBuffer, decompressBuffer.data(), static_cast<int>(sourceSize), static_cast<int>(decompressBuffer.size()));
+		int decompressed = LZ4_decompress_safe(sourceBuffer, decompressBuffer.data(), static_cast<int>(sourceSize), static_cast<int>(decompressBuffer.size()));
+		if (decompressed != static_cast<int>(decompressBuffer.size()))
+		{
+			std::cout << "ERROR: Mesh: LZ4 decode failed (" << decompressed << "), data is corrupt or truncated" << std::endl;
+			return false;
+		}
 
 		memcpy(vertexBuffer, decompressBuffer.data(), info->vertexBufferSize);
 		memcpy(indexBuffer, decompressBuffer.data() + info->vertexBufferSize, info->indexBufferSize);
 	}
+	else
+	{
+		if (sourceSize < info->vertexBufferSize + info->indexBufferSize)
+		{
+			std::cout << "ERROR: Mesh: stored data is truncated" << std::endl;
+			return false;
+		}
+
+		memcpy(vertexBuffer, sourceBuffer, info->vertexBufferSize);
+		memcpy(indexBuffer, sourceBuffer + info->vertexBufferSize, info->indexBufferSize);
+	}
+
+	if ((verify & VerifyContent) && info->contentHash != 0)
+	{
+		if (HashMeshContent(vertexBuffer, info->vertexBufferSize, indexBuffer, info->indexBufferSize) != info->contentHash)
+		{
+			std::cout << "ERROR: Mesh: content checksum mismatch" << std::endl;
+			return false;
+		}
+	}
+
+	return true;
 }
 
-assets::AssetFile assets::PackMesh(MeshInfo* info, void* vertexData, void* indexData)
+assets::AssetFile assets::PackMesh(MeshInfo* info, void* vertexData, void* indexData, const PackOptions& options)
 {
-	constexpr CompressionMode compressMode = assets::CompressionMode::LZ4;
-	constexpr char* compressModeName = "LZ4";
+	const CompressionMode compressMode = options.compression;
 
 	const char* vertexFormat;
 	switch (info->vertexFormat)
@@ -66,16 +341,117 @@ assets::AssetFile assets::PackMesh(MeshInfo* info, void* vertexData, void* index
 	case assets::VertexFormat::PNCV_F32:
 		vertexFormat = "PNCV_F32";
 		break;
+	case assets::VertexFormat::P16N8C8V16:
+		vertexFormat = "P16N8C8V16";
+		break;
+	case assets::VertexFormat::P32N8C8V32:
+		vertexFormat = "P32N8C8V32";
+		break;
 	default:
 		vertexFormat = "unknown";
 	}
 
+	AssetFile file;
+	file.type[0] = 'M';
+	file.type[1] = 'E';
+	file.type[2] = 'S';
+	file.type[3] = 'H';
+	file.version = MESH_ASSET_VERSION;
+
+	// Index blocks are encoded independently, so they can also be decoded in parallel
+	const uint64_t indexCount = (info->indexSize != 0) ? info->indexBufferSize / info->indexSize : 0;
+	const uint64_t blockIndices = static_cast<uint64_t>(INDEX_BLOCK_TRIANGLES) * 3;
+	if (indexCount == 0 || indexCount % 3 != 0 || (info->indexSize != sizeof(uint16_t) && info->indexSize != sizeof(uint32_t)))
+		info->indexEncoding = IndexEncoding::Raw;
+
+	std::vector<std::vector<char>> indexBlocks;
+	std::vector<char> decodedIndices;
+	if (info->indexEncoding == IndexEncoding::Triangle)
+	{
+		indexBlocks.resize(static_cast<size_t>((indexCount + blockIndices - 1) / blockIndices));
+		decodedIndices.resize(info->indexBufferSize);
+
+		// Decoded straight back: the content hash covers indices as the loader returns them, rotated triangles included
+		std::atomic<bool> failed{ false };
+		ParallelFor(indexBlocks.size(), [&](size_t i)
+			{
+				const uint64_t first = i * blockIndices;
+				const size_t count = static_cast<size_t>(std::min(blockIndices, indexCount - first));
+				EncodeIndexBlock(reinterpret_cast<const char*>(indexData) + first * info->indexSize, count, info->indexSize, indexBlocks[i]);
+				if (!DecodeIndexBlock(indexBlocks[i].data(), indexBlocks[i].size(), decodedIndices.data() + first * info->indexSize, count, info->indexSize))
+					failed = true;
+			});
+
+		if (failed)
+		{
+			std::cout << "ERROR: Mesh: index encoding failed to round-trip, storing raw indices" << std::endl;
+			info->indexEncoding = IndexEncoding::Raw;
+		}
+	}
+
+	const void* storedIndices = (info->indexEncoding == IndexEncoding::Triangle) ? decodedIndices.data() : indexData;
+	file.contentHash = HashMeshContent(reinterpret_cast<const char*>(vertexData), info->vertexBufferSize, reinterpret_cast<const char*>(storedIndices), info->indexBufferSize);
+
+	// Split each stream into fixed-size chunks and compress them independently
+	struct ChunkSource
+	{
+		const char* data;
+		uint32_t size;
+	};
+	std::vector<ChunkSource> sources;
+	auto addStream = [&sources](const void* data, uint64_t size)
+	{
+		const char* bytes = reinterpret_cast<const char*>(data);
+		for (uint64_t offset = 0; offset < size; offset += MESH_CHUNK_SIZE)
+			sources.push_back({ bytes + offset, static_cast<uint32_t>(std::min<uint64_t>(MESH_CHUNK_SIZE, size - offset)) });
+	};
+	addStream(vertexData, info->vertexBufferSize);
+	if (info->indexEncoding == IndexEncoding::Triangle)
+	{
+		for (const std::vector<char>& block : indexBlocks)
+			sources.push_back({ block.data(), static_cast<uint32_t>(block.size()) });
+	}
+	else
+		addStream(indexData, info->indexBufferSize);
+
+	std::vector<std::vector<char>> compressedChunks(sources.size());
+	info->chunks.resize(sources.size());
+
+	ParallelFor(sources.size(), [&](size_t i)
+		{
+			const ChunkSource& source = sources[i];
+			std::vector<char>& compressed = compressedChunks[i];
+
+			int compressStaging = CompressBound(static_cast<int>(source.size));
+			compressed.resize(compressStaging);
+			int compressedSize = CompressBlock(options, source.data, static_cast<int>(source.size), compressed.data(), compressStaging);
+
+			// Stored as-is when uncompressed, or when it isn't worth decoding because it barely shrank
+			const float compressionRate = static_cast<float>(compressedSize) / static_cast<float>(source.size);
+			if (compressedSize <= 0 || compressionRate > 0.8f)
+				compressed.assign(source.data, source.data + source.size);
+			else
+				compressed.resize(compressedSize);
+
+			info->chunks[i].compressedSize = static_cast<uint32_t>(compressed.size());
+			info->chunks[i].originalSize = source.size;
+		});
+
+	size_t blobSize = 0;
+	for (auto& chunk : compressedChunks)
+		blobSize += chunk.size();
+	file.blob.reserve(blobSize);
+	for (auto& chunk : compressedChunks)
+		file.blob.insert(file.blob.end(), chunk.begin(), chunk.end());
+
 	nlohmann::json meshMeta;
 	meshMeta["vbSize"] = info->vertexBufferSize;
 	meshMeta["ibSize"] = info->indexBufferSize;
 	meshMeta["format"] = vertexFormat;
 	meshMeta["indexSize"] = info->indexSize;
-	meshMeta["compression"] = compressModeName;
+	meshMeta["indexEncoding"] = (info->indexEncoding == IndexEncoding::Triangle) ? "triangle" : "raw";
+	meshMeta["vertexStreams"] = (info->vertexStreams == VertexStreams::Split) ? "split" : "interleaved";
+	meshMeta["compression"] = CompressionName(compressMode);
 	meshMeta["sourceFile"] = info->sourceFile;
 
 	std::vector<float> boundsData;
@@ -89,34 +465,36 @@ assets::AssetFile assets::PackMesh(MeshInfo* info, void* vertexData, void* index
 	boundsData.push_back(info->bounds.extents[2]);
 	meshMeta["bounds"] = boundsData;
 
-	AssetFile file;
-	file.type[0] = 'M';
-	file.type[1] = 'E';
-	file.type[2] = 'S';
-	file.type[3] = 'H';
-	file.version = MESH_ASSET_VERSION;
+	std::vector<nlohmann::json> chunkJson;
+	for (auto& c : info->chunks)
+	{
+		nlohmann::json chunk;
+		chunk["compressedSize"] = c.compressedSize;
+		chunk["originalSize"] = c.originalSize;
+		chunkJson.push_back(chunk);
+	}
+	meshMeta["chunks"] = chunkJson;
 
 	file.json = meshMeta.dump();
 
+	MeshMeta meta{};
+	meta.size = sizeof(MeshMeta);
+	meta.vertexFormat = info->vertexFormat;
+	meta.vertexBufferSize = info->vertexBufferSize;
+	meta.indexBufferSize = info->indexBufferSize;
+	meta.compressionMode = compressMode;
+	meta.indexSize = info->indexSize;
+	meta.indexEncoding = info->indexEncoding;
+	meta.vertexStreams = info->vertexStreams;
+	meta.bounds = info->bounds;
+	meta.chunkSize = MESH_CHUNK_SIZE;
 
-	size_t dataSize = info->vertexBufferSize + info->indexBufferSize;
-	std::vector<char> mergedBuffer;
-	mergedBuffer.resize(dataSize);
-
-	std::memcpy(mergedBuffer.data(), vertexData, info->vertexBufferSize);
-	std::memcpy(mergedBuffer.data() + info->vertexBufferSize, indexData, info->indexBufferSize);
-
-	if (compressMode == CompressionMode::LZ4)
-	{
-		int compressStaging = LZ4_compressBound(static_cast<int>(dataSize));
-		file.blob.resize(compressStaging);
-		int compressedSize = LZ4_compress_default(mergedBuffer.data(), file.blob.data(), static_cast<int>(mergedBuffer.size()), compressStaging);
-		file.blob.resize(compressedSize);
-	}
-	else
-	{
-		std::cout << "Invalid mesh file compression mode: '" << compressModeName << "'" << std::endl;
-	}
+	MetaWriter metaWriter(sizeof(MeshMeta));
+	meta.sourceFile = metaWriter.AppendString(info->sourceFile);
+	meta.chunks = metaWriter.AppendArray(info->chunks.data(), info->chunks.size());
+	meta.meshlets = metaWriter.AppendArray(info->meshlets.data(), info->meshlets.size());
+	meta.lods = metaWriter.AppendArray(info->lods.data(), info->lods.size());
+	file.meta = metaWriter.Finish(meta);
 
 	return file;
 }
@@ -127,48 +505,48 @@ assets::VertexFormat assets::ParseVertexFormat(const char* string)
 		return assets::VertexFormat::P32N8C8V16;
 	if (strcmp(string, "PNCV_F32") == 0)
 		return assets::VertexFormat::PNCV_F32;
+	if (strcmp(string, "P16N8C8V16") == 0)
+		return assets::VertexFormat::P16N8C8V16;
+	if (strcmp(string, "P32N8C8V32") == 0)
+		return assets::VertexFormat::P32N8C8V32;
 	return assets::VertexFormat::Unknown;
 }
 
-assets::MeshBounds assets::CalculateBounds(const Vertex_PNCV_F32* verts, size_t count)
+size_t assets::GetVertexSize(VertexFormat format)
 {
-	MeshBounds bounds{};
-
-	float min[3] = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
-	float max[3] = { std::numeric_limits<float>::min(), std::numeric_limits<float>::min(), std::numeric_limits<float>::min() };
-
-	for (int i = 0; i < count; ++i)
+	switch (format)
 	{
-		min[0] = std::min(min[0], verts[i].position[0]);
-		min[1] = std::min(min[1], verts[i].position[1]);
-		min[2] = std::min(min[2], verts[i].position[2]);
-
-		max[0] = std::max(max[0], verts[i].position[0]);
-		max[1] = std::max(max[1], verts[i].position[1]);
-		max[2] = std::max(max[2], verts[i].position[2]);
+	case assets::VertexFormat::PNCV_F32:
+		return sizeof(Vertex_PNCV_F32);
+	case assets::VertexFormat::P32N8C8V16:
+		return sizeof(Vertex_P32N8C8V16);
+	case assets::VertexFormat::P16N8C8V16:
+		return sizeof(Vertex_P16N8C8V16);
+	case assets::VertexFormat::P32N8C8V32:
+		return sizeof(Vertex_P32N8C8V32);
+	default:
+		return 0;
 	}
+}
 
-	bounds.extents[0] = (max[0] - min[0]) * 0.5f;
-	bounds.extents[1] = (max[1] - min[1]) * 0.5f;
-	bounds.extents[2] = (max[2] - min[2]) * 0.5f;
-
-	bounds.origin[0] = bounds.extents[0] + min[0];
-	bounds.origin[1] = bounds.extents[1] + min[1];
-	bounds.origin[2] = bounds.extents[2] + min[2];
-
-	float rsq = 0.0f;
-	for (int i = 0; i < count; ++i)
+size_t assets::GetPositionSize(VertexFormat format)
+{
+	switch (format)
 	{
-		float offset[3] = {
-			verts[i].position[0] - bounds.origin[0],
-			verts[i].position[1] - bounds.origin[1],
-			verts[i].position[2] - bounds.origin[2]
-		};
-
-		float distsq = offset[0] * offset[0] + offset[1] * offset[1] + offset[2] * offset[2];
-		rsq = std::max(distsq, rsq);
+	case assets::VertexFormat::PNCV_F32:
+		return sizeof(Vertex_PNCV_F32::position);
+	case assets::VertexFormat::P32N8C8V16:
+		return sizeof(Vertex_P32N8C8V16::position);
+	case assets::VertexFormat::P16N8C8V16:
+		return sizeof(Vertex_P16N8C8V16::position);
+	case assets::VertexFormat::P32N8C8V32:
+		return sizeof(Vertex_P32N8C8V32::position);
+	default:
+		return 0;
 	}
-	bounds.radius = std::sqrt(rsq);
-	
-	return bounds;
 }
+
+assets::MeshBounds assets::CalculateBounds(const Vertex_PNCV_F32* verts, size_t count)
+{
+	return CalculatePositionBounds((count > 0) ? verts[0].position : nullptr, sizeof(Vertex_PNCV_F32), count);
+}
\ No newline at end of file
@@ -20,12 +20,57 @@ namespace assets
 		float uv[2];
 	};
 
+	// GPU-ready quantized layout, uploaded as-is. Positions are unorm16 across the mesh's
+	// MeshBounds box, normals octahedral-encoded, UVs half floats (precise to about 1/2048
+	// within [0, 1], so heavily tiled UVs are better off in PNCV_F32).
+	struct Vertex_P16N8C8V16
+	{
+		uint16_t position[4];	// w unused, 4-component unorm16 is always a valid vertex format
+		uint16_t uv[2];
+		uint8_t color[4];		// a unused
+		uint8_t octNormal[2];
+		uint8_t padding[2];
+	};
+	static_assert(sizeof(Vertex_P16N8C8V16) == 20, "Vertex_P16N8C8V16 layout is uploaded directly");
+
+	// Byte-for-byte the engine's Vertex, so loading is only decompression: full precision
+	// positions and UVs, octahedral-encoded normals
+	struct Vertex_P32N8C8V32
+	{
+		float position[3];
+		uint8_t octNormal[2];
+		uint8_t color[3];
+		uint8_t padding[3];
+		float uv[2];
+	};
+	static_assert(sizeof(Vertex_P32N8C8V32) == 28, "Vertex_P32N8C8V32 layout is uploaded directly");
+
 
 	enum class VertexFormat : uint32_t
 	{
 		Unknown = 0,
 		PNCV_F32,
-		P32N8C8V16
+		P32N8C8V16,
+		P16N8C8V16,
+		P32N8C8V32
+	};
+
+	// How the index stream is stored. Triangle runs it through the index codec (index_codec.h) in
+	// blocks of INDEX_BLOCK_TRIANGLES, one chunk each, before compression; UnpackMesh always
+	// returns plain indices.
+	enum class IndexEncoding : uint8_t
+	{
+		Raw = 0,
+		Triangle
+	};
+
+	// How vertices are laid out in the vertex buffer. Split stores every vertex's position first
+	// (GetPositionSize bytes each, tightly packed), then the rest of every vertex in the same order,
+	// so position-only passes can fetch just the first stream.
+	enum class VertexStreams : uint8_t
+	{
+		Interleaved = 0,
+		Split
 	};
 
 	struct MeshBounds
@@ -35,6 +80,45 @@ namespace assets
 		float extents[3];
 	};
 
+	// One level of detail: a run of the index buffer, drawn over the same vertices as the full mesh.
+	// error is how far its surface may stray from LOD 0, in mesh units.
+	struct MeshLod
+	{
+		uint32_t firstIndex;
+		uint32_t indexCount;
+		uint32_t firstMeshlet;
+		uint32_t meshletCount;
+		float error;
+	};
+
+	// A cluster of neighbouring triangles stored as one contiguous run of the index buffer, with
+	// bounds for culling below mesh granularity. Triangles all face away from a camera at p when
+	// dot(normalize(coneApex - p), coneAxis) >= coneCutoff; clusters facing too many ways to be
+	// culled like that have a zero axis and a cutoff of 1.
+	struct Meshlet
+	{
+		uint32_t firstIndex;
+		uint32_t indexCount;
+		uint32_t vertexCount;	// Unique vertices referenced
+		float center[3];
+		float radius;
+		float coneApex[3];
+		float coneAxis[3];
+		float coneCutoff;
+	};
+
+
+	// Uncompressed bytes per blob chunk. Chunks never straddle the vertex/index boundary, so each
+	// one decompresses straight into its final buffer
+	constexpr uint32_t MESH_CHUNK_SIZE = 256 * 1024;
+
+	// Chunks are stored back to back: vertex data first, then index data. A chunk that didn't
+	// compress is stored as-is, with compressedSize == originalSize.
+	struct MeshChunk
+	{
+		uint32_t compressedSize;
+		uint32_t originalSize;
+	};
 
 	struct MeshInfo
 	{
@@ -43,13 +127,48 @@ namespace assets
 		VertexFormat vertexFormat;
 		MeshBounds bounds;
 		uint8_t indexSize;
+		IndexEncoding indexEncoding;	// Requested when packing; falls back to Raw for unindexed meshes
+		VertexStreams vertexStreams;
  		CompressionMode compressionMode;
 		std::string sourceFile;
+		std::vector<MeshChunk> chunks;	// Empty for older files with a single merged LZ4 block
+		std::vector<MeshLod> lods;		// Finest first, lods[0] is the full mesh; empty for older files and unindexed meshes
+		std::vector<Meshlet> meshlets;	// Empty for older files and unindexed meshes
+		uint64_t contentHash;	// From the asset header, 0 if the file has none
+	};
+
+	// Fixed-layout binary form of MeshInfo, stored little-endian in the asset's metadata section
+	struct MeshMeta
+	{
+		uint32_t size;
+		VertexFormat vertexFormat;
+		uint64_t vertexBufferSize;
+		uint64_t indexBufferSize;
+		CompressionMode compressionMode;
+		uint8_t indexSize;
+		IndexEncoding indexEncoding;	// Raw in files written before it existed
+		VertexStreams vertexStreams;	// Interleaved in files written before it existed
+		uint8_t padding;
+		MeshBounds bounds;
+		MetaRange sourceFile;
+		uint32_t chunkSize;
+		MetaRange chunks;		// MeshChunk[]
+		MetaRange meshlets;		// Meshlet[]
+		MetaRange lods;			// MeshLod[]
 	};
+	static_assert(sizeof(MeshMeta) == 96, "MeshMeta layout is part of the file format");
+	static_assert(sizeof(MeshChunk) == 8, "MeshChunk layout is part of the file format");
+	static_assert(sizeof(Meshlet) == 56, "Meshlet layout is part of the file format");
+	static_assert(sizeof(MeshLod) == 20, "MeshLod layout is part of the file format");
 
-	MeshInfo ReadMeshInfo(AssetFile* file);
-	void UnpackMesh(MeshInfo* info, const char* sourceBuffer, size_t sourceSize, char* vertexBuffer, char* indexBuffer);
-	AssetFile PackMesh(MeshInfo* info, void* vertexData, void* indexData);
+	// False, with an error printed, when the metadata is corrupt; info is then not usable
+	bool ReadMeshInfo(AssetFile* file, MeshInfo& info);
+	bool ReadMeshInfo(const AssetView* view, MeshInfo& info);
+	bool UnpackMesh(MeshInfo* info, const char* sourceBuffer, size_t sourceSize, char* vertexBuffer, char* indexBuffer, uint32_t verify = VerifyNone);
+	AssetFile PackMesh(MeshInfo* info, void* vertexData, void* indexData, const PackOptions& options = {});
 	VertexFormat ParseVertexFormat(const char* string);
+	// Bytes per vertex, and how many of those at its start hold the position (every format leads with it)
+	size_t GetVertexSize(VertexFormat format);
+	size_t GetPositionSize(VertexFormat format);
 	MeshBounds CalculateBounds(const Vertex_PNCV_F32* verts, size_t count);
 };
\ No newline at end of file
@@ -0,0 +1,1083 @@
+#include "mesh_processing.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+#include "vertex_kernels.h"
+
+
+assets::VertexCacheStats assets::AnalyzeVertexCache(const uint32_t* indices, size_t indexCount, size_t vertexCount, uint32_t cacheSize)
+{
+	VertexCacheStats stats{ 0.0f, 0.0f };
+	if (indexCount < 3 || vertexCount == 0)
+		return stats;
+
+	// A vertex is in the FIFO while fewer than cacheSize misses happened since it was loaded
+	std::vector<uint64_t> loadedAt(vertexCount, 0);
+	std::vector<bool> used(vertexCount, false);
+	uint64_t misses = 0;
+	size_t uniqueVertices = 0;
+
+	for (size_t i = 0; i < indexCount; ++i)
+	{
+		const uint32_t v = indices[i];
+		if (!used[v] || misses - loadedAt[v] >= cacheSize)
+		{
+			if (!used[v])
+			{
+				used[v] = true;
+				++uniqueVertices;
+			}
+			loadedAt[v] = misses;
+			++misses;
+		}
+	}
+
+	stats.acmr = static_cast<float>(misses) / static_cast<float>(indexCount / 3);
+	stats.atvr = static_cast<float>(misses) / static_cast<float>(uniqueVertices);
+	return stats;
+}
+
+
+namespace
+{
+	// Scoring from Forsyth's "Linear-Speed Vertex Cache Optimisation"
+	constexpr int SCORE_CACHE_SIZE = 32;
+	constexpr float CACHE_DECAY_POWER = 1.5f;
+	constexpr float LAST_TRIANGLE_SCORE = 0.75f;
+	constexpr float VALENCE_BOOST_SCALE = 2.0f;
+	constexpr float VALENCE_BOOST_POWER = 0.5f;
+	constexpr int MAX_SCORED_VALENCE = 32;
+
+	struct ScoreTables
+	{
+		float cache[SCORE_CACHE_SIZE];
+		float valence[MAX_SCORED_VALENCE + 1];
+
+		ScoreTables()
+		{
+			for (int i = 0; i < SCORE_CACHE_SIZE; ++i)
+			{
+				if (i < 3)
+					cache[i] = LAST_TRIANGLE_SCORE;
+				else
+					cache[i] = std::pow(1.0f - static_cast<float>(i - 3) / (SCORE_CACHE_SIZE - 3), CACHE_DECAY_POWER);
+			}
+
+			valence[0] = 0.0f;
+			for (int i = 1; i <= MAX_SCORED_VALENCE; ++i)
+				valence[i] = VALENCE_BOOST_SCALE * std::pow(static_cast<float>(i), -VALENCE_BOOST_POWER);
+		}
+	};
+
+	float VertexScore(const ScoreTables& tables, int cachePosition, uint32_t remaining)
+	{
+		// Vertices with nothing left to draw are worthless, wherever they sit
+		if (remaining == 0)
+			return -1.0f;
+
+		float score = (cachePosition >= 0) ? tables.cache[cachePosition] : 0.0f;
+		return score + tables.valence[std::min<uint32_t>(remaining, MAX_SCORED_VALENCE)];
+	}
+
+	// Triangles using each vertex, packed per vertex. The first remaining[v] entries of a
+	// vertex's range are the triangles it still has to be drawn with.
+	struct TriangleAdjacency
+	{
+		std::vector<uint32_t> remaining;
+		std::vector<uint32_t> offset;
+		std::vector<uint32_t> triangles;
+
+		TriangleAdjacency(const uint32_t* indices, size_t triangleCount, size_t vertexCount)
+			: remaining(vertexCount, 0), offset(vertexCount + 1, 0), triangles(triangleCount * 3)
+		{
+			for (size_t i = 0; i < triangleCount * 3; ++i)
+				++remaining[indices[i]];
+
+			for (size_t v = 0; v < vertexCount; ++v)
+				offset[v + 1] = offset[v] + remaining[v];
+
+			std::vector<uint32_t> fill(offset.begin(), offset.end() - 1);
+			for (size_t t = 0; t < triangleCount; ++t)
+			{
+				for (int k = 0; k < 3; ++k)
+					triangles[fill[indices[t * 3 + k]]++] = static_cast<uint32_t>(t);
+			}
+		}
+
+		uint32_t* Begin(uint32_t vertex) { return triangles.data() + offset[vertex]; }
+
+		void Remove(uint32_t vertex, uint32_t triangle)
+		{
+			uint32_t* list = Begin(vertex);
+			uint32_t* found = std::find(list, list + remaining[vertex], triangle);
+			std::swap(*found, list[remaining[vertex] - 1]);
+			--remaining[vertex];
+		}
+	};
+}
+
+void assets::OptimizeVertexCache(uint32_t* indices, size_t indexCount, size_t vertexCount)
+{
+	const size_t triangleCount = indexCount / 3;
+	if (triangleCount == 0 || vertexCount == 0)
+		return;
+
+	static const ScoreTables tables;
+
+	TriangleAdjacency adjacency(indices, triangleCount, vertexCount);
+	std::vector<uint32_t>& remaining = adjacency.remaining;
+
+	std::vector<int> cachePosition(vertexCount, -1);
+	std::vector<float> vertexScore(vertexCount);
+	for (size_t v = 0; v < vertexCount; ++v)
+		vertexScore[v] = VertexScore(tables, -1, remaining[v]);
+
+	std::vector<float> triangleScore(triangleCount);
+	std::vector<bool> emitted(triangleCount, false);
+	for (size_t t = 0; t < triangleCount; ++t)
+		triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+
+	int64_t best = std::max_element(triangleScore.begin(), triangleScore.end()) - triangleScore.begin();
+
+	std::vector<uint32_t> output;
+	output.reserve(triangleCount * 3);
+
+	uint32_t cache[SCORE_CACHE_SIZE + 3];
+	int cacheCount = 0;
+	size_t scanCursor = 0;
+
+	while (output.size() < triangleCount * 3)
+	{
+		// Nothing in the cache has triangles left, so start again from the next unused one
+		if (best < 0)
+		{
+			while (emitted[scanCursor])
+				++scanCursor;
+			best = static_cast<int64_t>(scanCursor);
+		}
+
+		const uint32_t* triangle = indices + best * 3;
+		output.insert(output.end(), triangle, triangle + 3);
+		emitted[best] = true;
+
+		for (int k = 0; k < 3; ++k)
+			adjacency.Remove(triangle[k], static_cast<uint32_t>(best));
+
+		// The triangle's vertices move to the front; older entries shift back and may fall out
+		uint32_t newCache[SCORE_CACHE_SIZE + 3];
+		int newCount = 0;
+		for (int k = 0; k < 3; ++k)
+		{
+			if (std::find(newCache, newCache + newCount, triangle[k]) == newCache + newCount)
+				newCache[newCount++] = triangle[k];
+		}
+		for (int i = 0; i < cacheCount; ++i)
+		{
+			if (std::find(newCache, newCache + newCount, cache[i]) == newCache + newCount)
+				newCache[newCount++] = cache[i];
+		}
+
+		for (int i = 0; i < newCount; ++i)
+		{
+			const uint32_t v = newCache[i];
+			cachePosition[v] = (i < SCORE_CACHE_SIZE) ? i : -1;
+
+			const float score = VertexScore(tables, cachePosition[v], remaining[v]);
+			const float delta = score - vertexScore[v];
+			vertexScore[v] = score;
+
+			const uint32_t* list = adjacency.Begin(v);
+			for (uint32_t j = 0; j < remaining[v]; ++j)
+				triangleScore[list[j]] += delta;
+		}
+
+		cacheCount = std::min(newCount, SCORE_CACHE_SIZE);
+		std::memcpy(cache, newCache, cacheCount * sizeof(uint32_t));
+
+		// Only triangles touching the cache changed score, so the next pick is among them
+		best = -1;
+		float bestScore = -1.0f;
+		for (int i = 0; i < cacheCount; ++i)
+		{
+			const uint32_t v = cache[i];
+			const uint32_t* list = adjacency.Begin(v);
+			for (uint32_t j = 0; j < remaining[v]; ++j)
+			{
+				if (triangleScore[list[j]] > bestScore)
+				{
+					bestScore = triangleScore[list[j]];
+					best = list[j];
+				}
+			}
+		}
+	}
+
+	std::memcpy(indices, output.data(), output.size() * sizeof(uint32_t));
+}
+
+
+namespace
+{
+	// FIFO post-transform cache; a vertex is resident while fewer than VERTEX_CACHE_SIZE misses
+	// happened since it was loaded
+	struct FifoCache
+	{
+		std::vector<uint64_t> loadedAt;
+		uint64_t misses{ assets::VERTEX_CACHE_SIZE };
+
+		explicit FifoCache(size_t vertexCount) : loadedAt(vertexCount, 0) {}
+
+		// Returns how many of the triangle's vertices had to be transformed
+		uint32_t Triangle(const uint32_t* triangle)
+		{
+			uint32_t triangleMisses = 0;
+			for (int k = 0; k < 3; ++k)
+			{
+				if (misses - loadedAt[triangle[k]] >= assets::VERTEX_CACHE_SIZE)
+				{
+					loadedAt[triangle[k]] = misses++;
+					++triangleMisses;
+				}
+			}
+			return triangleMisses;
+		}
+
+		void Flush() { misses += assets::VERTEX_CACHE_SIZE; }
+	};
+}
+
+void assets::OptimizeOverdraw(uint32_t* indices, size_t indexCount, const float* positions, size_t positionStride, size_t vertexCount, float threshold)
+{
+	const size_t triangleCount = indexCount / 3;
+	if (triangleCount < 2 || vertexCount == 0)
+		return;
+
+	auto position = [&](uint32_t v)
+	{
+		return reinterpret_cast<const float*>(reinterpret_cast<const char*>(positions) + v * positionStride);
+	};
+
+	// A triangle whose three vertices all miss the cache starts a hard cluster. Those are rare in
+	// optimized output, so each one is cut further wherever its running ACMR, counted from a cold
+	// cache, has come down to threshold times its overall ACMR. Each cluster then pays for a
+	// cold start at most, whatever order the clusters end up in.
+	std::vector<size_t> hardStart;
+	FifoCache cache(vertexCount);
+	for (size_t t = 0; t < triangleCount; ++t)
+	{
+		if (cache.Triangle(indices + t * 3) == 3 || t == 0)
+			hardStart.push_back(t);
+	}
+	hardStart.push_back(triangleCount);
+
+	std::vector<size_t> clusterStart;
+	for (size_t h = 0; h + 1 < hardStart.size(); ++h)
+	{
+		const size_t first = hardStart[h];
+		const size_t end = hardStart[h + 1];
+
+		cache.Flush();
+		uint32_t clusterMisses = 0;
+		for (size_t t = first; t < end; ++t)
+			clusterMisses += cache.Triangle(indices + t * 3);
+		const float target = threshold * static_cast<float>(clusterMisses) / static_cast<float>(end - first);
+
+		cache.Flush();
+		clusterStart.push_back(first);
+		size_t softStart = first;
+		uint32_t softMisses = 0;
+		for (size_t t = first; t < end; ++t)
+		{
+			softMisses += cache.Triangle(indices + t * 3);
+			if (t + 1 < end && static_cast<float>(softMisses) <= target * static_cast<float>(t + 1 - softStart))
+			{
+				cache.Flush();
+				clusterStart.push_back(t + 1);
+				softStart = t + 1;
+				softMisses = 0;
+			}
+		}
+	}
+	if (clusterStart.size() < 2)
+		return;
+	clusterStart.push_back(triangleCount);
+
+	// Area-weighted centroid and facing of each cluster, and of the whole mesh
+	struct Cluster
+	{
+		size_t first;
+		size_t count;
+		float centroid[3];
+		float normal[3];
+		float sortKey;
+	};
+	std::vector<Cluster> clusters(clusterStart.size() - 1);
+
+	float meshCentroid[3] = { 0.0f, 0.0f, 0.0f };
+	float meshArea = 0.0f;
+
+	for (size_t c = 0; c < clusters.size(); ++c)
+	{
+		Cluster& cluster = clusters[c];
+		cluster = {};
+		cluster.first = clusterStart[c];
+		cluster.count = clusterStart[c + 1] - clusterStart[c];
+
+		float area = 0.0f;
+		for (size_t t = cluster.first; t < cluster.first + cluster.count; ++t)
+		{
+			const float* p0 = position(indices[t * 3]);
+			const float* p1 = position(indices[t * 3 + 1]);
+			const float* p2 = position(indices[t * 3 + 2]);
+
+			const float e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+			const float e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+			const float n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+			const float a = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+			for (int k = 0; k < 3; ++k)
+			{
+				cluster.centroid[k] += (p0[k] + p1[k] + p2[k]) / 3.0f * a;
+				cluster.normal[k] += n[k];
+			}
+			area += a;
+		}
+
+		for (int k = 0; k < 3; ++k)
+			meshCentroid[k] += cluster.centroid[k];
+		meshArea += area;
+
+		if (area > 0.0f)
+		{
+			for (int k = 0; k < 3; ++k)
+				cluster.centroid[k] /= area;
+		}
+	}
+
+	if (meshArea <= 0.0f)
+		return;
+	for (int k = 0; k < 3; ++k)
+		meshCentroid[k] /= meshArea;
+
+	// Clusters far out along the direction they face are likely to occlude the rest
+	for (auto& cluster : clusters)
+	{
+		const float length = std::sqrt(cluster.normal[0] * cluster.normal[0] + cluster.normal[1] * cluster.normal[1] + cluster.normal[2] * cluster.normal[2]);
+		cluster.sortKey = 0.0f;
+		if (length > 0.0f)
+		{
+			for (int k = 0; k < 3; ++k)
+				cluster.sortKey += (cluster.centroid[k] - meshCentroid[k]) * cluster.normal[k] / length;
+		}
+	}
+
+	std::stable_sort(clusters.begin(), clusters.end(), [](const Cluster& a, const Cluster& b)
+		{
+			return a.sortKey > b.sortKey;
+		});
+
+	std::vector<uint32_t> sorted;
+	sorted.reserve(triangleCount * 3);
+	for (auto& cluster : clusters)
+		sorted.insert(sorted.end(), indices + cluster.first * 3, indices + (cluster.first + cluster.count) * 3);
+
+	const float before = AnalyzeVertexCache(indices, triangleCount * 3, vertexCount).acmr;
+	const float after = AnalyzeVertexCache(sorted.data(), sorted.size(), vertexCount).acmr;
+	if (after <= before * threshold)
+		std::memcpy(indices, sorted.data(), sorted.size() * sizeof(uint32_t));
+}
+
+
+size_t assets::OptimizeVertexFetch(void* vertices, size_t vertexCount, size_t vertexSize, uint32_t* indices, size_t indexCount)
+{
+	constexpr uint32_t unassigned = ~0u;
+
+	std::vector<uint32_t> remap(vertexCount, unassigned);
+	uint32_t nextVertex = 0;
+	for (size_t i = 0; i < indexCount; ++i)
+	{
+		uint32_t& target = remap[indices[i]];
+		if (target == unassigned)
+			target = nextVertex++;
+		indices[i] = target;
+	}
+
+	std::vector<char> reordered(static_cast<size_t>(nextVertex) * vertexSize);
+	const char* source = reinterpret_cast<const char*>(vertices);
+	for (size_t v = 0; v < vertexCount; ++v)
+	{
+		if (remap[v] != unassigned)
+			std::memcpy(reordered.data() + remap[v] * vertexSize, source + v * vertexSize, vertexSize);
+	}
+
+	std::memcpy(vertices, reordered.data(), reordered.size());
+	return nextVertex;
+}
+
+namespace
+{
+	const float* PositionOf(const float* positions, size_t stride, uint32_t vertex)
+	{
+		return reinterpret_cast<const float*>(reinterpret_cast<const char*>(positions) + vertex * stride);
+	}
+
+	// Unit normal of a triangle, false if it has no area
+	bool TriangleNormal(const float* p0, const float* p1, const float* p2, float normal[3])
+	{
+		const float e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+		const float e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+		normal[0] = e1[1] * e2[2] - e1[2] * e2[1];
+		normal[1] = e1[2] * e2[0] - e1[0] * e2[2];
+		normal[2] = e1[0] * e2[1] - e1[1] * e2[0];
+
+		const float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+		if (length == 0.0f)
+			return false;
+
+		for (int k = 0; k < 3; ++k)
+			normal[k] /= length;
+		return true;
+	}
+
+	void ComputeMeshletBounds(assets::Meshlet& meshlet, const uint32_t* indices, const float* positions, size_t stride)
+	{
+		// Sphere around the centre of the box
+		float min[3] = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+		float max[3] = { -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max() };
+		for (uint32_t i = 0; i < meshlet.indexCount; ++i)
+		{
+			const float* p = PositionOf(positions, stride, indices[i]);
+			for (int k = 0; k < 3; ++k)
+			{
+				min[k] = std::min(min[k], p[k]);
+				max[k] = std::max(max[k], p[k]);
+			}
+		}
+
+		float radiusSq = 0.0f;
+		for (int k = 0; k < 3; ++k)
+			meshlet.center[k] = (min[k] + max[k]) * 0.5f;
+		for (uint32_t i = 0; i < meshlet.indexCount; ++i)
+		{
+			const float* p = PositionOf(positions, stride, indices[i]);
+			const float d[3] = { p[0] - meshlet.center[0], p[1] - meshlet.center[1], p[2] - meshlet.center[2] };
+			radiusSq = std::max(radiusSq, d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+		}
+		meshlet.radius = std::sqrt(radiusSq);
+
+		// Cone around the average facing, widened to contain every triangle's normal
+		float axis[3] = { 0.0f, 0.0f, 0.0f };
+		for (uint32_t i = 0; i < meshlet.indexCount; i += 3)
+		{
+			float n[3];
+			if (TriangleNormal(PositionOf(positions, stride, indices[i]), PositionOf(positions, stride, indices[i + 1]), PositionOf(positions, stride, indices[i + 2]), n))
+			{
+				for (int k = 0; k < 3; ++k)
+					axis[k] += n[k];
+			}
+		}
+
+		meshlet.coneCutoff = 1.0f;
+		const float axisLength = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+		if (axisLength == 0.0f)
+			return;
+		for (int k = 0; k < 3; ++k)
+			axis[k] /= axisLength;
+
+		float minDot = 1.0f;
+		float maxT = 0.0f;
+		for (uint32_t i = 0; i < meshlet.indexCount; i += 3)
+		{
+			const float* p0 = PositionOf(positions, stride, indices[i]);
+			float n[3];
+			if (!TriangleNormal(p0, PositionOf(positions, stride, indices[i + 1]), PositionOf(positions, stride, indices[i + 2]), n))
+				continue;
+
+			const float dn = axis[0] * n[0] + axis[1] * n[1] + axis[2] * n[2];
+			minDot = std::min(minDot, dn);
+			if (dn <= 0.0f)
+				break;
+
+			// The apex has to sit behind every triangle's plane
+			const float dc = (meshlet.center[0] - p0[0]) * n[0] + (meshlet.center[1] - p0[1]) * n[1] + (meshlet.center[2] - p0[2]) * n[2];
+			maxT = std::max(maxT, dc / dn);
+		}
+
+		// Past roughly 85 degrees either way the cone would hardly ever cull
+		if (minDot <= 0.1f)
+			return;
+
+		for (int k = 0; k < 3; ++k)
+		{
+			meshlet.coneAxis[k] = axis[k];
+			meshlet.coneApex[k] = meshlet.center[k] - axis[k] * maxT;
+		}
+		meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+	}
+}
+
+std::vector<assets::Meshlet> assets::BuildMeshlets(uint32_t* indices, size_t indexCount, const float* positions, size_t positionStride, size_t vertexCount,
+	uint32_t maxVertices, uint32_t maxTriangles)
+{
+	std::vector<Meshlet> meshlets;
+
+	const size_t triangleCount = indexCount / 3;
+	if (triangleCount == 0 || vertexCount == 0 || maxVertices < 3 || maxTriangles == 0)
+		return meshlets;
+
+	TriangleAdjacency adjacency(indices, triangleCount, vertexCount);
+
+	std::vector<float> centroids(triangleCount * 3);
+	for (size_t t = 0; t < triangleCount; ++t)
+	{
+		const float* p0 = PositionOf(positions, positionStride, indices[t * 3]);
+		const float* p1 = PositionOf(positions, positionStride, indices[t * 3 + 1]);
+		const float* p2 = PositionOf(positions, positionStride, indices[t * 3 + 2]);
+		for (int k = 0; k < 3; ++k)
+			centroids[t * 3 + k] = (p0[k] + p1[k] + p2[k]) / 3.0f;
+	}
+
+	constexpr uint32_t none = ~0u;
+	std::vector<uint32_t> vertexMeshlet(vertexCount, none);	// Meshlet each vertex was last added to
+	std::vector<bool> used(triangleCount, false);
+
+	std::vector<uint32_t> output;
+	output.reserve(triangleCount * 3);
+
+	std::vector<uint32_t> meshletVertices;
+	std::vector<uint32_t> meshletTriangles;
+	std::vector<uint32_t> localIndices;
+	size_t scanCursor = 0;
+
+	while (output.size() < triangleCount * 3)
+	{
+		const uint32_t id = static_cast<uint32_t>(meshlets.size());
+		meshletVertices.clear();
+		meshletTriangles.clear();
+		float centroidSum[3] = { 0.0f, 0.0f, 0.0f };
+
+		auto addTriangle = [&](uint32_t t)
+		{
+			used[t] = true;
+			meshletTriangles.push_back(t);
+			for (int k = 0; k < 3; ++k)
+			{
+				const uint32_t v = indices[t * 3 + k];
+				if (vertexMeshlet[v] != id)
+				{
+					vertexMeshlet[v] = id;
+					meshletVertices.push_back(v);
+				}
+				adjacency.Remove(v, t);
+			}
+			for (int k = 0; k < 3; ++k)
+				centroidSum[k] += centroids[t * 3 + k];
+		};
+
+		// Seeding from the next unused triangle in the current order keeps meshlets in roughly
+		// the order the earlier passes chose
+		while (used[scanCursor])
+			++scanCursor;
+		addTriangle(static_cast<uint32_t>(scanCursor));
+
+		// Grow through shared vertices, preferring triangles that add the fewest new vertices,
+		// then the ones closest to the meshlet's centre
+		while (meshletTriangles.size() < maxTriangles)
+		{
+			const float scale = 1.0f / static_cast<float>(meshletTriangles.size());
+			const float center[3] = { centroidSum[0] * scale, centroidSum[1] * scale, centroidSum[2] * scale };
+
+			int64_t best = -1;
+			uint32_t bestExtra = 4;
+			float bestDistance = 0.0f;
+			for (uint32_t v : meshletVertices)
+			{
+				const uint32_t* list = adjacency.Begin(v);
+				for (uint32_t j = 0; j < adjacency.remaining[v]; ++j)
+				{
+					const uint32_t t = list[j];
+					const uint32_t extra = (vertexMeshlet[indices[t * 3]] != id) + (vertexMeshlet[indices[t * 3 + 1]] != id) + (vertexMeshlet[indices[t * 3 + 2]] != id);
+					if (meshletVertices.size() + extra > maxVertices)
+						continue;
+
+					const float d[3] = { centroids[t * 3] - center[0], centroids[t * 3 + 1] - center[1], centroids[t * 3 + 2] - center[2] };
+					const float distance = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+					if (extra < bestExtra || (extra == bestExtra && distance < bestDistance))
+					{
+						best = t;
+						bestExtra = extra;
+						bestDistance = distance;
+					}
+				}
+			}
+
+			if (best < 0)
+				break;
+			addTriangle(static_cast<uint32_t>(best));
+		}
+
+		// Growing by fewest new vertices loses the cache order the earlier pass chose, so reorder the
+		// meshlet's triangles for the cache again on indices local to it, which keeps this cheap
+		localIndices.clear();
+		for (uint32_t t : meshletTriangles)
+		{
+			for (int k = 0; k < 3; ++k)
+			{
+				const uint32_t v = indices[t * 3 + k];
+				localIndices.push_back(static_cast<uint32_t>(std::find(meshletVertices.begin(), meshletVertices.end(), v) - meshletVertices.begin()));
+			}
+		}
+		OptimizeVertexCache(localIndices.data(), localIndices.size(), meshletVertices.size());
+
+		Meshlet meshlet{};
+		meshlet.firstIndex = static_cast<uint32_t>(output.size());
+		meshlet.indexCount = static_cast<uint32_t>(meshletTriangles.size() * 3);
+		meshlet.vertexCount = static_cast<uint32_t>(meshletVertices.size());
+		for (uint32_t local : localIndices)
+			output.push_back(meshletVertices[local]);
+
+		ComputeMeshletBounds(meshlet, output.data() + meshlet.firstIndex, positions, positionStride);
+		meshlets.push_back(meshlet);
+	}
+
+	std::memcpy(indices, output.data(), output.size() * sizeof(uint32_t));
+	return meshlets;
+}
+
+namespace
+{
+	// Sum of weighted squared distances to a set of planes, as a symmetric 4x4 matrix
+	struct Quadric
+	{
+		float a00, a11, a22, a10, a20, a21;
+		float b0, b1, b2;
+		float c;
+		float w;
+
+		void AddPlane(const float n[3], float d, float weight)
+		{
+			a00 += weight * n[0] * n[0];
+			a11 += weight * n[1] * n[1];
+			a22 += weight * n[2] * n[2];
+			a10 += weight * n[1] * n[0];
+			a20 += weight * n[2] * n[0];
+			a21 += weight * n[2] * n[1];
+			b0 += weight * n[0] * d;
+			b1 += weight * n[1] * d;
+			b2 += weight * n[2] * d;
+			c += weight * d * d;
+			w += weight;
+		}
+
+		void Add(const Quadric& q)
+		{
+			a00 += q.a00; a11 += q.a11; a22 += q.a22;
+			a10 += q.a10; a20 += q.a20; a21 += q.a21;
+			b0 += q.b0; b1 += q.b1; b2 += q.b2;
+			c += q.c;
+			w += q.w;
+		}
+
+		// Weighted mean squared distance of p from the planes
+		float Error(const float* p) const
+		{
+			const float rx = a00 * p[0] + a10 * p[1] + a20 * p[2];
+			const float ry = a10 * p[0] + a11 * p[1] + a21 * p[2];
+			const float rz = a20 * p[0] + a21 * p[1] + a22 * p[2];
+			const float r = rx * p[0] + ry * p[1] + rz * p[2] + 2.0f * (b0 * p[0] + b1 * p[1] + b2 * p[2]) + c;
+			return (w > 0.0f) ? std::fabs(r) / w : 0.0f;
+		}
+	};
+
+	// Manifold vertices can move to any neighbour, border vertices only along their border
+	enum class VertexKind : uint8_t
+	{
+		Manifold,
+		Border,
+		Locked
+	};
+
+	// Border edges weigh more than faces so outlines survive longer than interior detail
+	constexpr float BORDER_WEIGHT = 10.0f;
+
+	// Cosine of the most a surviving triangle may rotate in one collapse (about 75 degrees)
+	constexpr float FLIP_THRESHOLD = 0.25f;
+}
+
+size_t assets::SimplifyMesh(uint32_t* destination, const uint32_t* indices, size_t indexCount, const float* positions, size_t positionStride, size_t vertexCount,
+	size_t targetIndexCount, float targetError, float* resultError)
+{
+	std::vector<uint32_t> result(indices, indices + indexCount / 3 * 3);
+	*resultError = 0.0f;
+
+	if (result.size() <= targetIndexCount || vertexCount == 0)
+	{
+		std::memcpy(destination, result.data(), result.size() * sizeof(uint32_t));
+		return result.size();
+	}
+
+	// Work in a unit cube so targetError doesn't depend on the mesh's scale
+	float min[3] = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+	float max[3] = { -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max() };
+	for (size_t v = 0; v < vertexCount; ++v)
+	{
+		const float* p = PositionOf(positions, positionStride, static_cast<uint32_t>(v));
+		for (int k = 0; k < 3; ++k)
+		{
+			min[k] = std::min(min[k], p[k]);
+			max[k] = std::max(max[k], p[k]);
+		}
+	}
+	const float extent = std::max(max[0] - min[0], std::max(max[1] - min[1], max[2] - min[2]));
+	const float scale = (extent > 0.0f) ? 1.0f / extent : 1.0f;
+
+	std::vector<float> unit(vertexCount * 3);
+	for (size_t v = 0; v < vertexCount; ++v)
+	{
+		const float* p = PositionOf(positions, positionStride, static_cast<uint32_t>(v));
+		for (int k = 0; k < 3; ++k)
+			unit[v * 3 + k] = (p[k] - min[k]) * scale;
+	}
+	auto position = [&](uint32_t v) { return &unit[v * 3]; };
+
+	std::vector<VertexKind> kind(vertexCount, VertexKind::Manifold);
+	std::vector<uint32_t> borderNext(vertexCount);
+	std::vector<uint32_t> borderPrevious(vertexCount);
+	std::vector<Quadric> quadrics(vertexCount, Quadric{});
+	{
+		// Vertices sharing a position with another sit on a UV or normal seam
+		std::vector<uint32_t> sorted(vertexCount);
+		for (size_t v = 0; v < vertexCount; ++v)
+			sorted[v] = static_cast<uint32_t>(v);
+		std::sort(sorted.begin(), sorted.end(), [&](uint32_t a, uint32_t b)
+			{
+				return std::lexicographical_compare(position(a), position(a) + 3, position(b), position(b) + 3);
+			});
+		for (size_t i = 1; i < vertexCount; ++i)
+		{
+			if (std::equal(position(sorted[i]), position(sorted[i]) + 3, position(sorted[i - 1])))
+			{
+				kind[sorted[i]] = VertexKind::Locked;
+				kind[sorted[i - 1]] = VertexKind::Locked;
+			}
+		}
+
+		TriangleAdjacency adjacency(result.data(), result.size() / 3, vertexCount);
+		auto hasEdge = [&](uint32_t a, uint32_t b)
+		{
+			const uint32_t* list = adjacency.Begin(a);
+			for (uint32_t j = 0; j < adjacency.remaining[a]; ++j)
+			{
+				const uint32_t* triangle = &result[list[j] * 3];
+				for (int k = 0; k < 3; ++k)
+				{
+					if (triangle[k] == a && triangle[(k + 1) % 3] == b)
+						return true;
+				}
+			}
+			return false;
+		};
+
+		// An edge without a matching edge the other way round is on an open border
+		std::vector<uint8_t> bordersOut(vertexCount, 0);
+		std::vector<uint8_t> bordersIn(vertexCount, 0);
+		for (size_t t = 0; t < result.size() / 3; ++t)
+		{
+			const uint32_t* triangle = &result[t * 3];
+			const float* p0 = position(triangle[0]);
+			const float* p1 = position(triangle[1]);
+			const float* p2 = position(triangle[2]);
+
+			const float e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+			const float e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+			float n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+			const float area = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+			if (area > 0.0f)
+			{
+				for (int k = 0; k < 3; ++k)
+					n[k] /= area;
+				const float d = -(n[0] * p0[0] + n[1] * p0[1] + n[2] * p0[2]);
+				for (int k = 0; k < 3; ++k)
+					quadrics[triangle[k]].AddPlane(n, d, area * 0.5f);
+			}
+
+			for (int k = 0; k < 3; ++k)
+			{
+				const uint32_t a = triangle[k];
+				const uint32_t b = triangle[(k + 1) % 3];
+				if (hasEdge(b, a))
+					continue;
+
+				bordersOut[a] = static_cast<uint8_t>(std::min(bordersOut[a] + 1, 2));
+				bordersIn[b] = static_cast<uint8_t>(std::min(bordersIn[b] + 1, 2));
+				borderNext[a] = b;
+				borderPrevious[b] = a;
+
+				// A plane through the edge, perpendicular to the face, keeps the outline in place
+				const float* pa = position(a);
+				const float* pb = position(b);
+				const float e[3] = { pb[0] - pa[0], pb[1] - pa[1], pb[2] - pa[2] };
+				float en[3] = { e[1] * n[2] - e[2] * n[1], e[2] * n[0] - e[0] * n[2], e[0] * n[1] - e[1] * n[0] };
+				const float length = std::sqrt(en[0] * en[0] + en[1] * en[1] + en[2] * en[2]);
+				if (area > 0.0f && length > 0.0f)
+				{
+					for (int j = 0; j < 3; ++j)
+						en[j] /= length;
+					const float d = -(en[0] * pa[0] + en[1] * pa[1] + en[2] * pa[2]);
+					const float weight = (e[0] * e[0] + e[1] * e[1] + e[2] * e[2]) * BORDER_WEIGHT;
+					quadrics[a].AddPlane(en, d, weight);
+					quadrics[b].AddPlane(en, d, weight);
+				}
+			}
+		}
+
+		for (size_t v = 0; v < vertexCount; ++v)
+		{
+			if (kind[v] == VertexKind::Locked || (bordersOut[v] == 0 && bordersIn[v] == 0))
+				continue;
+			kind[v] = (bordersOut[v] == 1 && bordersIn[v] == 1) ? VertexKind::Border : VertexKind::Locked;
+		}
+	}
+
+	auto canCollapse = [&](uint32_t from, uint32_t to)
+	{
+		if (kind[from] == VertexKind::Manifold)
+			return true;
+		return kind[from] == VertexKind::Border && (borderNext[from] == to || borderPrevious[from] == to);
+	};
+
+	struct Collapse
+	{
+		uint32_t from;
+		uint32_t to;
+		float error;
+	};
+	std::vector<Collapse> collapses;
+	std::vector<uint32_t> remap(vertexCount);
+	std::vector<bool> locked(vertexCount);
+
+	const float errorLimit = targetError * targetError;
+	float maxError = 0.0f;
+
+	// Each pass takes the cheapest collapses that don't touch one another, then rebuilds the triangles
+	while (result.size() > targetIndexCount)
+	{
+		const size_t triangleCount = result.size() / 3;
+		TriangleAdjacency adjacency(result.data(), triangleCount, vertexCount);
+
+		collapses.clear();
+		for (size_t t = 0; t < triangleCount; ++t)
+		{
+			for (int k = 0; k < 3; ++k)
+			{
+				const uint32_t a = result[t * 3 + k];
+				const uint32_t b = result[t * 3 + (k + 1) % 3];
+				const float errorAB = canCollapse(a, b) ? quadrics[a].Error(position(b)) : std::numeric_limits<float>::max();
+				const float errorBA = canCollapse(b, a) ? quadrics[b].Error(position(a)) : std::numeric_limits<float>::max();
+				if (errorAB <= errorBA && errorAB <= errorLimit)
+					collapses.push_back({ a, b, errorAB });
+				else if (errorBA < errorAB && errorBA <= errorLimit)
+					collapses.push_back({ b, a, errorBA });
+			}
+		}
+
+		std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b)
+			{
+				return a.error < b.error;
+			});
+
+		for (size_t v = 0; v < vertexCount; ++v)
+			remap[v] = static_cast<uint32_t>(v);
+		std::fill(locked.begin(), locked.end(), false);
+
+		const size_t trianglesToRemove = (result.size() - targetIndexCount + 2) / 3;
+		size_t trianglesRemoved = 0;
+
+		for (const Collapse& collapse : collapses)
+		{
+			if (trianglesRemoved >= trianglesToRemove)
+				break;
+			if (locked[collapse.from] || locked[collapse.to])
+				continue;
+
+			// Reject collapses that would turn a surviving triangle over, or nearly
+			const uint32_t* list = adjacency.Begin(collapse.from);
+			const float* pt = position(collapse.to);
+			const float* pf = position(collapse.from);
+			bool flips = false;
+			size_t dying = 0;
+			for (uint32_t j = 0; j < adjacency.remaining[collapse.from] && !flips; ++j)
+			{
+				const uint32_t* triangle = &result[list[j] * 3];
+				if (triangle[0] == collapse.to || triangle[1] == collapse.to || triangle[2] == collapse.to)
+				{
+					++dying;
+					continue;
+				}
+
+				const int k = (triangle[0] == collapse.from) ? 0 : (triangle[1] == collapse.from) ? 1 : 2;
+				const float* p1 = position(triangle[(k + 1) % 3]);
+				const float* p2 = position(triangle[(k + 2) % 3]);
+
+				const float a1[3] = { p1[0] - pf[0], p1[1] - pf[1], p1[2] - pf[2] };
+				const float a2[3] = { p2[0] - pf[0], p2[1] - pf[1], p2[2] - pf[2] };
+				const float b1[3] = { p1[0] - pt[0], p1[1] - pt[1], p1[2] - pt[2] };
+				const float b2[3] = { p2[0] - pt[0], p2[1] - pt[1], p2[2] - pt[2] };
+				const float before[3] = { a1[1] * a2[2] - a1[2] * a2[1], a1[2] * a2[0] - a1[0] * a2[2], a1[0] * a2[1] - a1[1] * a2[0] };
+				const float after[3] = { b1[1] * b2[2] - b1[2] * b2[1], b1[2] * b2[0] - b1[0] * b2[2], b1[0] * b2[1] - b1[1] * b2[0] };
+				const float beforeLength = std::sqrt(before[0] * before[0] + before[1] * before[1] + before[2] * before[2]);
+				const float afterLength = std::sqrt(after[0] * after[0] + after[1] * after[1] + after[2] * after[2]);
+				flips = before[0] * after[0] + before[1] * after[1] + before[2] * after[2] <= FLIP_THRESHOLD * beforeLength * afterLength;
+			}
+			if (flips)
+				continue;
+
+			// Freezing the whole one-ring means no triangle moves twice in a pass, so the flip
+			// test above saw final positions
+			for (uint32_t j = 0; j < adjacency.remaining[collapse.from]; ++j)
+			{
+				const uint32_t* triangle = &result[list[j] * 3];
+				locked[triangle[0]] = locked[triangle[1]] = locked[triangle[2]] = true;
+			}
+			locked[collapse.to] = true;
+
+			remap[collapse.from] = collapse.to;
+			quadrics[collapse.to].Add(quadrics[collapse.from]);
+
+			if (kind[collapse.from] == VertexKind::Border)
+			{
+				if (borderNext[collapse.from] == collapse.to)
+				{
+					borderNext[borderPrevious[collapse.from]] = collapse.to;
+					borderPrevious[collapse.to] = borderPrevious[collapse.from];
+				}
+				else
+				{
+					borderPrevious[borderNext[collapse.from]] = collapse.to;
+					borderNext[collapse.to] = borderNext[collapse.from];
+				}
+			}
+
+			maxError = std::max(maxError, collapse.error);
+			trianglesRemoved += dying;
+		}
+
+		if (trianglesRemoved == 0)
+			break;
+
+		size_t write = 0;
+		for (size_t t = 0; t < triangleCount; ++t)
+		{
+			const uint32_t a = remap[result[t * 3]];
+			const uint32_t b = remap[result[t * 3 + 1]];
+			const uint32_t c = remap[result[t * 3 + 2]];
+			if (a == b || b == c || a == c)
+				continue;
+
+			result[write++] = a;
+			result[write++] = b;
+			result[write++] = c;
+		}
+		result.resize(write);
+	}
+
+	*resultError = std::sqrt(maxError) / scale;
+	std::memcpy(destination, result.data(), result.size() * sizeof(uint32_t));
+	return result.size();
+}
+
+namespace
+{
+	// Round to nearest; denormals flush to zero and out of range values become infinity
+	uint16_t FloatToHalf(float value)
+	{
+		uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+
+		const uint32_t sign = (bits >> 16) & 0x8000;
+		const uint32_t magnitude = bits & 0x7fffffff;
+
+		// Rebias the exponent from 127 to 15 and round away the low 13 mantissa bits
+		uint32_t half = (magnitude - (112u << 23) + (1u << 12)) >> 13;
+		if (magnitude < (113u << 23))
+			half = 0;
+		if (magnitude >= (143u << 23))
+			half = 0x7c00;
+		if (magnitude > (255u << 23))
+			half = 0x7e00;
+
+		return static_cast<uint16_t>(sign | half);
+	}
+
+	uint8_t UnitToUnorm8(float value)
+	{
+		return static_cast<uint8_t>(std::min(std::max(value, 0.0f), 1.0f) * 255.0f + 0.5f);
+	}
+}
+
+void assets::QuantizeVertices(const Vertex_PNCV_F32* vertices, size_t count, const MeshBounds& bounds, Vertex_P16N8C8V16* quantized)
+{
+	if (count == 0)
+		return;
+
+	QuantizePositions(vertices[0].position, sizeof(Vertex_PNCV_F32), bounds, quantized[0].position, sizeof(Vertex_P16N8C8V16), count);
+	EncodeOctNormals(vertices[0].normal, sizeof(Vertex_PNCV_F32), quantized[0].octNormal, sizeof(Vertex_P16N8C8V16), count);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		const Vertex_PNCV_F32& source = vertices[i];
+		Vertex_P16N8C8V16& target = quantized[i];
+
+		target.position[3] = 0;
+
+		target.uv[0] = FloatToHalf(source.uv[0]);
+		target.uv[1] = FloatToHalf(source.uv[1]);
+
+		for (int k = 0; k < 3; ++k)
+			target.color[k] = UnitToUnorm8(source.color[k]);
+		target.color[3] = 255;
+
+		target.padding[0] = target.padding[1] = 0;
+	}
+}
+
+void assets::PackVertices(const Vertex_PNCV_F32* vertices, size_t count, Vertex_P32N8C8V32* packed)
+{
+	if (count == 0)
+		return;
+
+	EncodeOctNormals(vertices[0].normal, sizeof(Vertex_PNCV_F32), packed[0].octNormal, sizeof(Vertex_P32N8C8V32), count);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		const Vertex_PNCV_F32& source = vertices[i];
+		Vertex_P32N8C8V32& target = packed[i];
+
+		for (int k = 0; k < 3; ++k)
+		{
+			target.position[k] = source.position[k];
+			target.color[k] = UnitToUnorm8(source.color[k]);
+			target.padding[k] = 0;
+		}
+
+		target.uv[0] = source.uv[0];
+		target.uv[1] = source.uv[1];
+	}
+}
+
+void assets::SplitVertexStreams(const void* vertices, size_t count, size_t vertexSize, size_t positionSize, void* split)
+{
+	const size_t attributeSize = vertexSize - positionSize;
+	const char* source = reinterpret_cast<const char*>(vertices);
+	char* positions = reinterpret_cast<char*>(split);
+	char* attributes = positions + count * positionSize;
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		memcpy(positions + i * positionSize, source + i * vertexSize, positionSize);
+		memcpy(attributes + i * attributeSize, source + i * vertexSize + positionSize, attributeSize);
+	}
+}
\ No newline at end of file
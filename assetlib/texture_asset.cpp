@@ -1,17 +1,26 @@
 #include "texture_asset.h"
 
 #include <iostream>
+#include <algorithm>
 #include <cstring>
 #include "json.hpp"
 #include "lz4.h"
+#include "asset_parallel.h"
 
-#define TEXTURE_ASSET_VERSION 1
+#define TEXTURE_ASSET_VERSION 2
 
-assets::TextureInfo assets::ReadTextureInfo(AssetFile* file)
+static bool ParseTextureInfo(std::string_view json, assets::TextureInfo& info)
 {
-	TextureInfo info;
+	using namespace assets;
 
-	nlohmann::json textureMeta = nlohmann::json::parse(file->json);
+	info = TextureInfo{};
+
+	nlohmann::json textureMeta = nlohmann::json::parse(json, nullptr, false);
+	if (textureMeta.is_discarded())
+	{
+		std::cout << "ERROR: Texture: invalid JSON metadata" << std::endl;
+		return false;
+	}
 
 	std::string formatStr = textureMeta["format"];
 	info.textureFormat = ParseTextureFormat(formatStr.c_str());
@@ -34,51 +43,291 @@ assets::TextureInfo assets::ReadTextureInfo(AssetFile* file)
 		info.pages.push_back(page);
 	}
 
-	return info;
+	if (textureMeta.contains("tileSize"))
+	{
+		info.tileSize = textureMeta["tileSize"];
+		info.tileBorder = textureMeta["tileBorder"];
+	}
+
+	if (textureMeta.contains("chunks"))
+	{
+		for (auto& [key, value] : textureMeta["chunks"].items())
+		{
+			TextureChunk chunk;
+			chunk.compressedSize = value["compressedSize"];
+			chunk.originalSize = value["originalSize"];
+			info.chunks.push_back(chunk);
+		}
+	}
+
+	return true;
+}
+
+static bool ReadTextureMeta(const char* data, size_t size, assets::TextureInfo& info)
+{
+	using namespace assets;
+
+	info = TextureInfo{};
+
+	MetaReader reader(data, size);
+	TextureMeta meta;
+	if (!reader.ReadHeader(meta) || !reader.ReadString(meta.sourceFile, info.sourceFile) || !reader.ReadArray(meta.pages, info.pages)
+		|| !reader.ReadArray(meta.chunks, info.chunks) || !reader.ReadArray(meta.pageLocations, info.pageLocations))
+	{
+		std::cout << "ERROR: Texture: invalid binary metadata" << std::endl;
+		return false;
+	}
+
+	info.dataSize = meta.dataSize;
+	info.textureFormat = meta.textureFormat;
+	info.compressionMode = meta.compressionMode;
+	info.tileSize = meta.tileSize;
+	info.tileBorder = meta.tileBorder;
+
+	return true;
 }
 
-void assets::UnpackTexture(TextureInfo* info, const char* sourceBuffer, size_t sourceSize, char* destination)
+// Checks the chunk table against the pages and works out where each page starts. Older files
+// store each page as a single block, which is the same as one chunk per page, and files cooked
+// before page locations were stored get them derived here. Tiled pages hold a chunk per tile.
+static bool FinishLayout(assets::TextureInfo& info)
 {
-	if (info->compressionMode == CompressionMode::LZ4)
+	using namespace assets;
+
+	if (info.chunks.empty())
 	{
-		for (auto& page : info->pages)
+		for (auto& page : info.pages)
+			info.chunks.push_back({ page.compressedSize, page.originalSize });
+	}
+
+	std::vector<PageLocation> locations;
+	locations.reserve(info.pages.size());
+
+	size_t chunk = 0;
+	uint64_t blobOffset = 0;
+	uint64_t dataOffset = 0;
+	for (auto& page : info.pages)
+	{
+		PageLocation location{ blobOffset, dataOffset, static_cast<uint32_t>(chunk), 0 };
+
+		uint64_t original = 0;
+		uint64_t compressed = 0;
+		while (original < page.originalSize && chunk < info.chunks.size())
 		{
-			LZ4_decompress_safe(sourceBuffer, destination, page.compressedSize, page.originalSize);
-			sourceBuffer += page.compressedSize;
-			destination += page.originalSize;
+			original += info.chunks[chunk].originalSize;
+			compressed += info.chunks[chunk].compressedSize;
+			++chunk;
 		}
+
+		if (original != page.originalSize || compressed != page.compressedSize)
+			return false;
+
+		location.chunkCount = static_cast<uint32_t>(chunk) - location.firstChunk;
+		if (info.tileSize != 0 && location.chunkCount != GetTextureTileColumns(&info, static_cast<uint32_t>(locations.size())) * GetTextureTileRows(&info, static_cast<uint32_t>(locations.size())))
+			return false;
+		locations.push_back(location);
+
+		blobOffset += compressed;
+		dataOffset += original;
 	}
-	else
+
+	if (chunk != info.chunks.size())
+		return false;
+
+	if (!info.pageLocations.empty())
 	{
- 		std::memcpy(destination, sourceBuffer, sourceSize);
+		if (info.pageLocations.size() != locations.size()
+			|| std::memcmp(info.pageLocations.data(), locations.data(), locations.size() * sizeof(PageLocation)) != 0)
+			return false;
 	}
+	info.pageLocations = std::move(locations);
+
+	return true;
+}
+
+// Missing or mistyped JSON fields throw, which counts as corrupt metadata too
+static bool ReadTextureInfoFrom(const char* meta, size_t metaSize, std::string_view json, assets::TextureInfo& info)
+{
+	try
+	{
+		if (!((meta != nullptr) ? ReadTextureMeta(meta, metaSize, info) : ParseTextureInfo(json, info)))
+			return false;
+	}
+	catch (const nlohmann::json::exception& e)
+	{
+		std::cout << "ERROR: Texture: invalid JSON metadata: " << e.what() << std::endl;
+		return false;
+	}
+
+	if (!FinishLayout(info))
+	{
+		std::cout << "ERROR: Texture: chunk table or page locations don't match the pages" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+bool assets::ReadTextureInfo(AssetFile* file, TextureInfo& info)
+{
+	if (!ReadTextureInfoFrom(!file->meta.empty() ? file->meta.data() : nullptr, file->meta.size(), file->json, info))
+		return false;
+	info.contentHash = file->contentHash;
+	return true;
+}
+
+bool assets::ReadTextureInfo(const AssetView* view, TextureInfo& info)
+{
+	if (!ReadTextureInfoFrom(view->meta, view->metaSize, view->json, info))
+		return false;
+	info.contentHash = view->contentHash;
+	return true;
 }
 
-void assets::UnpackTexturePage(TextureInfo* info, int pageIndex, char* sourceBuffer, char* destination)
+std::vector<assets::TextureChunkRange> assets::GetTextureChunkRanges(const TextureInfo* info)
 {
-	char* source = sourceBuffer;
-	for (int i = 0; i < pageIndex; ++i)
+	std::vector<TextureChunkRange> ranges;
+	ranges.reserve(info->chunks.size());
+
+	uint32_t page = 0;
+	uint32_t pageOffset = 0;
+	uint64_t blobOffset = 0;
+	for (auto& chunk : info->chunks)
 	{
-		source += info->pages[i].compressedSize;
+		ranges.push_back({ page, pageOffset, blobOffset });
+
+		blobOffset += chunk.compressedSize;
+		pageOffset += chunk.originalSize;
+		if (pageOffset >= info->pages[page].originalSize)
+		{
+			++page;
+			pageOffset = 0;
+		}
 	}
 
-	if (info->compressionMode == CompressionMode::LZ4)
+	return ranges;
+}
+
+bool assets::UnpackTextureChunk(const TextureInfo* info, size_t chunkIndex, const char* source, char* destination)
+{
+	const TextureChunk& chunk = info->chunks[chunkIndex];
+
+	// Chunks that didn't compress well are stored as-is
+	if (info->compressionMode != CompressionMode::None && chunk.compressedSize != chunk.originalSize)
 	{
-		if (info->pages[pageIndex].compressedSize != info->pages[pageIndex].originalSize)
-			LZ4_decompress_safe(source, destination, info->pages[pageIndex].compressedSize, info->pages[pageIndex].originalSize);
-		else
-			std::memcpy(destination, source, info->pages[pageIndex].originalSize);
+		int decompressed = LZ4_decompress_safe(source, destination, chunk.compressedSize, chunk.originalSize);
+		if (decompressed != static_cast<int>(chunk.originalSize))
+		{
+			std::cout << "ERROR: Texture: LZ4 decode failed (" << decompressed << "), data is corrupt or truncated" << std::endl;
+			return false;
+		}
 	}
 	else
 	{
-		std::memcpy(destination, source, info->pages[pageIndex].originalSize);
+		std::memcpy(destination, source, chunk.originalSize);
 	}
+	return true;
 }
 
-assets::AssetFile assets::PackTexture(TextureInfo* info, void* pixelData)
+bool assets::UnpackTexture(TextureInfo* info, const char* sourceBuffer, size_t sourceSize, char* destination, uint32_t verify)
 {
-	constexpr CompressionMode compressMode = CompressionMode::LZ4;
-	constexpr char* compressModeName = "LZ4";
+	const char* source = sourceBuffer;
+	char* dest = destination;
+	for (size_t i = 0; i < info->chunks.size(); ++i)
+	{
+		const TextureChunk& chunk = info->chunks[i];
+		if (source + chunk.compressedSize > sourceBuffer + sourceSize)
+		{
+			std::cout << "ERROR: Texture: stored data is truncated" << std::endl;
+			return false;
+		}
+
+		if (!UnpackTextureChunk(info, i, source, dest))
+			return false;
+
+		source += chunk.compressedSize;
+		dest += chunk.originalSize;
+	}
+
+	if (verify & VerifyContent)
+		return CheckTextureContent(info, destination);
+
+	return true;
+}
+
+bool assets::UnpackTexturePage(TextureInfo* info, int pageIndex, const char* sourceBuffer, size_t sourceSize, char* destination)
+{
+	return UnpackTextureMips(info, pageIndex, 1, sourceBuffer, sourceSize, destination);
+}
+
+bool assets::UnpackTextureMips(const TextureInfo* info, uint32_t firstMip, uint32_t mipCount, const char* sourceBuffer, size_t sourceSize, char* destination)
+{
+	if (firstMip + mipCount > info->pageLocations.size())
+		return false;
+	if (mipCount == 0)
+		return true;
+
+	const PageLocation& first = info->pageLocations[firstMip];
+	const uint32_t last = firstMip + mipCount - 1;
+	if (info->pageLocations[last].blobOffset + info->pages[last].compressedSize > sourceSize)
+	{
+		std::cout << "ERROR: Texture: stored data is truncated" << std::endl;
+		return false;
+	}
+	const char* source = sourceBuffer + first.blobOffset;
+	char* dest = destination;
+
+	// The chunks of consecutive pages are consecutive too
+	const uint32_t chunkEnd = info->pageLocations[last].firstChunk + info->pageLocations[last].chunkCount;
+	for (uint32_t chunk = first.firstChunk; chunk < chunkEnd; ++chunk)
+	{
+		if (!UnpackTextureChunk(info, chunk, source, dest))
+			return false;
+
+		source += info->chunks[chunk].compressedSize;
+		dest += info->chunks[chunk].originalSize;
+	}
+
+	return true;
+}
+
+uint64_t assets::GetTextureMipsSize(const TextureInfo* info, uint32_t firstMip, uint32_t mipCount)
+{
+	uint64_t size = 0;
+	for (uint32_t i = firstMip; i < firstMip + mipCount && i < info->pages.size(); ++i)
+		size += info->pages[i].originalSize;
+	return size;
+}
+
+uint64_t assets::GetTextureBlobSize(const TextureInfo* info)
+{
+	if (info->pageLocations.empty())
+		return 0;
+	return info->pageLocations.back().blobOffset + info->pages.back().compressedSize;
+}
+
+bool assets::CheckTextureContent(const TextureInfo* info, const char* pixels)
+{
+	if (info->contentHash == 0)
+		return true;
+
+	// pixels holds the pages, so a dataSize that disagrees with them would hash the wrong bytes
+	if (info->dataSize != GetTextureMipsSize(info, 0, static_cast<uint32_t>(info->pages.size())))
+	{
+		std::cout << "ERROR: Texture: data size doesn't match the pages" << std::endl;
+		return false;
+	}
+
+	if (HashData(pixels, info->dataSize) != info->contentHash)
+	{
+		std::cout << "ERROR: Texture: content checksum mismatch" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+assets::AssetFile assets::PackTexture(TextureInfo* info, void* pixelData, const PackOptions& options)
+{
+	const CompressionMode compressMode = options.compression;
 
 	AssetFile file;
 	file.type[0] = 'T';
@@ -86,49 +335,112 @@ assets::AssetFile assets::PackTexture(TextureInfo* info, void* pixelData)
 	file.type[2] = 'T';
 	file.type[3] = 'R';
 	file.version = TEXTURE_ASSET_VERSION;
+	file.contentHash = HashData(pixelData, info->dataSize);
+
+	const char* pixels = reinterpret_cast<const char*>(pixelData);
+	info->chunks.clear();
+	info->pageLocations.clear();
 
-	char* pixels = reinterpret_cast<char*>(pixelData);
-	std::vector<char> pageBuffer;
+	// Pages are split into independent chunks of whole rows (of blocks, for BCn), so a loader can
+	// decode a page a piece at a time into a small staging area and copy each piece to the image as
+	// it lands. The top mip of anything large spans many chunks, so it compresses on many cores.
+	struct ChunkSource
+	{
+		uint64_t dataOffset;
+		uint64_t stagingOffset;		// Slot of CompressBound bytes in the staging buffer
+		uint32_t size;
+		bool stored;
+	};
+	std::vector<ChunkSource> sources;
+	uint64_t stagingSize = 0;
+	uint64_t dataOffset = 0;
 
 	for (auto& page : info->pages)
 	{
-		pageBuffer.resize(page.originalSize);
+		const uint32_t rows = std::max(1u, GetTextureBlockRows(info->textureFormat, page.height));
+		uint32_t rowPitch = page.originalSize / rows;
+		uint32_t rowsPerChunk = std::max(1u, rowPitch > 0 ? TEXTURE_CHUNK_SIZE / rowPitch : rows);
 
-		if (compressMode == CompressionMode::LZ4)
+		// Tiled pages get a chunk per tile instead
+		if (info->tileSize != 0)
 		{
-			int compressStaging = LZ4_compressBound(static_cast<int>(page.originalSize));
-			pageBuffer.resize(compressStaging);
-			int compressedSize = LZ4_compress_default(pixels, pageBuffer.data(), page.originalSize, compressStaging);
+			rowPitch = GetTextureTileBytes(info);
+			rowsPerChunk = 1;
+		}
 
-			float compressionRate = static_cast<float>(compressedSize) / static_cast<float>(info->dataSize);
+		PageLocation location{};
+		location.dataOffset = dataOffset;
+		location.firstChunk = static_cast<uint32_t>(sources.size());
 
-			if (compressionRate > 0.8)
-			{
-				compressedSize = page.originalSize;
-				pageBuffer.resize(compressedSize);
-				std::memcpy(pageBuffer.data(), pixels, compressedSize);
-			}
-			else
+		uint32_t pageOffset = 0;
+		while (pageOffset < page.originalSize)
+		{
+			const uint32_t size = std::min(page.originalSize - pageOffset, rowsPerChunk * rowPitch);
+			sources.push_back({ dataOffset + pageOffset, stagingSize, size, true });
+			if (compressMode != CompressionMode::None)
+				stagingSize += CompressBound(static_cast<int>(size));
+			pageOffset += size;
+		}
+
+		location.chunkCount = static_cast<uint32_t>(sources.size()) - location.firstChunk;
+		info->pageLocations.push_back(location);
+		dataOffset += page.originalSize;
+	}
+
+	std::vector<char> staging(stagingSize);
+	info->chunks.resize(sources.size());
+
+	ParallelFor(sources.size(), [&](size_t i)
+		{
+			ChunkSource& source = sources[i];
+
+			int compressedSize = 0;
+			if (compressMode != CompressionMode::None)
 			{
-				pageBuffer.resize(compressedSize);
+				const int compressStaging = CompressBound(static_cast<int>(source.size));
+				compressedSize = CompressBlock(options, pixels + source.dataOffset, static_cast<int>(source.size), staging.data() + source.stagingOffset, compressStaging);
 			}
 
-			page.compressedSize = compressedSize;
-			file.blob.insert(file.blob.end(), pageBuffer.begin(), pageBuffer.end());
+			// Stored as-is when uncompressed, or when it shrank too little to be worth decoding
+			const float compressionRate = static_cast<float>(compressedSize) / static_cast<float>(source.size);
+			source.stored = compressedSize <= 0 || compressionRate > 0.8f;
 
-			pixels += page.originalSize;
-		}
-		else
-		{
-			std::cout << "Invalid texture file compression mode: '" << compressModeName << "'" << std::endl;
-		}
+			info->chunks[i].compressedSize = source.stored ? source.size : static_cast<uint32_t>(compressedSize);
+			info->chunks[i].originalSize = source.size;
+		});
+
+	// Laid out back to back in one allocation, page by page
+	uint64_t blobSize = 0;
+	for (size_t p = 0; p < info->pages.size(); ++p)
+	{
+		PageLocation& location = info->pageLocations[p];
+		location.blobOffset = blobSize;
+
+		info->pages[p].compressedSize = 0;
+		for (uint32_t c = location.firstChunk; c < location.firstChunk + location.chunkCount; ++c)
+			info->pages[p].compressedSize += info->chunks[c].compressedSize;
+		blobSize += info->pages[p].compressedSize;
+	}
+
+	file.blob.resize(blobSize);
+	char* blob = file.blob.data();
+	for (size_t i = 0; i < sources.size(); ++i)
+	{
+		const ChunkSource& source = sources[i];
+		std::memcpy(blob, source.stored ? pixels + source.dataOffset : staging.data() + source.stagingOffset, info->chunks[i].compressedSize);
+		blob += info->chunks[i].compressedSize;
 	}
 
 	nlohmann::json textureMeta;
-	textureMeta["format"] = "RGBA8";
+	textureMeta["format"] = TextureFormatName(info->textureFormat);
 	textureMeta["bufferSize"] = info->dataSize;
 	textureMeta["sourceFile"] = info->sourceFile;
-	textureMeta["compression"] = compressModeName;
+	textureMeta["compression"] = CompressionName(compressMode);
+	if (info->tileSize != 0)
+	{
+		textureMeta["tileSize"] = info->tileSize;
+		textureMeta["tileBorder"] = info->tileBorder;
+	}
 
 	std::vector<nlohmann::json> pageJson;
 	for (auto& p : info->pages)
@@ -142,14 +454,212 @@ assets::AssetFile assets::PackTexture(TextureInfo* info, void* pixelData)
 	}
 	textureMeta["pages"] = pageJson;
 
+	std::vector<nlohmann::json> chunkJson;
+	for (auto& c : info->chunks)
+	{
+		nlohmann::json chunk;
+		chunk["compressedSize"] = c.compressedSize;
+		chunk["originalSize"] = c.originalSize;
+		chunkJson.push_back(chunk);
+	}
+	textureMeta["chunks"] = chunkJson;
+
 	file.json = textureMeta.dump();
 
+	TextureMeta meta{};
+	meta.size = sizeof(TextureMeta);
+	meta.textureFormat = info->textureFormat;
+	meta.compressionMode = compressMode;
+	meta.dataSize = info->dataSize;
+	meta.tileSize = info->tileSize;
+	meta.tileBorder = info->tileBorder;
+
+	MetaWriter metaWriter(sizeof(TextureMeta));
+	meta.sourceFile = metaWriter.AppendString(info->sourceFile);
+	meta.chunkSize = TEXTURE_CHUNK_SIZE;
+	meta.pages = metaWriter.AppendArray(info->pages.data(), info->pages.size());
+	meta.chunks = metaWriter.AppendArray(info->chunks.data(), info->chunks.size());
+	meta.pageLocations = metaWriter.AppendArray(info->pageLocations.data(), info->pageLocations.size());
+	file.meta = metaWriter.Finish(meta);
+
 	return file;
 }
 
+bool assets::IsTextureTiled(const TextureInfo* info)
+{
+	return info->tileSize != 0;
+}
+
+uint32_t assets::GetTextureTileColumns(const TextureInfo* info, uint32_t mip)
+{
+	return std::max(1u, (info->pages[mip].width + info->tileSize - 1) / info->tileSize);
+}
+
+uint32_t assets::GetTextureTileRows(const TextureInfo* info, uint32_t mip)
+{
+	return std::max(1u, (info->pages[mip].height + info->tileSize - 1) / info->tileSize);
+}
+
+uint32_t assets::GetTextureTileDim(const TextureInfo* info)
+{
+	return info->tileSize + info->tileBorder * 2;
+}
+
+uint32_t assets::GetTextureTileBytes(const TextureInfo* info)
+{
+	const uint32_t blocks = GetTextureTileDim(info) / GetTextureBlockDim(info->textureFormat);
+	return blocks * blocks * GetTextureBlockBytes(info->textureFormat);
+}
+
+uint32_t assets::GetTextureTileChunk(const TextureInfo* info, uint32_t mip, uint32_t x, uint32_t y)
+{
+	return info->pageLocations[mip].firstChunk + y * GetTextureTileColumns(info, mip) + x;
+}
+
+bool assets::TileTexture(TextureInfo* info, const char* pixels, std::vector<char>& tiled, uint32_t tileSize, uint32_t border)
+{
+	const uint32_t blockDim = GetTextureBlockDim(info->textureFormat);
+	const uint32_t blockBytes = GetTextureBlockBytes(info->textureFormat);
+	if (blockBytes == 0 || tileSize == 0 || tileSize % blockDim != 0 || border % blockDim != 0)
+	{
+		std::cout << "ERROR: Texture: tiles of " << tileSize << " with a border of " << border << " don't fit " << TextureFormatName(info->textureFormat) << " blocks" << std::endl;
+		return false;
+	}
+
+	info->tileSize = tileSize;
+	info->tileBorder = border;
+
+	const uint32_t tileBlocks = tileSize / blockDim;
+	const uint32_t borderBlocks = border / blockDim;
+	const uint32_t tileDimBlocks = GetTextureTileDim(info) / blockDim;
+	const uint32_t tileBytes = GetTextureTileBytes(info);
+
+	uint64_t tiledSize = 0;
+	for (uint32_t mip = 0; mip < info->pages.size(); ++mip)
+		tiledSize += static_cast<uint64_t>(GetTextureTileColumns(info, mip)) * GetTextureTileRows(info, mip) * tileBytes;
+	tiled.resize(tiledSize);
+
+	const char* source = pixels;
+	char* destination = tiled.data();
+	for (uint32_t mip = 0; mip < info->pages.size(); ++mip)
+	{
+		PageInfo& page = info->pages[mip];
+		const int32_t blocksX = static_cast<int32_t>((page.width + blockDim - 1) / blockDim);
+		const int32_t blocksY = static_cast<int32_t>(GetTextureBlockRows(info->textureFormat, page.height));
+		const size_t rowPitch = static_cast<size_t>(blocksX) * blockBytes;
+		const uint32_t columns = GetTextureTileColumns(info, mip);
+		const uint32_t rows = GetTextureTileRows(info, mip);
+
+		ParallelFor(static_cast<size_t>(columns) * rows, [&](size_t tile)
+			{
+				const int32_t firstX = static_cast<int32_t>((tile % columns) * tileBlocks) - static_cast<int32_t>(borderBlocks);
+				const int32_t firstY = static_cast<int32_t>((tile / columns) * tileBlocks) - static_cast<int32_t>(borderBlocks);
+				char* out = destination + tile * tileBytes;
+
+				// Blocks outside the mip repeat its edge; the run in between is one copy
+				const int32_t insideBegin = std::min(std::max(0, -firstX), static_cast<int32_t>(tileDimBlocks));
+				const int32_t insideEnd = std::max(insideBegin, std::min(static_cast<int32_t>(tileDimBlocks), blocksX - firstX));
+				for (uint32_t y = 0; y < tileDimBlocks; ++y)
+				{
+					const int32_t sourceY = std::min(std::max(firstY + static_cast<int32_t>(y), 0), blocksY - 1);
+					const char* row = source + sourceY * rowPitch;
+					for (int32_t x = 0; x < static_cast<int32_t>(tileDimBlocks); ++x)
+					{
+						if (x == insideBegin && insideEnd > insideBegin)
+						{
+							std::memcpy(out, row + (firstX + x) * blockBytes, static_cast<size_t>(insideEnd - insideBegin) * blockBytes);
+							out += static_cast<size_t>(insideEnd - insideBegin) * blockBytes;
+							x = insideEnd - 1;
+							continue;
+						}
+
+						const int32_t sourceX = std::min(std::max(firstX + x, 0), blocksX - 1);
+						std::memcpy(out, row + sourceX * blockBytes, blockBytes);
+						out += blockBytes;
+					}
+				}
+			});
+
+		source += page.originalSize;
+		destination += static_cast<size_t>(columns) * rows * tileBytes;
+		page.originalSize = columns * rows * tileBytes;
+		page.compressedSize = 0;
+	}
+
+	info->dataSize = tiledSize;
+	return true;
+}
+
+uint32_t assets::GetTextureBlockDim(TextureFormat format)
+{
+	return IsBlockCompressed(format) ? 4 : 1;
+}
+
+uint32_t assets::GetTextureBlockBytes(TextureFormat format)
+{
+	switch (format)
+	{
+	case TextureFormat::RGBA8:
+		return 4;
+	case TextureFormat::BC1:
+	case TextureFormat::BC4:
+		return 8;
+	case TextureFormat::BC3:
+	case TextureFormat::BC5:
+	case TextureFormat::BC7:
+		return 16;
+	default:
+		return 0;
+	}
+}
+
+uint32_t assets::GetTextureBlockRows(TextureFormat format, uint32_t height)
+{
+	const uint32_t blockDim = GetTextureBlockDim(format);
+	return (height + blockDim - 1) / blockDim;
+}
+
+uint64_t assets::GetTextureMipSize(TextureFormat format, uint32_t width, uint32_t height)
+{
+	const uint32_t blockDim = GetTextureBlockDim(format);
+	const uint64_t blocksWide = (width + blockDim - 1) / blockDim;
+	return blocksWide * GetTextureBlockRows(format, height) * GetTextureBlockBytes(format);
+}
+
+bool assets::IsBlockCompressed(TextureFormat format)
+{
+	return format == TextureFormat::BC1 || format == TextureFormat::BC3 || format == TextureFormat::BC4
+		|| format == TextureFormat::BC5 || format == TextureFormat::BC7;
+}
+
 assets::TextureFormat assets::ParseTextureFormat(const char* string)
 {
-	if (strcmp(string, "RGBA8") == 0)
-		return TextureFormat::RGBA8;
+	const TextureFormat formats[] = { TextureFormat::RGBA8, TextureFormat::BC1, TextureFormat::BC3, TextureFormat::BC4, TextureFormat::BC5, TextureFormat::BC7 };
+	for (TextureFormat format : formats)
+	{
+		if (strcmp(string, TextureFormatName(format)) == 0)
+			return format;
+	}
 	return TextureFormat::Unknown;
+}
+
+const char* assets::TextureFormatName(TextureFormat format)
+{
+	switch (format)
+	{
+	case TextureFormat::RGBA8:
+		return "RGBA8";
+	case TextureFormat::BC1:
+		return "BC1";
+	case TextureFormat::BC3:
+		return "BC3";
+	case TextureFormat::BC4:
+		return "BC4";
+	case TextureFormat::BC5:
+		return "BC5";
+	case TextureFormat::BC7:
+		return "BC7";
+	default:
+		return "Unknown";
+	}
 }
\ No newline at end of file
@@ -7,9 +7,24 @@ namespace assets
 	enum class TextureFormat : uint32_t
 	{
 		Unknown = 0,
-		RGBA8
+		RGBA8,
+		BC1,	// RGB, 8 bytes per 4x4 block
+		BC3,	// RGBA, a BC4 block for alpha then a BC1 block for colour
+		BC4,	// Red only, 8 bytes per block
+		BC5,	// Red and green as two BC4 blocks
+		BC7,	// RGBA, 16 bytes per block
 	};
 
+	// Texels along each side of a format's blocks, 1 for uncompressed formats
+	uint32_t GetTextureBlockDim(TextureFormat format);
+	// Bytes per block, or per texel for uncompressed formats
+	uint32_t GetTextureBlockBytes(TextureFormat format);
+	// Rows of blocks in a mip of the given height
+	uint32_t GetTextureBlockRows(TextureFormat format, uint32_t height);
+	// Bytes in a width x height mip, counting blocks that hang off the edges in full
+	uint64_t GetTextureMipSize(TextureFormat format, uint32_t width, uint32_t height);
+	bool IsBlockCompressed(TextureFormat format);
+
 	struct PageInfo
 	{
 		uint32_t width;
@@ -18,6 +33,42 @@ namespace assets
 		uint32_t originalSize;
 	};
 
+	// Uncompressed bytes per page chunk, rounded down to whole rows (of blocks, for BCn). Chunks can
+	// be decoded and uploaded one at a time, so this also bounds the staging memory a streamed load needs.
+	constexpr uint32_t TEXTURE_CHUNK_SIZE = 1024 * 1024;
+
+	// A page's chunks are stored back to back and always cover whole rows. A chunk that didn't
+	// compress is stored as-is, with compressedSize == originalSize.
+	struct TextureChunk
+	{
+		uint32_t compressedSize;
+		uint32_t originalSize;
+	};
+
+	// Tiled layout, for textures too large to keep every mip resident. Each mip is cut into
+	// tileSize x tileSize tiles, stored row by row as one chunk each, so any tile can be read and
+	// decoded on its own. Tiles carry a border of texels copied from their neighbours (repeating
+	// the edge at the image's edges), so filtering near a tile's edge never reaches another tile.
+	constexpr uint32_t TEXTURE_TILE_SIZE = 128;
+	constexpr uint32_t TEXTURE_TILE_BORDER = 4;		// A whole block each side for BCn
+
+	// Where one chunk lives, for decoding a texture a piece at a time
+	struct TextureChunkRange
+	{
+		uint32_t page;
+		uint32_t pageOffset;	// Uncompressed bytes into the page
+		uint64_t blobOffset;
+	};
+
+	// Where a page starts, so any mip can be reached without walking the pages before it
+	struct PageLocation
+	{
+		uint64_t blobOffset;	// Compressed bytes into the blob
+		uint64_t dataOffset;	// Uncompressed bytes into the whole texture
+		uint32_t firstChunk;
+		uint32_t chunkCount;
+	};
+
 	struct TextureInfo
 	{
 		uint64_t dataSize;
@@ -25,11 +76,66 @@ namespace assets
  		CompressionMode compressionMode;
 		std::string sourceFile;
 		std::vector<PageInfo> pages;
+		std::vector<TextureChunk> chunks;	// One per page for files cooked before chunking
+		std::vector<PageLocation> pageLocations;	// Derived on load for files that don't store it
+		uint64_t contentHash;	// From the asset header, 0 if the file has none
+		uint32_t tileSize{ 0 };		// 0 for the linear layout, where pages hold whole mips
+		uint32_t tileBorder{ 0 };
+	};
+
+	// Fixed-layout binary form of TextureInfo, stored little-endian in the asset's metadata section
+	struct TextureMeta
+	{
+		uint32_t size;
+		TextureFormat textureFormat;
+		CompressionMode compressionMode;
+		uint32_t chunkSize;
+		uint64_t dataSize;
+		MetaRange sourceFile;
+		MetaRange pages;		// PageInfo[]
+		MetaRange chunks;		// TextureChunk[]
+		MetaRange pageLocations;	// PageLocation[]
+		uint32_t tileSize;		// 0 in files written before tiling
+		uint32_t tileBorder;
 	};
+	static_assert(sizeof(TextureMeta) == 64, "TextureMeta layout is part of the file format");
+	static_assert(sizeof(TextureChunk) == 8, "TextureChunk layout is part of the file format");
+	static_assert(sizeof(PageInfo) == 16, "PageInfo layout is part of the file format");
+	static_assert(sizeof(PageLocation) == 24, "PageLocation layout is part of the file format");
+
+	// False, with an error printed, when the metadata is corrupt; info is then not usable
+	bool ReadTextureInfo(AssetFile* file, TextureInfo& info);
+	bool ReadTextureInfo(const AssetView* view, TextureInfo& info);
+	bool UnpackTexture(TextureInfo* info, const char* sourceBuffer, size_t sourceSize, char* destination, uint32_t verify = VerifyNone);
+	bool UnpackTexturePage(TextureInfo* info, int pageIndex, const char* sourceBuffer, size_t sourceSize, char* destination);
+	// Decodes mips firstMip .. firstMip + mipCount - 1 back to back into destination, skipping the rest
+	bool UnpackTextureMips(const TextureInfo* info, uint32_t firstMip, uint32_t mipCount, const char* sourceBuffer, size_t sourceSize, char* destination);
+	// Uncompressed size of a mip range, for sizing the destination of UnpackTextureMips
+	uint64_t GetTextureMipsSize(const TextureInfo* info, uint32_t firstMip, uint32_t mipCount);
+	// Decodes one chunk from just its own compressed bytes
+	bool UnpackTextureChunk(const TextureInfo* info, size_t chunkIndex, const char* source, char* destination);
+	std::vector<TextureChunkRange> GetTextureChunkRanges(const TextureInfo* info);
+	// Compressed bytes the page table says the blob holds; check it against the real blob size
+	// before reading chunks straight from a file, since the metadata isn't covered by the blob hash
+	uint64_t GetTextureBlobSize(const TextureInfo* info);
+	// Checks a fully unpacked texture (all pages, contiguous) against the stored content hash
+	bool CheckTextureContent(const TextureInfo* info, const char* pixels);
+	AssetFile PackTexture(TextureInfo* info, void* pixelData, const PackOptions& options = {});
+
+	bool IsTextureTiled(const TextureInfo* info);
+	// Tiles across and down one mip of a tiled texture
+	uint32_t GetTextureTileColumns(const TextureInfo* info, uint32_t mip);
+	uint32_t GetTextureTileRows(const TextureInfo* info, uint32_t mip);
+	// Texels along each side of a stored tile, borders included
+	uint32_t GetTextureTileDim(const TextureInfo* info);
+	uint32_t GetTextureTileBytes(const TextureInfo* info);
+	// Chunk holding tile (x, y) of a mip; decode it with UnpackTextureChunk
+	uint32_t GetTextureTileChunk(const TextureInfo* info, uint32_t mip, uint32_t x, uint32_t y);
+	// Cuts a linear mip chain, laid out as PackTexture takes it, into tiles and points info's
+	// pages, dataSize and tile fields at the result. Works on whole blocks, so tileSize and border
+	// have to be multiples of the format's block size.
+	bool TileTexture(TextureInfo* info, const char* pixels, std::vector<char>& tiled, uint32_t tileSize = TEXTURE_TILE_SIZE, uint32_t border = TEXTURE_TILE_BORDER);
 
-	TextureInfo ReadTextureInfo(AssetFile* file);
-	void UnpackTexture(TextureInfo* info, const char* sourceBuffer, size_t sourceSize, char* destination);
-	void UnpackTexturePage(TextureInfo* info, int pageIndex, char* sourceBuffer, char* destination);
-	AssetFile PackTexture(TextureInfo* info, void* pixelData);
 	TextureFormat ParseTextureFormat(const char* string);
+	const char* TextureFormatName(TextureFormat format);
 };
\ No newline at end of file
@@ -0,0 +1,442 @@
+#include "texture_mips.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include "asset_parallel.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TEXTURE_MIPS_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+#define TEXTURE_MIPS_AVX2
+#include <immintrin.h>
+#endif
+
+
+namespace
+{
+	using namespace assets;
+
+	// Rows of a new level handed to a thread at a time, so small levels don't pay more in
+	// scheduling than in work
+	constexpr uint32_t ROWS_PER_JOB = 32;
+
+	// Kaiser window shape, as nvtt uses for its Kaiser filter
+	constexpr float KAISER_ALPHA = 4.0f;
+	constexpr float FILTER_WIDTH = 3.0f;
+
+	// Linear values are looked up in this many buckets, each narrower than the gap between any two
+	// sRGB codes, so a bucket's code is right or one short
+	constexpr int SRGB_BUCKETS = 4096;
+
+	constexpr float PI = 3.14159265358979f;
+
+	struct SrgbTables
+	{
+		float toLinear[256];
+		float thresholds[257];		// Lowest linear value that rounds to each code; 256 is past the end
+		uint8_t bucketCodes[SRGB_BUCKETS + 1];
+
+		SrgbTables()
+		{
+			auto decode = [](double v) { return v <= 0.04045 ? v / 12.92 : std::pow((v + 0.055) / 1.055, 2.4); };
+
+			for (int i = 0; i < 256; ++i)
+				toLinear[i] = static_cast<float>(decode(i / 255.0));
+
+			thresholds[0] = 0.0f;
+			for (int i = 1; i < 256; ++i)
+				thresholds[i] = static_cast<float>(decode((i - 0.5) / 255.0));
+			thresholds[256] = 2.0f;
+
+			int code = 0;
+			for (int b = 0; b <= SRGB_BUCKETS; ++b)
+			{
+				const float start = static_cast<float>(b) / SRGB_BUCKETS;
+				while (code < 255 && thresholds[code + 1] <= start)
+					++code;
+				bucketCodes[b] = static_cast<uint8_t>(code);
+			}
+		}
+	};
+
+	const SrgbTables& GetSrgbTables()
+	{
+		static const SrgbTables tables;
+		return tables;
+	}
+
+	// value must already be clamped to [0, 1]
+	uint8_t LinearToSrgb8(const SrgbTables& tables, float value)
+	{
+		const uint8_t code = tables.bucketCodes[static_cast<int>(value * SRGB_BUCKETS)];
+		return static_cast<uint8_t>(code + (value >= tables.thresholds[code + 1] ? 1 : 0));
+	}
+
+	float Sinc(float x)
+	{
+		if (std::fabs(x) < 1e-6f)
+			return 1.0f;
+		return std::sin(PI * x) / (PI * x);
+	}
+
+	float BesselI0(float x)
+	{
+		float sum = 1.0f;
+		float term = 1.0f;
+		for (int k = 1; k < 32; ++k)
+		{
+			const float half = x / (2.0f * k);
+			term *= half * half;
+			sum += term;
+			if (term < sum * 1e-8f)
+				break;
+		}
+		return sum;
+	}
+
+	// Texels either side of the center the filter reaches, measured in texels of the smaller level
+	float FilterSupport(MipFilter filter)
+	{
+		return (filter == MipFilter::Box) ? 0.5f : FILTER_WIDTH;
+	}
+
+	float FilterWeight(MipFilter filter, float t)
+	{
+		t = std::fabs(t);
+		switch (filter)
+		{
+		case MipFilter::Box:
+			return (t < 0.5f) ? 1.0f : 0.0f;
+		case MipFilter::Kaiser:
+		{
+			if (t >= FILTER_WIDTH)
+				return 0.0f;
+			const float r = t / FILTER_WIDTH;
+			return Sinc(t) * BesselI0(KAISER_ALPHA * std::sqrt(1.0f - r * r)) / BesselI0(KAISER_ALPHA);
+		}
+		case MipFilter::Lanczos:
+			return (t < FILTER_WIDTH) ? Sinc(t) * Sinc(t / FILTER_WIDTH) : 0.0f;
+		default:
+			return 0.0f;
+		}
+	}
+
+	// The source texels (clamped to the edge) and normalized weights for every texel of the smaller
+	// level along one axis, tapCount of each per texel. Odd sizes give each texel its own phase.
+	struct FilterTaps
+	{
+		uint32_t tapCount{ 0 };
+		std::vector<uint32_t> indices;
+		std::vector<float> weights;
+	};
+
+	FilterTaps BuildTaps(MipFilter filter, uint32_t sourceSize, uint32_t size)
+	{
+		const float scale = static_cast<float>(sourceSize) / size;
+		const float support = FilterSupport(filter) * scale;
+
+		auto firstTap = [&](uint32_t i) { return static_cast<int>(std::ceil((i + 0.5f) * scale - support - 0.5f)); };
+		auto lastTap = [&](uint32_t i) { return static_cast<int>(std::floor((i + 0.5f) * scale + support - 0.5f)); };
+
+		FilterTaps taps;
+		for (uint32_t i = 0; i < size; ++i)
+			taps.tapCount = std::max(taps.tapCount, static_cast<uint32_t>(lastTap(i) - firstTap(i) + 1));
+
+		taps.indices.resize(static_cast<size_t>(size) * taps.tapCount);
+		taps.weights.resize(static_cast<size_t>(size) * taps.tapCount);
+		for (uint32_t i = 0; i < size; ++i)
+		{
+			const float center = (i + 0.5f) * scale;
+			const int first = firstTap(i);
+			uint32_t* indices = &taps.indices[static_cast<size_t>(i) * taps.tapCount];
+			float* weights = &taps.weights[static_cast<size_t>(i) * taps.tapCount];
+
+			float total = 0.0f;
+			for (uint32_t k = 0; k < taps.tapCount; ++k)
+			{
+				const int source = first + static_cast<int>(k);
+				indices[k] = static_cast<uint32_t>(std::clamp(source, 0, static_cast<int>(sourceSize) - 1));
+				weights[k] = (source <= lastTap(i)) ? FilterWeight(filter, (source + 0.5f - center) / scale) : 0.0f;
+				total += weights[k];
+			}
+			for (uint32_t k = 0; k < taps.tapCount; ++k)
+				weights[k] /= total;
+		}
+		return taps;
+	}
+
+	// Horizontal pass over one row, from source texels to taps-sized rows, four floats per texel
+	void FilterRowScalar(const float* source, const FilterTaps& taps, size_t size, float* destination)
+	{
+		for (size_t x = 0; x < size; ++x)
+		{
+			const uint32_t* indices = &taps.indices[x * taps.tapCount];
+			const float* weights = &taps.weights[x * taps.tapCount];
+
+			float sum[4] = {};
+			for (uint32_t k = 0; k < taps.tapCount; ++k)
+			{
+				for (int c = 0; c < 4; ++c)
+					sum[c] += source[indices[k] * 4 + c] * weights[k];
+			}
+			std::memcpy(destination + x * 4, sum, sizeof(sum));
+		}
+	}
+
+	// Vertical pass for destination row y, from floatCount-wide rows starting at source row firstSource
+	void FilterColumnScalar(const float* source, uint32_t firstSource, size_t floatCount, const FilterTaps& taps, size_t y, float* destination)
+	{
+		const uint32_t* indices = &taps.indices[y * taps.tapCount];
+		const float* weights = &taps.weights[y * taps.tapCount];
+
+		for (size_t i = 0; i < floatCount; ++i)
+		{
+			float sum = 0.0f;
+			for (uint32_t k = 0; k < taps.tapCount; ++k)
+				sum += source[(indices[k] - firstSource) * floatCount + i] * weights[k];
+			destination[i] = sum;
+		}
+	}
+
+#ifdef TEXTURE_MIPS_SSE2
+	// One texel per register, so every tap is a single load and multiply-add
+	void FilterRow(const float* source, const FilterTaps& taps, size_t size, float* destination)
+	{
+		for (size_t x = 0; x < size; ++x)
+		{
+			const uint32_t* indices = &taps.indices[x * taps.tapCount];
+			const float* weights = &taps.weights[x * taps.tapCount];
+
+			__m128 sum = _mm_setzero_ps();
+			for (uint32_t k = 0; k < taps.tapCount; ++k)
+				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(source + indices[k] * 4), _mm_set1_ps(weights[k])));
+			_mm_storeu_ps(destination + x * 4, sum);
+		}
+	}
+
+	void FilterColumn(const float* source, uint32_t firstSource, size_t floatCount, const FilterTaps& taps, size_t y, float* destination)
+	{
+		const uint32_t* indices = &taps.indices[y * taps.tapCount];
+		const float* weights = &taps.weights[y * taps.tapCount];
+
+		// Rows are whole texels, so always a multiple of four floats
+		size_t i = 0;
+#ifdef TEXTURE_MIPS_AVX2
+		for (; i + 8 <= floatCount; i += 8)
+		{
+			__m256 sum = _mm256_setzero_ps();
+			for (uint32_t k = 0; k < taps.tapCount; ++k)
+				sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_loadu_ps(source + (indices[k] - firstSource) * floatCount + i), _mm256_set1_ps(weights[k])));
+			_mm256_storeu_ps(destination + i, sum);
+		}
+#endif
+		for (; i < floatCount; i += 4)
+		{
+			__m128 sum = _mm_setzero_ps();
+			for (uint32_t k = 0; k < taps.tapCount; ++k)
+				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(source + (indices[k] - firstSource) * floatCount + i), _mm_set1_ps(weights[k])));
+			_mm_storeu_ps(destination + i, sum);
+		}
+	}
+#else
+	void FilterRow(const float* source, const FilterTaps& taps, size_t size, float* destination)
+	{
+		FilterRowScalar(source, taps, size, destination);
+	}
+
+	void FilterColumn(const float* source, uint32_t firstSource, size_t floatCount, const FilterTaps& taps, size_t y, float* destination)
+	{
+		FilterColumnScalar(source, firstSource, floatCount, taps, y, destination);
+	}
+#endif
+
+	uint8_t LinearToUnorm8(float value)
+	{
+		return static_cast<uint8_t>(value * 255.0f + 0.5f);
+	}
+
+	// RGBA8 texels into linear floats
+	void LoadTexels(const uint8_t* pixels, size_t count, bool srgb, float* texels)
+	{
+		const SrgbTables& tables = GetSrgbTables();
+		for (size_t i = 0; i < count; ++i, pixels += 4, texels += 4)
+		{
+			for (int c = 0; c < 3; ++c)
+				texels[c] = srgb ? tables.toLinear[pixels[c]] : pixels[c] / 255.0f;
+			texels[3] = pixels[3] / 255.0f;
+		}
+	}
+
+	// Clamps the filtered texels in place, since the next level is built from them, and writes
+	// them out as RGBA8
+	void StoreTexels(float* texels, size_t count, bool srgb, uint8_t* output)
+	{
+		const SrgbTables& tables = GetSrgbTables();
+		for (size_t i = 0; i < count; ++i, texels += 4, output += 4)
+		{
+			for (int c = 0; c < 4; ++c)
+				texels[c] = std::min(std::max(texels[c], 0.0f), 1.0f);
+			for (int c = 0; c < 3; ++c)
+				output[c] = srgb ? LinearToSrgb8(tables, texels[c]) : LinearToUnorm8(texels[c]);
+			output[3] = LinearToUnorm8(texels[3]);
+		}
+	}
+
+	// The level a new one is filtered from: the linear texels kept from the last level, or for the
+	// top level the image itself, converted a row at a time so it never has to exist as floats
+	struct LevelSource
+	{
+		const float* texels;
+		const uint8_t* pixels;
+		uint32_t width;
+		bool srgb;
+	};
+
+	// Rows [firstRow, lastRow) of a new level. Only the source rows their taps reach are filtered
+	// horizontally, into scratch space that stays small and warm; bands overlap by the filter's
+	// reach, so wider filters redo a few rows.
+	template<bool Vectorized>
+	void FilterBand(const LevelSource& source, const FilterTaps& horizontal, const FilterTaps& vertical, uint32_t width, size_t firstRow, size_t lastRow, float* destination)
+	{
+		thread_local std::vector<float> converted;
+		thread_local std::vector<float> rows;
+
+		uint32_t firstSource = ~0u;
+		uint32_t lastSource = 0;
+		for (size_t i = firstRow * vertical.tapCount; i < lastRow * vertical.tapCount; ++i)
+		{
+			firstSource = std::min(firstSource, vertical.indices[i]);
+			lastSource = std::max(lastSource, vertical.indices[i]);
+		}
+
+		const size_t floatCount = static_cast<size_t>(width) * 4;
+		rows.resize((lastSource - firstSource + 1) * floatCount);
+		converted.resize(static_cast<size_t>(source.width) * 4);
+
+		for (uint32_t y = firstSource; y <= lastSource; ++y)
+		{
+			const float* row = source.texels + static_cast<size_t>(y) * source.width * 4;
+			if (source.texels == nullptr)
+			{
+				LoadTexels(source.pixels + static_cast<size_t>(y) * source.width * 4, source.width, source.srgb, converted.data());
+				row = converted.data();
+			}
+
+			float* out = rows.data() + (y - firstSource) * floatCount;
+			if (Vectorized)
+				FilterRow(row, horizontal, width, out);
+			else
+				FilterRowScalar(row, horizontal, width, out);
+		}
+
+		for (size_t y = firstRow; y < lastRow; ++y)
+		{
+			if (Vectorized)
+				FilterColumn(rows.data(), firstSource, floatCount, vertical, y, destination + y * floatCount);
+			else
+				FilterColumnScalar(rows.data(), firstSource, floatCount, vertical, y, destination + y * floatCount);
+		}
+	}
+
+	template<bool Vectorized>
+	std::vector<MipLevel> BuildChain(const uint8_t* pixels, uint32_t width, uint32_t height, MipFilter filter, bool srgb, std::vector<uint8_t>& chain)
+	{
+		std::vector<MipLevel> levels;
+		size_t chainSize = 0;
+		for (uint32_t w = width, h = height; ; w = std::max(1u, w / 2), h = std::max(1u, h / 2))
+		{
+			levels.push_back({ w, h, chainSize });
+			chainSize += static_cast<size_t>(w) * h * 4;
+			if (w == 1 && h == 1)
+				break;
+		}
+
+		chain.resize(chainSize);
+		std::memcpy(chain.data(), pixels, static_cast<size_t>(width) * height * 4);
+
+		std::vector<float> current;
+		std::vector<float> next;
+		for (size_t level = 1; level < levels.size(); ++level)
+		{
+			const MipLevel& above = levels[level - 1];
+			const MipLevel& mip = levels[level];
+			const FilterTaps horizontal = BuildTaps(filter, above.width, mip.width);
+			const FilterTaps vertical = BuildTaps(filter, above.height, mip.height);
+			const LevelSource source{ (level > 1) ? current.data() : nullptr, pixels, above.width, srgb };
+
+			next.resize(static_cast<size_t>(mip.width) * mip.height * 4);
+			ParallelFor((mip.height + ROWS_PER_JOB - 1) / ROWS_PER_JOB, [&](size_t job)
+				{
+					const size_t firstRow = job * ROWS_PER_JOB;
+					const size_t lastRow = std::min<size_t>(firstRow + ROWS_PER_JOB, mip.height);
+					const size_t floatCount = static_cast<size_t>(mip.width) * 4;
+
+					FilterBand<Vectorized>(source, horizontal, vertical, mip.width, firstRow, lastRow, next.data());
+					StoreTexels(next.data() + firstRow * floatCount, (lastRow - firstRow) * mip.width, srgb, chain.data() + mip.offset + firstRow * floatCount);
+				});
+
+			current.swap(next);
+		}
+
+		return levels;
+	}
+}
+
+
+const char* assets::GetMipKernelPath()
+{
+#if defined(TEXTURE_MIPS_AVX2)
+	return "AVX2";
+#elif defined(TEXTURE_MIPS_SSE2)
+	return "SSE2";
+#else
+	return "scalar";
+#endif
+}
+
+std::vector<assets::MipLevel> assets::GenerateMipChain(const uint8_t* pixels, uint32_t width, uint32_t height, MipFilter filter, bool srgb, std::vector<uint8_t>& chain)
+{
+	return BuildChain<true>(pixels, width, height, filter, srgb, chain);
+}
+
+std::vector<assets::MipLevel> assets::GenerateMipChainScalar(const uint8_t* pixels, uint32_t width, uint32_t height, MipFilter filter, bool srgb, std::vector<uint8_t>& chain)
+{
+	return BuildChain<false>(pixels, width, height, filter, srgb, chain);
+}
+
+bool assets::ParseMipFilter(const char* string, MipFilter& filter)
+{
+	for (MipFilter candidate : { MipFilter::Box, MipFilter::Kaiser, MipFilter::Lanczos })
+	{
+		const char* name = MipFilterName(candidate);
+		size_t i = 0;
+		while (name[i] != '\0' && std::tolower(static_cast<unsigned char>(string[i])) == std::tolower(static_cast<unsigned char>(name[i])))
+			++i;
+		if (name[i] == '\0' && string[i] == '\0')
+		{
+			filter = candidate;
+			return true;
+		}
+	}
+	return false;
+}
+
+const char* assets::MipFilterName(MipFilter filter)
+{
+	switch (filter)
+	{
+	case MipFilter::Box:
+		return "Box";
+	case MipFilter::Kaiser:
+		return "Kaiser";
+	case MipFilter::Lanczos:
+		return "Lanczos";
+	default:
+		return "Unknown";
+	}
+}
\ No newline at end of file
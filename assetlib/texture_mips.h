@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Mip chains for RGBA8 images. Each level is filtered from the one above it in floating point, in
+// linear light for sRGB images, and only rounded to 8 bits on output. The filters are separable and
+// run across all cores a band of rows at a time; both passes use SSE2 wherever it's available (all
+// x64 builds), and the vertical one goes 8 wide when the library is built with AVX2 (ASSETLIB_AVX2).
+namespace assets
+{
+	enum class MipFilter : uint32_t
+	{
+		Box,		// Average of the texels underneath; soft, and cheapest
+		Kaiser,		// Kaiser-windowed sinc, 3 texels of the smaller level each side; sharp with little ringing
+		Lanczos,	// Lanczos3; a little sharper again, with a little more ringing at hard edges
+	};
+
+	struct MipLevel
+	{
+		uint32_t width;
+		uint32_t height;
+		size_t offset;		// Bytes into the chain
+	};
+
+	// "AVX2", "SSE2" or "scalar", whichever the filter kernels were compiled with
+	const char* GetMipKernelPath();
+
+	// Writes every level of a width x height RGBA8 image into chain, top first and each level half
+	// the size of the last (rounded down) until 1x1. The top level is copied unchanged. With srgb the
+	// colour channels are treated as sRGB-encoded and filtered in linear light; alpha never is.
+	std::vector<MipLevel> GenerateMipChain(const uint8_t* pixels, uint32_t width, uint32_t height, MipFilter filter, bool srgb, std::vector<uint8_t>& chain);
+
+	// Plain version of the above, which the vectorized one must match
+	std::vector<MipLevel> GenerateMipChainScalar(const uint8_t* pixels, uint32_t width, uint32_t height, MipFilter filter, bool srgb, std::vector<uint8_t>& chain);
+
+	// Accepts the names MipFilterName gives, in any case; false for anything else
+	bool ParseMipFilter(const char* string, MipFilter& filter);
+	const char* MipFilterName(MipFilter filter);
+}
\ No newline at end of file
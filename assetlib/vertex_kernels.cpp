@@ -0,0 +1,559 @@
+#include "vertex_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VERTEX_KERNELS_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+#define VERTEX_KERNELS_AVX2
+#include <immintrin.h>
+#endif
+
+
+namespace
+{
+	template<typename T>
+	T* Stride(T* base, size_t stride, size_t index)
+	{
+		using Byte = typename std::conditional<std::is_const<T>::value, const char, char>::type;
+		return reinterpret_cast<T*>(reinterpret_cast<Byte*>(base) + stride * index);
+	}
+
+	// Same rounding as the cooker uses for colors
+	uint8_t UnitToUnorm8(float value)
+	{
+		return static_cast<uint8_t>(std::min(std::max(value, 0.0f), 1.0f) * 255.0f + 0.5f);
+	}
+
+	void OctEncode(const float n[3], uint8_t encoded[2])
+	{
+		const float length = std::fabs(n[0]) + std::fabs(n[1]) + std::fabs(n[2]);
+		if (length == 0.0f)
+		{
+			encoded[0] = encoded[1] = 128;
+			return;
+		}
+
+		float x = n[0] / length;
+		float y = n[1] / length;
+		if (n[2] < 0.0f)
+		{
+			const float wrappedX = (1.0f - std::fabs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+			const float wrappedY = (1.0f - std::fabs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+			x = wrappedX;
+			y = wrappedY;
+		}
+
+		encoded[0] = UnitToUnorm8(x * 0.5f + 0.5f);
+		encoded[1] = UnitToUnorm8(y * 0.5f + 0.5f);
+	}
+
+	void OctDecode(const uint8_t encoded[2], float n[3])
+	{
+		const float x = static_cast<float>(encoded[0]) * (2.0f / 255.0f) - 1.0f;
+		const float y = static_cast<float>(encoded[1]) * (2.0f / 255.0f) - 1.0f;
+		const float z = (1.0f - std::fabs(x)) - std::fabs(y);
+
+		// Unfold the lower hemisphere
+		const float t = std::min(std::max(-z, 0.0f), 1.0f);
+		n[0] = x + (x >= 0.0f ? -t : t);
+		n[1] = y + (y >= 0.0f ? -t : t);
+		n[2] = z;
+
+		const float scale = 1.0f / std::sqrt((n[0] * n[0] + n[1] * n[1]) + n[2] * n[2]);
+		n[0] *= scale;
+		n[1] *= scale;
+		n[2] *= scale;
+	}
+
+	void QuantizeSetup(const assets::MeshBounds& bounds, float minimum[3], float scale[3])
+	{
+		for (int k = 0; k < 3; ++k)
+		{
+			minimum[k] = bounds.origin[k] - bounds.extents[k];
+			scale[k] = (bounds.extents[k] > 0.0f) ? 65535.0f / (bounds.extents[k] * 2.0f) : 0.0f;
+		}
+	}
+
+	void SetBoxFromMinMax(assets::MeshBounds& bounds, const float min[3], const float max[3])
+	{
+		for (int k = 0; k < 3; ++k)
+		{
+			bounds.extents[k] = (max[k] - min[k]) * 0.5f;
+			bounds.origin[k] = bounds.extents[k] + min[k];
+		}
+	}
+}
+
+
+void assets::EncodeOctNormalsScalar(const float* normals, size_t normalStride, uint8_t* encoded, size_t encodedStride, size_t count)
+{
+	for (size_t i = 0; i < count; ++i)
+		OctEncode(Stride(normals, normalStride, i), Stride(encoded, encodedStride, i));
+}
+
+void assets::DecodeOctNormalsScalar(const uint8_t* encoded, size_t encodedStride, float* normals, size_t normalStride, size_t count)
+{
+	for (size_t i = 0; i < count; ++i)
+		OctDecode(Stride(encoded, encodedStride, i), Stride(normals, normalStride, i));
+}
+
+assets::MeshBounds assets::CalculatePositionBoundsScalar(const float* positions, size_t positionStride, size_t count)
+{
+	MeshBounds bounds{};
+	if (count == 0)
+		return bounds;
+
+	float min[3] = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+	float max[3] = { std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() };
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		const float* p = Stride(positions, positionStride, i);
+		for (int k = 0; k < 3; ++k)
+		{
+			min[k] = std::min(min[k], p[k]);
+			max[k] = std::max(max[k], p[k]);
+		}
+	}
+
+	SetBoxFromMinMax(bounds, min, max);
+
+	float rsq = 0.0f;
+	for (size_t i = 0; i < count; ++i)
+	{
+		const float* p = Stride(positions, positionStride, i);
+		const float offset[3] = { p[0] - bounds.origin[0], p[1] - bounds.origin[1], p[2] - bounds.origin[2] };
+		const float distsq = (offset[0] * offset[0] + offset[1] * offset[1]) + offset[2] * offset[2];
+		rsq = std::max(distsq, rsq);
+	}
+	bounds.radius = std::sqrt(rsq);
+
+	return bounds;
+}
+
+void assets::QuantizePositionsScalar(const float* positions, size_t positionStride, const MeshBounds& bounds, uint16_t* quantized, size_t quantizedStride, size_t count)
+{
+	float minimum[3];
+	float scale[3];
+	QuantizeSetup(bounds, minimum, scale);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		const float* p = Stride(positions, positionStride, i);
+		uint16_t* q = Stride(quantized, quantizedStride, i);
+		for (int k = 0; k < 3; ++k)
+		{
+			const float value = (p[k] - minimum[k]) * scale[k] + 0.5f;
+			q[k] = static_cast<uint16_t>(std::min(std::max(value, 0.0f), 65535.0f));
+		}
+	}
+}
+
+
+#ifdef VERTEX_KERNELS_SSE2
+
+namespace
+{
+	// Exactly 12 bytes, so the last position of a tightly packed buffer is safe to read; w is 0
+	// The 64-bit integer loads and stores may alias anything; _mm_load_sd and _mm_store_sd are plain
+	// double accesses to the compiler, which lets it move them past the float writes they depend on
+	inline __m128 LoadFloat3(const float* p)
+	{
+		const __m128 xy = _mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)));
+		return _mm_movelh_ps(xy, _mm_load_ss(p + 2));
+	}
+
+	inline void StoreFloat3(float* p, __m128 v)
+	{
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_castps_si128(v));
+		_mm_store_ss(p + 2, _mm_movehl_ps(v, v));
+	}
+
+	inline __m128 Select(__m128 mask, __m128 a, __m128 b)
+	{
+		return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+	}
+
+	inline float SumXYZ(__m128 v)
+	{
+		// (x + y) + z, in the same order as the scalar version
+		const __m128 xy = _mm_add_ss(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)));
+		return _mm_cvtss_f32(_mm_add_ss(xy, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2))));
+	}
+
+	// Four normals at once; returns x | y << 8 per lane
+	__m128i OctEncode4(__m128 x, __m128 y, __m128 z)
+	{
+		const __m128 signBit = _mm_set1_ps(-0.0f);
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 half = _mm_set1_ps(0.5f);
+
+		const __m128 length = _mm_add_ps(_mm_add_ps(_mm_andnot_ps(signBit, x), _mm_andnot_ps(signBit, y)), _mm_andnot_ps(signBit, z));
+		x = _mm_div_ps(x, length);
+		y = _mm_div_ps(y, length);
+
+		const __m128 signX = Select(_mm_cmpge_ps(x, zero), one, _mm_sub_ps(zero, one));
+		const __m128 signY = Select(_mm_cmpge_ps(y, zero), one, _mm_sub_ps(zero, one));
+		const __m128 wrappedX = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(signBit, y)), signX);
+		const __m128 wrappedY = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(signBit, x)), signY);
+		const __m128 lower = _mm_cmplt_ps(z, zero);
+		x = Select(lower, wrappedX, x);
+		y = Select(lower, wrappedY, y);
+
+		auto toUnorm8 = [&](__m128 v)
+		{
+			v = _mm_min_ps(_mm_max_ps(_mm_add_ps(_mm_mul_ps(v, half), half), zero), one);
+			return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(v, _mm_set1_ps(255.0f)), half));
+		};
+
+		__m128i packed = _mm_or_si128(toUnorm8(x), _mm_slli_epi32(toUnorm8(y), 8));
+
+		const __m128i degenerate = _mm_castps_si128(_mm_cmpeq_ps(length, zero));
+		packed = _mm_or_si128(_mm_and_si128(degenerate, _mm_set1_epi32(128 | (128 << 8))), _mm_andnot_si128(degenerate, packed));
+		return packed;
+	}
+
+	// Four encoded normals at once, from x | y << 8 per lane
+	void OctDecode4(__m128i packed, __m128& x, __m128& y, __m128& z)
+	{
+		const __m128 signBit = _mm_set1_ps(-0.0f);
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 toSigned = _mm_set1_ps(2.0f / 255.0f);
+		const __m128i byteMask = _mm_set1_epi32(0xff);
+
+		x = _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(packed, byteMask)), toSigned), one);
+		y = _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(packed, 8), byteMask)), toSigned), one);
+		z = _mm_sub_ps(_mm_sub_ps(one, _mm_andnot_ps(signBit, x)), _mm_andnot_ps(signBit, y));
+
+		const __m128 t = _mm_min_ps(_mm_max_ps(_mm_sub_ps(zero, z), zero), one);
+		const __m128 negT = _mm_sub_ps(zero, t);
+		x = _mm_add_ps(x, Select(_mm_cmpge_ps(x, zero), negT, t));
+		y = _mm_add_ps(y, Select(_mm_cmpge_ps(y, zero), negT, t));
+
+		const __m128 lengthSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+		const __m128 scale = _mm_div_ps(one, _mm_sqrt_ps(lengthSq));
+		x = _mm_mul_ps(x, scale);
+		y = _mm_mul_ps(y, scale);
+		z = _mm_mul_ps(z, scale);
+	}
+
+	void LoadOct(const uint8_t* encoded, size_t encodedStride, size_t first, int32_t* packed, size_t count)
+	{
+		for (size_t j = 0; j < count; ++j)
+		{
+			const uint8_t* e = Stride(encoded, encodedStride, first + j);
+			packed[j] = e[0] | (e[1] << 8);
+		}
+	}
+
+	void StoreOct(uint8_t* encoded, size_t encodedStride, size_t first, const int32_t* packed, size_t count)
+	{
+		for (size_t j = 0; j < count; ++j)
+		{
+			uint8_t* e = Stride(encoded, encodedStride, first + j);
+			e[0] = static_cast<uint8_t>(packed[j]);
+			e[1] = static_cast<uint8_t>(packed[j] >> 8);
+		}
+	}
+
+	// Writes four normals held one component per register
+	void StoreNormals4(float* normals, size_t normalStride, size_t first, __m128 x, __m128 y, __m128 z)
+	{
+		__m128 w = _mm_setzero_ps();
+		_MM_TRANSPOSE4_PS(x, y, z, w);
+		StoreFloat3(Stride(normals, normalStride, first), x);
+		StoreFloat3(Stride(normals, normalStride, first + 1), y);
+		StoreFloat3(Stride(normals, normalStride, first + 2), z);
+		StoreFloat3(Stride(normals, normalStride, first + 3), w);
+	}
+}
+
+#ifdef VERTEX_KERNELS_AVX2
+
+namespace
+{
+	inline __m256 Select(__m256 mask, __m256 a, __m256 b)
+	{
+		return _mm256_blendv_ps(b, a, mask);
+	}
+
+	__m256i OctEncode8(__m256 x, __m256 y, __m256 z)
+	{
+		const __m256 signBit = _mm256_set1_ps(-0.0f);
+		const __m256 zero = _mm256_setzero_ps();
+		const __m256 one = _mm256_set1_ps(1.0f);
+		const __m256 half = _mm256_set1_ps(0.5f);
+
+		const __m256 length = _mm256_add_ps(_mm256_add_ps(_mm256_andnot_ps(signBit, x), _mm256_andnot_ps(signBit, y)), _mm256_andnot_ps(signBit, z));
+		x = _mm256_div_ps(x, length);
+		y = _mm256_div_ps(y, length);
+
+		const __m256 signX = Select(_mm256_cmp_ps(x, zero, _CMP_GE_OQ), one, _mm256_sub_ps(zero, one));
+		const __m256 signY = Select(_mm256_cmp_ps(y, zero, _CMP_GE_OQ), one, _mm256_sub_ps(zero, one));
+		const __m256 wrappedX = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_andnot_ps(signBit, y)), signX);
+		const __m256 wrappedY = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_andnot_ps(signBit, x)), signY);
+		const __m256 lower = _mm256_cmp_ps(z, zero, _CMP_LT_OQ);
+		x = Select(lower, wrappedX, x);
+		y = Select(lower, wrappedY, y);
+
+		auto toUnorm8 = [&](__m256 v)
+		{
+			v = _mm256_min_ps(_mm256_max_ps(_mm256_add_ps(_mm256_mul_ps(v, half), half), zero), one);
+			return _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(v, _mm256_set1_ps(255.0f)), half));
+		};
+
+		const __m256i packed = _mm256_or_si256(toUnorm8(x), _mm256_slli_epi32(toUnorm8(y), 8));
+		const __m256 degenerate = _mm256_cmp_ps(length, zero, _CMP_EQ_OQ);
+		return _mm256_castps_si256(Select(degenerate, _mm256_castsi256_ps(_mm256_set1_epi32(128 | (128 << 8))), _mm256_castsi256_ps(packed)));
+	}
+
+	void OctDecode8(__m256i packed, __m256& x, __m256& y, __m256& z)
+	{
+		const __m256 signBit = _mm256_set1_ps(-0.0f);
+		const __m256 zero = _mm256_setzero_ps();
+		const __m256 one = _mm256_set1_ps(1.0f);
+		const __m256 toSigned = _mm256_set1_ps(2.0f / 255.0f);
+		const __m256i byteMask = _mm256_set1_epi32(0xff);
+
+		x = _mm256_sub_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(packed, byteMask)), toSigned), one);
+		y = _mm256_sub_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(packed, 8), byteMask)), toSigned), one);
+		z = _mm256_sub_ps(_mm256_sub_ps(one, _mm256_andnot_ps(signBit, x)), _mm256_andnot_ps(signBit, y));
+
+		const __m256 t = _mm256_min_ps(_mm256_max_ps(_mm256_sub_ps(zero, z), zero), one);
+		const __m256 negT = _mm256_sub_ps(zero, t);
+		x = _mm256_add_ps(x, Select(_mm256_cmp_ps(x, zero, _CMP_GE_OQ), negT, t));
+		y = _mm256_add_ps(y, Select(_mm256_cmp_ps(y, zero, _CMP_GE_OQ), negT, t));
+
+		const __m256 lengthSq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z));
+		const __m256 scale = _mm256_div_ps(one, _mm256_sqrt_ps(lengthSq));
+		x = _mm256_mul_ps(x, scale);
+		y = _mm256_mul_ps(y, scale);
+		z = _mm256_mul_ps(z, scale);
+	}
+
+	__m256i StrideOffsets(size_t stride)
+	{
+		return _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(static_cast<int>(stride)));
+	}
+}
+
+#endif
+
+
+void assets::EncodeOctNormals(const float* normals, size_t normalStride, uint8_t* encoded, size_t encodedStride, size_t count)
+{
+	alignas(32) int32_t packed[8];
+	size_t i = 0;
+
+#ifdef VERTEX_KERNELS_AVX2
+	const __m256i offsets = StrideOffsets(normalStride);
+	for (; i + 8 <= count; i += 8)
+	{
+		const float* n = Stride(normals, normalStride, i);
+		const __m256 x = _mm256_i32gather_ps(n, offsets, 1);
+		const __m256 y = _mm256_i32gather_ps(n + 1, offsets, 1);
+		const __m256 z = _mm256_i32gather_ps(n + 2, offsets, 1);
+
+		_mm256_store_si256(reinterpret_cast<__m256i*>(packed), OctEncode8(x, y, z));
+		StoreOct(encoded, encodedStride, i, packed, 8);
+	}
+#endif
+
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 x = LoadFloat3(Stride(normals, normalStride, i));
+		__m128 y = LoadFloat3(Stride(normals, normalStride, i + 1));
+		__m128 z = LoadFloat3(Stride(normals, normalStride, i + 2));
+		__m128 w = LoadFloat3(Stride(normals, normalStride, i + 3));
+		_MM_TRANSPOSE4_PS(x, y, z, w);
+
+		_mm_store_si128(reinterpret_cast<__m128i*>(packed), OctEncode4(x, y, z));
+		StoreOct(encoded, encodedStride, i, packed, 4);
+	}
+
+	EncodeOctNormalsScalar(Stride(normals, normalStride, i), normalStride, Stride(encoded, encodedStride, i), encodedStride, count - i);
+}
+
+void assets::DecodeOctNormals(const uint8_t* encoded, size_t encodedStride, float* normals, size_t normalStride, size_t count)
+{
+	alignas(32) int32_t packed[8];
+	size_t i = 0;
+
+#ifdef VERTEX_KERNELS_AVX2
+	for (; i + 8 <= count; i += 8)
+	{
+		LoadOct(encoded, encodedStride, i, packed, 8);
+
+		__m256 x, y, z;
+		OctDecode8(_mm256_load_si256(reinterpret_cast<const __m256i*>(packed)), x, y, z);
+
+		StoreNormals4(normals, normalStride, i, _mm256_castps256_ps128(x), _mm256_castps256_ps128(y), _mm256_castps256_ps128(z));
+		StoreNormals4(normals, normalStride, i + 4, _mm256_extractf128_ps(x, 1), _mm256_extractf128_ps(y, 1), _mm256_extractf128_ps(z, 1));
+	}
+#endif
+
+	for (; i + 4 <= count; i += 4)
+	{
+		LoadOct(encoded, encodedStride, i, packed, 4);
+
+		__m128 x, y, z;
+		OctDecode4(_mm_load_si128(reinterpret_cast<const __m128i*>(packed)), x, y, z);
+		StoreNormals4(normals, normalStride, i, x, y, z);
+	}
+
+	DecodeOctNormalsScalar(Stride(encoded, encodedStride, i), encodedStride, Stride(normals, normalStride, i), normalStride, count - i);
+}
+
+assets::MeshBounds assets::CalculatePositionBounds(const float* positions, size_t positionStride, size_t count)
+{
+	// Positions per block; each block's box is kept so the radius pass can skip most of them
+	constexpr size_t BLOCK_SIZE = 64;
+
+	MeshBounds bounds{};
+	if (count == 0)
+		return bounds;
+
+	struct Block
+	{
+		float min[4];
+		float max[4];
+		float farthestSq;	// Upper bound on the squared distance of any of its positions from the center
+		size_t first;
+	};
+	std::vector<Block> blocks((count + BLOCK_SIZE - 1) / BLOCK_SIZE);
+
+	__m128 min = LoadFloat3(positions);
+	__m128 max = min;
+	for (size_t b = 0; b < blocks.size(); ++b)
+	{
+		const size_t first = b * BLOCK_SIZE;
+		const size_t last = std::min(first + BLOCK_SIZE, count);
+
+		__m128 blockMin = LoadFloat3(Stride(positions, positionStride, first));
+		__m128 blockMax = blockMin;
+		for (size_t i = first + 1; i < last; ++i)
+		{
+			const __m128 p = LoadFloat3(Stride(positions, positionStride, i));
+			blockMin = _mm_min_ps(blockMin, p);
+			blockMax = _mm_max_ps(blockMax, p);
+		}
+
+		_mm_storeu_ps(blocks[b].min, blockMin);
+		_mm_storeu_ps(blocks[b].max, blockMax);
+		blocks[b].first = first;
+		min = _mm_min_ps(min, blockMin);
+		max = _mm_max_ps(max, blockMax);
+	}
+
+	float minValues[4];
+	float maxValues[4];
+	_mm_storeu_ps(minValues, min);
+	_mm_storeu_ps(maxValues, max);
+	SetBoxFromMinMax(bounds, minValues, maxValues);
+
+	// Rounded subtraction is monotonic, so a block's farthest box corner bounds every position in it
+	const __m128 signBit = _mm_set1_ps(-0.0f);
+	const __m128 center = LoadFloat3(bounds.origin);
+	for (Block& block : blocks)
+	{
+		const __m128 nearSide = _mm_andnot_ps(signBit, _mm_sub_ps(_mm_loadu_ps(block.min), center));
+		const __m128 farSide = _mm_andnot_ps(signBit, _mm_sub_ps(_mm_loadu_ps(block.max), center));
+		const __m128 corner = _mm_max_ps(nearSide, farSide);
+		block.farthestSq = SumXYZ(_mm_mul_ps(corner, corner));
+	}
+
+	std::sort(blocks.begin(), blocks.end(), [](const Block& a, const Block& b) { return a.farthestSq > b.farthestSq; });
+
+	float rsq = 0.0f;
+	for (const Block& block : blocks)
+	{
+		if (block.farthestSq <= rsq)
+			break;
+
+		const size_t last = std::min(block.first + BLOCK_SIZE, count);
+		for (size_t i = block.first; i < last; ++i)
+		{
+			const __m128 offset = _mm_sub_ps(LoadFloat3(Stride(positions, positionStride, i)), center);
+			rsq = std::max(SumXYZ(_mm_mul_ps(offset, offset)), rsq);
+		}
+	}
+	bounds.radius = std::sqrt(rsq);
+
+	return bounds;
+}
+
+void assets::QuantizePositions(const float* positions, size_t positionStride, const MeshBounds& bounds, uint16_t* quantized, size_t quantizedStride, size_t count)
+{
+	float minimumValues[3];
+	float scaleValues[3];
+	QuantizeSetup(bounds, minimumValues, scaleValues);
+
+	const __m128 minimum = LoadFloat3(minimumValues);
+	const __m128 scale = LoadFloat3(scaleValues);
+	const __m128 half = _mm_set1_ps(0.5f);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 limit = _mm_set1_ps(65535.0f);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		const __m128 p = LoadFloat3(Stride(positions, positionStride, i));
+		const __m128 value = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(p, minimum), scale), half);
+
+		alignas(16) int32_t lanes[4];
+		_mm_store_si128(reinterpret_cast<__m128i*>(lanes), _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(value, zero), limit)));
+
+		uint16_t* q = Stride(quantized, quantizedStride, i);
+		q[0] = static_cast<uint16_t>(lanes[0]);
+		q[1] = static_cast<uint16_t>(lanes[1]);
+		q[2] = static_cast<uint16_t>(lanes[2]);
+	}
+}
+
+const char* assets::GetVertexKernelPath()
+{
+#ifdef VERTEX_KERNELS_AVX2
+	return "AVX2";
+#else
+	return "SSE2";
+#endif
+}
+
+#else
+
+void assets::EncodeOctNormals(const float* normals, size_t normalStride, uint8_t* encoded, size_t encodedStride, size_t count)
+{
+	EncodeOctNormalsScalar(normals, normalStride, encoded, encodedStride, count);
+}
+
+void assets::DecodeOctNormals(const uint8_t* encoded, size_t encodedStride, float* normals, size_t normalStride, size_t count)
+{
+	DecodeOctNormalsScalar(encoded, encodedStride, normals, normalStride, count);
+}
+
+assets::MeshBounds assets::CalculatePositionBounds(const float* positions, size_t positionStride, size_t count)
+{
+	return CalculatePositionBoundsScalar(positions, positionStride, count);
+}
+
+void assets::QuantizePositions(const float* positions, size_t positionStride, const MeshBounds& bounds, uint16_t* quantized, size_t quantizedStride, size_t count)
+{
+	QuantizePositionsScalar(positions, positionStride, bounds, quantized, quantizedStride, count);
+}
+
+const char* assets::GetVertexKernelPath()
+{
+	return "scalar";
+}
+
+#endif
\ No newline at end of file
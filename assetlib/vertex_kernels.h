@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "mesh_asset.h"
+
+// Batched per-vertex conversions. Inputs and outputs are strided (in bytes), so they work directly
+// on interleaved vertex buffers. SSE2 versions are used wherever it's available (all x64 builds),
+// and the normal kernels go 8 wide when the library is built with AVX2 (ASSETLIB_AVX2).
+namespace assets
+{
+	// "AVX2", "SSE2" or "scalar", whichever the kernels were compiled with
+	const char* GetVertexKernelPath();
+
+	// Octahedral-encodes each float3 normal into two unorm8 values. Same mapping as Vertex::PackNormal
+	// in the engine, rounded rather than truncated; zero-length normals encode as (128, 128).
+	void EncodeOctNormals(const float* normals, size_t normalStride, uint8_t* encoded, size_t encodedStride, size_t count);
+
+	// Inverse of EncodeOctNormals, writing unit-length float3s
+	void DecodeOctNormals(const uint8_t* encoded, size_t encodedStride, float* normals, size_t normalStride, size_t count);
+
+	// Box around the positions, and the sphere centered on it that holds them all. Reads each
+	// position once; only the few blocks of them that could hold the farthest one are revisited.
+	MeshBounds CalculatePositionBounds(const float* positions, size_t positionStride, size_t count);
+
+	// Maps each float3 position onto unorm16 across the bounds box, writing three values per position
+	void QuantizePositions(const float* positions, size_t positionStride, const MeshBounds& bounds, uint16_t* quantized, size_t quantizedStride, size_t count);
+
+	// Plain versions of the above, which the vectorized ones must match
+	void EncodeOctNormalsScalar(const float* normals, size_t normalStride, uint8_t* encoded, size_t encodedStride, size_t count);
+	void DecodeOctNormalsScalar(const uint8_t* encoded, size_t encodedStride, float* normals, size_t normalStride, size_t count);
+	MeshBounds CalculatePositionBoundsScalar(const float* positions, size_t positionStride, size_t count);
+	void QuantizePositionsScalar(const float* positions, size_t positionStride, const MeshBounds& bounds, uint16_t* quantized, size_t quantizedStride, size_t count);
+}
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <fstream>
 
 #include <chrono>
+#include <future>
 
 #include "vk_types.h"
 #include "vk_descriptors.h"
@@ -103,10 +104,11 @@ AllocatedBuffer VulkanEngine::CreateBuffer(size_t allocSize, VkBufferUsageFlags
 }
 
 
-Material* VulkanEngine::CreateMaterial(VkPipeline pipeline, VkPipelineLayout layout, const std::string& name)
+Material* VulkanEngine::CreateMaterial(const VkPipeline* pipelines, VkPipelineLayout layout, const std::string& name)
 {
 	Material mat = {};
-	mat.pipeline = pipeline;
+	for (size_t i = 0; i < VERTEX_LAYOUT_COUNT; ++i)
+		mat.pipelines[i] = pipelines[i];
 	mat.pipelineLayout = layout;
 	materials[name] = mat;
 	return &materials[name];
@@ -139,14 +141,28 @@ FrameData& VulkanEngine::GetCurrentFrame()
 }
 
 
-void VulkanEngine::DrawObjects(VkCommandBuffer cmd, RenderObject* first, int count)
+glm::mat4 VulkanEngine::GetViewMatrix() const
 {
 	glm::mat4 view(1.0f);
 	view = glm::rotate(view, camPitch, glm::vec3(1.0f, 0.0f, 0.0f));
 	view = glm::rotate(view, camYaw, glm::vec3(0.0f, 1.0f, 0.0f));
 	view = glm::translate(view, camPos);
+	return view;
+}
+
+
+glm::mat4 VulkanEngine::GetProjectionMatrix() const
+{
 	glm::mat4 projection = glm::perspective(glm::radians(fieldOfView), static_cast<float>(windowExtent.width) / static_cast<float>(windowExtent.height), 0.1f, 200.0f);
 	projection[1][1] *= -1;
+	return projection;
+}
+
+
+void VulkanEngine::DrawObjects(VkCommandBuffer cmd, RenderObject* first, int count)
+{
+	const glm::mat4 view = GetViewMatrix();
+	const glm::mat4 projection = GetProjectionMatrix();
 
 	GPUCameraData camValue = {};
 	camValue.proj = projection;
@@ -189,19 +205,34 @@ void VulkanEngine::DrawObjects(VkCommandBuffer cmd, RenderObject* first, int cou
 	for (int i = 0; i < count; ++i)
 	{
 		objectSSBO[i].model = first[i].transformMatrix;
+		if (first[i].mesh != nullptr && IsQuantizedLayout(first[i].mesh->vertexLayout))
+			objectSSBO[i].model *= first[i].mesh->dequantize;
 	}
 	vmaUnmapMemory(allocator, GetCurrentFrame().objectBuffer.allocation);
 
 
+	// Pixels covered by one unit at distance 1, for choosing LODs by their projected error
+	const float lodPixelScale = static_cast<float>(windowExtent.height) / (2.0f * tanf(glm::radians(fieldOfView) * 0.5f));
+	const float lodErrorPixels = static_cast<float>(cvar_lodErrorPixels.Get());
+	const glm::vec3 eye = -camPos;
+
 	Mesh* lastMesh = nullptr;
 	Material* lastMaterial = nullptr;
+	VkPipeline lastPipeline = VK_NULL_HANDLE;
 	for (int i = 0; i < count; i++)
 	{
 		const RenderObject& object = first[i];
 
+		// Same layout for every vertex layout's pipeline, so the sets stay bound across a switch
+		const VkPipeline pipeline = object.material->pipelines[static_cast<size_t>(object.mesh->vertexLayout)];
+		if (pipeline != lastPipeline)
+		{
+			vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+			lastPipeline = pipeline;
+		}
+
 		if (object.material != lastMaterial)
 		{
-			vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, object.material->pipeline);
 			lastMaterial = object.material;
 			uint32_t camera_offset = static_cast<uint32_t>(camSceneFrameSize * frameIndex);
 			uint32_t scene_offset = static_cast<uint32_t>(0);	// No additional offset on top of the baked-in, aligned offset in the descriptor
@@ -221,6 +252,8 @@ void VulkanEngine::DrawObjects(VkCommandBuffer cmd, RenderObject* first, int cou
 
 		const glm::mat4 model = object.transformMatrix;
 		glm::mat4 meshMatrix = model;
+		if (object.mesh != nullptr && IsQuantizedLayout(object.mesh->vertexLayout))
+			meshMatrix *= object.mesh->dequantize;
 
 		MeshPushConstants constants = {};
 		constants.renderMatrix = meshMatrix;
@@ -229,8 +262,12 @@ void VulkanEngine::DrawObjects(VkCommandBuffer cmd, RenderObject* first, int cou
 
 		if (object.mesh != lastMesh)
 		{
-			VkDeviceSize offset = 0;
-			vkCmdBindVertexBuffers(cmd, 0, 1, &object.mesh->vertexBuffer.buffer, &offset);
+			// Split layouts bind the same buffer again past the position stream for the other attributes
+			const VkBuffer buffers[] = { object.mesh->vertexBuffer.buffer, object.mesh->vertexBuffer.buffer };
+			const VkDeviceSize offsets[] = { 0, object.mesh->GetVertexCount() * GetPositionStride(object.mesh->vertexLayout) };
+			vkCmdBindVertexBuffers(cmd, 0, IsSplitLayout(object.mesh->vertexLayout) ? 2 : 1, buffers, offsets);
+			if (object.mesh->indexBuffer.buffer != VK_NULL_HANDLE)
+				vkCmdBindIndexBuffer(cmd, object.mesh->indexBuffer.buffer, 0, object.mesh->indexType);
 			lastMesh = object.mesh;
 		}
 
@@ -238,7 +275,26 @@ void VulkanEngine::DrawObjects(VkCommandBuffer cmd, RenderObject* first, int cou
 			continue;
 
 		// Passing i as firstInstance here makes gl_BaseInstance get the value of i and be able to use it to index the matrix SSBO we set, above
-		vkCmdDraw(cmd, static_cast<int>(object.mesh->vertices.size()), 1, 0, i);
+		if (object.mesh->indexBuffer.buffer != VK_NULL_HANDLE)
+		{
+			uint32_t firstIndex = 0;
+			uint32_t indexCount = static_cast<uint32_t>(object.mesh->GetIndexCount());
+			if (!object.mesh->lods.empty())
+			{
+				// Measured at the nearest point of the bounds, so no part of the object shows more than the allowed error
+				const glm::mat4& model = object.transformMatrix;
+				const float scale = glm::max(glm::length(glm::vec3(model[0])), glm::max(glm::length(glm::vec3(model[1])), glm::length(glm::vec3(model[2]))));
+				const glm::vec3 center = glm::vec3(model * glm::vec4(object.mesh->bounds.origin, 1.0f));
+				const float distance = glm::max(glm::length(center - eye) - object.mesh->bounds.radius * scale, 0.1f);
+
+				const RenderLod& lod = object.mesh->lods[object.mesh->SelectLod(lodErrorPixels * distance / (lodPixelScale * scale))];
+				firstIndex = lod.firstIndex;
+				indexCount = lod.indexCount;
+			}
+			vkCmdDrawIndexed(cmd, indexCount, 1, firstIndex, 0, i);
+		}
+		else
+			vkCmdDraw(cmd, static_cast<int>(object.mesh->GetVertexCount()), 1, 0, i);
 	}
 }
 
@@ -274,15 +330,24 @@ void VulkanEngine::Init()
 	InitDefaultRenderPass();
 	InitFramebuffers();
 	InitSyncStructures();
+	InitStaging();
 	InitDescriptors();
+	InitTextureStreaming();
 	InitImGui();
 
 	// Content
 	InitPipelines();
 
+	// Prefer the packed archive when the cooker produced one, otherwise fall back to loose cooked files
+	assetArchive.Open(COOKED_ARCHIVE);
+	assetIO.Start();
+
 	LoadMeshes();
 	LoadImages();
 
+	assetIO.Stop();
+	assetArchive.Close();
+
 	InitScene();
 
 	isInitialized = true;
@@ -392,18 +457,97 @@ void VulkanEngine::LoadMeshes()
 	constexpr bool loadCooked = true;
 	if (loadCooked)
 	{
-		meshesToLoad["monkey"] = "../cooked/monkey_smooth.msh";
-		meshesToLoad["apple"] = "../cooked/apple.msh";
-		meshesToLoad["rabbit_high"] = "../cooked/rabbit_high.msh";
-		meshesToLoad["lost_empire"] = "../cooked/lost_empire.msh";
-
-		for (auto it = meshesToLoad.begin(); it != meshesToLoad.end(); ++it)
+		meshesToLoad["monkey"] = "monkey_smooth.msh";
+		meshesToLoad["apple"] = "apple.msh";
+		meshesToLoad["rabbit_high"] = "rabbit_high.msh";
+		meshesToLoad["lost_empire"] = "lost_empire.msh";
+
+		// Reads and decoding run on the asset I/O workers; uploads stay on this thread and start
+		// as soon as each mesh is ready instead of after everything has been read
+		struct LoadedMesh
 		{
+			std::string name;
 			Mesh mesh;
-			if (mesh.LoadFromAsset((*it).second.c_str()))
+			bool ok;
+		};
+		std::mutex readyMutex;
+		std::condition_variable readyCondition;
+		std::vector<LoadedMesh> ready;
+
+		auto decodeMesh = [&](const std::string& name)
+		{
+			return [&, name](assets::AssetRead& read)
 			{
-				UploadMesh(mesh);
-				meshes[(*it).first.c_str()] = mesh;
+				LoadedMesh loaded{ name };
+				assets::AssetView asset;
+				loaded.ok = read.ok
+					&& assets::ParseBinary(read.data.data(), read.data.size(), asset, GetAssetVerifyFlags())
+					&& loaded.mesh.LoadFromAsset(asset);
+				if (!loaded.ok)
+					OutputMessage("Error loading mesh: %s\n", read.path.c_str());
+
+				{
+					std::lock_guard<std::mutex> lock(readyMutex);
+					ready.push_back(std::move(loaded));
+				}
+				readyCondition.notify_one();
+			};
+		};
+
+		size_t requested = 0;
+		if (assetArchive.IsOpen())
+		{
+			// Request in archive order so reads walk the file front to back
+			std::unordered_map<const assets::ArchiveEntry*, std::string> entryNames;
+			std::vector<const assets::ArchiveEntry*> batch;
+			for (auto it = meshesToLoad.begin(); it != meshesToLoad.end(); ++it)
+			{
+				const assets::ArchiveEntry* entry = assetArchive.Find((*it).second.c_str());
+				if (entry == nullptr)
+				{
+					OutputMessage("Mesh missing from archive: %s\n", (*it).second.c_str());
+					continue;
+				}
+				entryNames[entry] = (*it).first;
+				batch.push_back(entry);
+			}
+
+			assets::ArchiveReader::SortByOffset(batch);
+
+			for (const assets::ArchiveEntry* entry : batch)
+			{
+				if (assetIO.Request(assetArchive, entry, decodeMesh(entryNames[entry])))
+					++requested;
+			}
+		}
+		else
+		{
+			for (auto it = meshesToLoad.begin(); it != meshesToLoad.end(); ++it)
+			{
+				std::string path = std::string(COOKED_FOLDER) + (*it).second;
+
+				if (assetIO.Request(path.c_str(), decodeMesh((*it).first)))
+					++requested;
+			}
+		}
+
+		while (requested > 0)
+		{
+			std::vector<LoadedMesh> batch;
+			{
+				std::unique_lock<std::mutex> lock(readyMutex);
+				readyCondition.wait(lock, [&]() { return !ready.empty(); });
+				batch.swap(ready);
+			}
+
+			for (auto& loaded : batch)
+			{
+				--requested;
+				if (loaded.ok)
+				{
+					UploadMesh(loaded.mesh);
+					meshes[loaded.name] = loaded.mesh;
+				}
 			}
 		}
 	}
@@ -438,13 +582,61 @@ void VulkanEngine::LoadImages()
 	bool loaded = false;
 
 	if (loadCooked)
-		loaded = vkutil::LoadImageFromAsset(*this, "../cooked/lost_empire-RGBA.tex", lostEmpire.image);
+	{
+		const assets::ArchiveEntry* entry = assetArchive.IsOpen() ? assetArchive.Find("lost_empire-RGBA.tex") : nullptr;
+		const std::string loosePath = std::string(COOKED_FOLDER) + "lost_empire-RGBA.tex";
+		const uint32_t firstMip = static_cast<uint32_t>(cvar_textureSkipMips.Get());
+
+		// Only the smallest mips are loaded now; the streamer brings in the rest as the view needs them
+		if (cvar_textureBudgetMB.Get() > 0 && stagingRing.GetSegmentSize() > 0)
+		{
+			bool registered = false;
+			if (assetArchive.IsOpen())
+				registered = entry != nullptr && textureStreamer.Register("empire_diffuse", assetArchive.GetPath().c_str(), entry->offset);
+			else
+				registered = textureStreamer.Register("empire_diffuse", loosePath.c_str(), 0);
+
+			if (registered)
+				return;
+		}
+
+		if (cvar_streamTextures.Get() && stagingRing.GetSegmentSize() > 0)
+		{
+			// Chunks are read and decoded one at a time, so only the staging ring is ever resident
+			if (assetArchive.IsOpen())
+				loaded = entry != nullptr && vkutil::LoadImageStreamed(*this, assetArchive.GetPath().c_str(), entry->offset, lostEmpire.image, firstMip);
+			else
+				loaded = vkutil::LoadImageStreamed(*this, loosePath.c_str(), 0, lostEmpire.image, firstMip);
+		}
+		else
+		{
+			// Read on the asset I/O workers, then decode straight into the staging buffer on this thread
+			std::promise<assets::AssetRead> readPromise;
+			std::future<assets::AssetRead> readFuture = readPromise.get_future();
+			auto onRead = [&readPromise](assets::AssetRead& read) { readPromise.set_value(std::move(read)); };
+
+			bool requested = false;
+			if (assetArchive.IsOpen())
+				requested = assetIO.Request(assetArchive, entry, onRead);
+			else
+				requested = assetIO.Request(loosePath.c_str(), onRead);
+
+			if (requested)
+			{
+				assets::AssetRead read = readFuture.get();
+				assets::AssetView asset;
+				loaded = read.ok
+					&& assets::ParseBinary(read.data.data(), read.data.size(), asset, GetAssetVerifyFlags())
+					&& vkutil::LoadImageFromAsset(*this, asset, lostEmpire.image, firstMip);
+			}
+		}
+	}
 	else
 		loaded = vkutil::LoadImageFromFile(*this, "../assets/lost_empire-RGBA.png", lostEmpire.image);
 
 	if (loaded)
 	{
-		VkImageViewCreateInfo imageInfo = vkinit::ImageViewCreateInfo(VK_FORMAT_R8G8B8A8_SRGB, lostEmpire.image.image, VK_IMAGE_ASPECT_COLOR_BIT);
+		VkImageViewCreateInfo imageInfo = vkinit::ImageViewCreateInfo(lostEmpire.image.format, lostEmpire.image.image, VK_IMAGE_ASPECT_COLOR_BIT);
 		imageInfo.subresourceRange.levelCount = lostEmpire.image.mipLevels;
 		vkCreateImageView(device, &imageInfo, NULL, &lostEmpire.imageView);
 
@@ -455,12 +647,19 @@ void VulkanEngine::LoadImages()
 
 void VulkanEngine::UploadMesh(Mesh& mesh)
 {
-	const size_t bufferSizeBytes = mesh.vertices.size() * sizeof(Vertex);
+	// Cooked vertex data goes up byte for byte; vertices only holds meshes built on the CPU
+	const bool cooked = !mesh.vertexData.empty();
+	const size_t vertexBytes = cooked ? mesh.vertexData.size() : mesh.vertices.size() * sizeof(Vertex);
+	const void* vertexSource = cooked ? static_cast<const void*>(mesh.vertexData.data()) : static_cast<const void*>(mesh.vertices.data());
+
+	// Indices too, already at the size the cooker picked (16-bit whenever every vertex fits)
+	const size_t indexBytes = mesh.indexData.size();
 
+	// One staging buffer holds both, vertices first
 	VkBufferCreateInfo stagingBufferInfo = {};
 	stagingBufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
 
-	stagingBufferInfo.size = bufferSizeBytes;
+	stagingBufferInfo.size = vertexBytes + indexBytes;
 	stagingBufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
 
 	VmaAllocationCreateInfo vmaAllocInfo = {};
@@ -471,28 +670,51 @@ void VulkanEngine::UploadMesh(Mesh& mesh)
 
  	void* data;
  	vmaMapMemory(allocator, stagingBuffer.allocation, &data);
- 	memcpy(data, mesh.vertices.data(), bufferSizeBytes);
+ 	memcpy(data, vertexSource, vertexBytes);
+	memcpy(reinterpret_cast<char*>(data) + vertexBytes, mesh.indexData.data(), indexBytes);
  	vmaUnmapMemory(allocator, stagingBuffer.allocation);
 
 	VkBufferCreateInfo vertexBufferInfo = {};
 	vertexBufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-	vertexBufferInfo.size = bufferSizeBytes;
+	vertexBufferInfo.size = vertexBytes;
 	vertexBufferInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
 
 	vmaAllocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
 	VK_CHECK(vmaCreateBuffer(allocator, &vertexBufferInfo, &vmaAllocInfo, &mesh.vertexBuffer.buffer, &mesh.vertexBuffer.allocation, nullptr));
 
+	if (indexBytes > 0)
+	{
+		VkBufferCreateInfo indexBufferInfo = {};
+		indexBufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		indexBufferInfo.size = indexBytes;
+		indexBufferInfo.usage = VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+		VK_CHECK(vmaCreateBuffer(allocator, &indexBufferInfo, &vmaAllocInfo, &mesh.indexBuffer.buffer, &mesh.indexBuffer.allocation, nullptr));
+	}
+
 	// Perform immediate blocking copy
 	ImmediateSubmit([=](VkCommandBuffer cmd)
 		{
 			VkBufferCopy copy = {};
-			copy.size = bufferSizeBytes;
+			copy.size = vertexBytes;
 			vkCmdCopyBuffer(cmd, stagingBuffer.buffer, mesh.vertexBuffer.buffer, 1, &copy);
+
+			if (indexBytes > 0)
+			{
+				VkBufferCopy indexCopy = {};
+				indexCopy.srcOffset = vertexBytes;
+				indexCopy.size = indexBytes;
+				vkCmdCopyBuffer(cmd, stagingBuffer.buffer, mesh.indexBuffer.buffer, 1, &indexCopy);
+			}
 		});
 
+	const AllocatedBuffer vertexBuffer = mesh.vertexBuffer;
+	const AllocatedBuffer indexBuffer = mesh.indexBuffer;
 	mainDeletionQueue.PushFunction([=]()
 		{
-			vmaDestroyBuffer(allocator, mesh.vertexBuffer.buffer, mesh.vertexBuffer.allocation);
+			vmaDestroyBuffer(allocator, vertexBuffer.buffer, vertexBuffer.allocation);
+			if (indexBuffer.buffer != VK_NULL_HANDLE)
+				vmaDestroyBuffer(allocator, indexBuffer.buffer, indexBuffer.allocation);
 		});
 
 	vmaDestroyBuffer(allocator, stagingBuffer.buffer, stagingBuffer.allocation);
@@ -541,10 +763,15 @@ void VulkanEngine::InitVulkan()
 
 	SDL_Vulkan_CreateSurface(window, instance, &surface);
 
+	// Cooked textures are BCn unless the cooker was told otherwise
+	VkPhysicalDeviceFeatures requiredFeatures = {};
+	requiredFeatures.textureCompressionBC = VK_TRUE;
+
 	vkb::PhysicalDeviceSelector selector{ vkbInst };
 	vkb::PhysicalDevice physicalDevice = selector
 		.set_minimum_version(1, 1)
 		.set_surface(surface)
+		.set_required_features(requiredFeatures)
 		.select()
 		.value();
 
@@ -801,6 +1028,19 @@ void VulkanEngine::InitSyncStructures()
 }
 
 
+void VulkanEngine::InitStaging()
+{
+	const VkDeviceSize ringSize = static_cast<VkDeviceSize>(cvar_stagingRingMB.Get()) * 1024 * 1024;
+	if (!stagingRing.Init(device, allocator, graphicsQueue, graphicsQueueFamily, ringSize))
+		return;
+
+	mainDeletionQueue.PushFunction([=]()
+		{
+			stagingRing.Cleanup();
+		});
+}
+
+
 void VulkanEngine::InitDescriptors()
 {
 	std::vector<VkDescriptorPoolSize> sizes =
@@ -915,6 +1155,21 @@ void VulkanEngine::InitDescriptors()
 }
 
 
+void VulkanEngine::InitTextureStreaming()
+{
+	if (!textureStreamer.Init(*this, singleTextureSetLayout))
+	{
+		OutputMessage("Texture streaming unavailable; textures will load whole");
+		return;
+	}
+
+	mainDeletionQueue.PushFunction([=]()
+		{
+			textureStreamer.Cleanup();
+		});
+}
+
+
 void VulkanEngine::InitPipelines()
 {
 	// Shader load (match with cleanup)
@@ -965,9 +1220,9 @@ void VulkanEngine::InitPipelines()
 
 	VkPipeline trianglePipeline;
 	VkPipeline redTrianglePipeline;
-	VkPipeline meshPipeline;
-	VkPipeline greyMeshPipeline;
-	VkPipeline texMeshPipeline;
+	VkPipeline meshPipelines[VERTEX_LAYOUT_COUNT];
+	VkPipeline greyMeshPipelines[VERTEX_LAYOUT_COUNT];
+	VkPipeline texMeshPipelines[VERTEX_LAYOUT_COUNT];
 	VkPipelineLayout meshPipelineLayout;
 
 
@@ -1011,25 +1266,37 @@ void VulkanEngine::InitPipelines()
 	VK_CHECK(vkCreatePipelineLayout(device, &meshPipelineLayoutInfo, nullptr, &meshPipelineLayout));
 	pipelineBuilder.pipelineLayout = meshPipelineLayout;
 
-	// Mesh pipelines
-	VertexInputDescription vertexDescription = Vertex::GetVertexDescription();
-	pipelineBuilder.vertexInput.pVertexAttributeDescriptions = vertexDescription.attributes.data();
-	pipelineBuilder.vertexInput.vertexAttributeDescriptionCount = static_cast<uint32_t>(vertexDescription.attributes.size());
-	pipelineBuilder.vertexInput.pVertexBindingDescriptions = vertexDescription.bindings.data();
-	pipelineBuilder.vertexInput.vertexBindingDescriptionCount = static_cast<uint32_t>(vertexDescription.bindings.size());
+	// Mesh pipelines, one per vertex layout. The quantized layout's UNORM and half formats are
+	// expanded by the input assembler, so both share the same shaders.
+	VertexInputDescription vertexDescriptions[VERTEX_LAYOUT_COUNT];
+	for (size_t l = 0; l < VERTEX_LAYOUT_COUNT; ++l)
+		vertexDescriptions[l] = GetVertexDescription(static_cast<VertexLayout>(l));
+
+	auto buildMeshPipelines = [&](VkPipeline* pipelines)
+	{
+		for (size_t l = 0; l < VERTEX_LAYOUT_COUNT; ++l)
+		{
+			const VertexInputDescription& vertexDescription = vertexDescriptions[l];
+			pipelineBuilder.vertexInput.pVertexAttributeDescriptions = vertexDescription.attributes.data();
+			pipelineBuilder.vertexInput.vertexAttributeDescriptionCount = static_cast<uint32_t>(vertexDescription.attributes.size());
+			pipelineBuilder.vertexInput.pVertexBindingDescriptions = vertexDescription.bindings.data();
+			pipelineBuilder.vertexInput.vertexBindingDescriptionCount = static_cast<uint32_t>(vertexDescription.bindings.size());
+			pipelines[l] = pipelineBuilder.BuildPipeline(device, renderPass);
+		}
+	};
 
 	// Colored version
 	pipelineBuilder.shaderStages.push_back(vkinit::ShaderStateCreateInfo(VK_SHADER_STAGE_VERTEX_BIT, meshVertShader));
 	pipelineBuilder.shaderStages.push_back(vkinit::ShaderStateCreateInfo(VK_SHADER_STAGE_FRAGMENT_BIT, defaultLitFragShader));
-	meshPipeline = pipelineBuilder.BuildPipeline(device, renderPass);
-	CreateMaterial(meshPipeline, meshPipelineLayout, "defaultMesh");
+	buildMeshPipelines(meshPipelines);
+	CreateMaterial(meshPipelines, meshPipelineLayout, "defaultMesh");
 
 	// Grey version
 	pipelineBuilder.shaderStages.clear();
 	pipelineBuilder.shaderStages.push_back(vkinit::ShaderStateCreateInfo(VK_SHADER_STAGE_VERTEX_BIT, meshVertShader));
 	pipelineBuilder.shaderStages.push_back(vkinit::ShaderStateCreateInfo(VK_SHADER_STAGE_FRAGMENT_BIT, greyscaleTriangleFragShader));
-	greyMeshPipeline = pipelineBuilder.BuildPipeline(device, renderPass);
-	CreateMaterial(greyMeshPipeline, meshPipelineLayout, "greyMesh");
+	buildMeshPipelines(greyMeshPipelines);
+	CreateMaterial(greyMeshPipelines, meshPipelineLayout, "greyMesh");
 
 
 
@@ -1045,8 +1312,8 @@ void VulkanEngine::InitPipelines()
 	pipelineBuilder.shaderStages.push_back(vkinit::ShaderStateCreateInfo(VK_SHADER_STAGE_VERTEX_BIT, meshVertShader));
 	pipelineBuilder.shaderStages.push_back(vkinit::ShaderStateCreateInfo(VK_SHADER_STAGE_FRAGMENT_BIT, texturedLitFragShader));
 	pipelineBuilder.pipelineLayout = texturedPipeLayout;
-	texMeshPipeline = pipelineBuilder.BuildPipeline(device, renderPass);
-	CreateMaterial(texMeshPipeline, texturedPipeLayout, "texturedMesh");
+	buildMeshPipelines(texMeshPipelines);
+	CreateMaterial(texMeshPipelines, texturedPipeLayout, "texturedMesh");
 
 
 
@@ -1062,9 +1329,12 @@ void VulkanEngine::InitPipelines()
 
 	mainDeletionQueue.PushFunction([=]()
 		{
-			vkDestroyPipeline(device, texMeshPipeline, nullptr);
-			vkDestroyPipeline(device, greyMeshPipeline, nullptr);
-			vkDestroyPipeline(device, meshPipeline, nullptr);
+			for (size_t l = 0; l < VERTEX_LAYOUT_COUNT; ++l)
+			{
+				vkDestroyPipeline(device, texMeshPipelines[l], nullptr);
+				vkDestroyPipeline(device, greyMeshPipelines[l], nullptr);
+				vkDestroyPipeline(device, meshPipelines[l], nullptr);
+			}
 			vkDestroyPipeline(device, redTrianglePipeline, nullptr);
 			vkDestroyPipeline(device, trianglePipeline, nullptr);
 
@@ -1161,19 +1431,25 @@ void VulkanEngine::InitScene()
 				vkDestroySampler(device, sampler, nullptr);
 			});
 
-		VkDescriptorSetAllocateInfo allocInfo = {};
-		allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-		allocInfo.descriptorPool = descriptorPool;
-		allocInfo.descriptorSetCount = 1;
-		allocInfo.pSetLayouts = &singleTextureSetLayout;
-		vkAllocateDescriptorSets(device, &allocInfo, &map.material->textureSet);
-
-		VkDescriptorImageInfo imageBufferInfo {0};
-		imageBufferInfo.sampler = sampler;
-		imageBufferInfo.imageView = loadedTextures["empire_diffuse"].imageView;
-		imageBufferInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-		VkWriteDescriptorSet texture1 = vkinit::WriteDescriptorImage(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, map.material->textureSet, &imageBufferInfo, 0);
-		vkUpdateDescriptorSets(device, 1, &texture1, 0, nullptr);
+		// Streamed textures rewrite their own sets as their images are rebuilt
+		if (textureStreamer.IsRegistered("empire_diffuse"))
+			textureStreamer.BindMaterial("empire_diffuse", map.material, sampler);
+		else
+		{
+			VkDescriptorSetAllocateInfo allocInfo = {};
+			allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+			allocInfo.descriptorPool = descriptorPool;
+			allocInfo.descriptorSetCount = 1;
+			allocInfo.pSetLayouts = &singleTextureSetLayout;
+			vkAllocateDescriptorSets(device, &allocInfo, &map.material->textureSet);
+
+			VkDescriptorImageInfo imageBufferInfo {0};
+			imageBufferInfo.sampler = sampler;
+			imageBufferInfo.imageView = loadedTextures["empire_diffuse"].imageView;
+			imageBufferInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+			VkWriteDescriptorSet texture1 = vkinit::WriteDescriptorImage(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, map.material->textureSet, &imageBufferInfo, 0);
+			vkUpdateDescriptorSets(device, 1, &texture1, 0, nullptr);
+		}
 
 		renderables.push_back(map);
 	}
@@ -1405,6 +1681,9 @@ void VulkanEngine::Draw()
 
 	VK_CHECK(vkWaitForFences(device, 1, &GetCurrentFrame().renderFence, true, timeoutNS));
 
+	// Must come after the wait, since it rewrites this frame's texture sets
+	textureStreamer.Update(renderables.data(), renderables.size(), static_cast<uint64_t>(cvar_textureBudgetMB.Get()) * 1024 * 1024);
+
 	// Draw options window
 	if (showOptions)
 	{
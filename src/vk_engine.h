@@ -9,6 +9,10 @@
 #include "vk_mesh.h"
 #include "vk_config.h"
 #include "cvars.h"
+#include "asset_archive.h"
+#include "asset_io.h"
+#include "vk_staging.h"
+#include "vk_texture_streaming.h"
 
 
 static AutoCVar_Float cvar_lookSensitivity("i.lookSensitivity", "How sensitive the view rotation is to input", 5.0, 0.1, 10.0, CVarFlags::EditFloatDrag);
@@ -20,6 +24,25 @@ static AutoCVar_Int cvar_syncMode_1("r.syncMode_1", "V-sync - no wait (MAILBOX)"
 static AutoCVar_Int cvar_syncMode_2("r.syncMode_2", "V-sync (FIFO)", VK_PRESENT_MODE_FIFO_KHR, CVarFlags::NoEdit);
 static AutoCVar_Int cvar_syncMode("r.syncMode", "Which mode to use for syncing the frame render to display refresh", 1, 0, 2, CVarFlags::EditCombo);
 
+static AutoCVar_Float cvar_lodErrorPixels("r.lodErrorPixels", "Largest on-screen error, in pixels, a simplified mesh LOD may show (0 = always full detail)", 1.0, 0.0, 16.0, CVarFlags::EditFloatDrag);
+
+static AutoCVar_Int cvar_verifyAssets("a.verifyAssets", "Check cooked asset data against its stored checksum when loading", 1, 0, 1, CVarFlags::EditCheckbox);
+static AutoCVar_Int cvar_streamTextures("a.streamTextures", "Decode textures a chunk at a time through the staging ring instead of loading them whole", 1, 0, 1, CVarFlags::EditCheckbox);
+static AutoCVar_Int cvar_textureSkipMips("a.textureSkipMips", "Skip this many of the largest texture mips when loading (lower resolution, faster start, less memory)", 0, 0, 8, CVarFlags::Advanced);
+static AutoCVar_Int cvar_textureBudgetMB("a.textureBudgetMB", "Memory streamed textures may keep resident, in MB; their mips are streamed in and out to fit (0 = load textures whole, applies on restart)", 256, 0, 4096, CVarFlags::None);
+static AutoCVar_Int cvar_stagingRingMB("a.stagingRingMB", "Size of the persistently mapped upload ring (applies on restart)", 16, 2, 256, CVarFlags::Advanced);
+static AutoCVar_Int cvar_verifyAssetContent("a.verifyAssetContent", "Also check the decompressed asset payload (slower)", 0, 0, 1, static_cast<CVarFlags>(static_cast<uint32_t>(CVarFlags::EditCheckbox) | static_cast<uint32_t>(CVarFlags::Advanced)));
+
+inline uint32_t GetAssetVerifyFlags()
+{
+	uint32_t flags = assets::VerifyNone;
+	if (cvar_verifyAssets.Get())
+		flags |= assets::VerifyBlob;
+	if (cvar_verifyAssetContent.Get())
+		flags |= assets::VerifyContent;
+	return flags;
+}
+
 
 struct MeshPushConstants
 {
@@ -31,7 +54,7 @@ struct MeshPushConstants
 struct Material
 {
 	VkDescriptorSet textureSet { VK_NULL_HANDLE };
-	VkPipeline pipeline { VK_NULL_HANDLE };
+	VkPipeline pipelines[VERTEX_LAYOUT_COUNT] {};	// Indexed by the mesh's VertexLayout
 	VkPipelineLayout pipelineLayout { VK_NULL_HANDLE };
 };
 
@@ -49,10 +72,13 @@ struct RenderObject
 	Material* material { nullptr };
 	glm::mat4 transformMatrix;
 
+	// Grouped by the pipeline DrawObjects binds for the mesh's layout, then by mesh
 	bool operator < (const RenderObject& other) const
 	{
-		if (material->pipeline != other.material->pipeline)
-			return (material->pipeline < other.material->pipeline);
+		const VkPipeline pipeline = material->pipelines[static_cast<size_t>(mesh->vertexLayout)];
+		const VkPipeline otherPipeline = other.material->pipelines[static_cast<size_t>(other.mesh->vertexLayout)];
+		if (pipeline != otherPipeline)
+			return (pipeline < otherPipeline);
 		return mesh < other.mesh;
 	}
 };
@@ -138,6 +164,9 @@ struct FrameData
 
 constexpr unsigned int FRAME_OVERLAP = 2;
 
+constexpr const char* COOKED_FOLDER = "../cooked/";
+constexpr const char* COOKED_ARCHIVE = "../cooked/assets.pak";
+
 
 struct Toast
 {
@@ -181,6 +210,7 @@ public:
 	std::vector<VkPresentModeKHR> presentModes;
 
 	UploadContext uploadContext;
+	StagingRing stagingRing;
 
 	VkSwapchainKHR swapchain { nullptr };
 	VkFormat swapchainImageFormat;
@@ -193,6 +223,11 @@ public:
 	VkImageView depthImageView;
 
 	std::unordered_map<std::string, Texture> loadedTextures;
+	TextureStreamer textureStreamer;
+
+	// Only open while content is loading
+	assets::ArchiveReader assetArchive;
+	assets::AssetIO assetIO;
 
 	VkQueue graphicsQueue;
 	uint32_t graphicsQueueFamily;
@@ -231,13 +266,15 @@ public:
 	size_t PadUniformBufferSize(size_t originalSize) const;
 
 	AllocatedBuffer CreateBuffer(size_t allocSize, VkBufferUsageFlags usage, VmaMemoryUsage memoryUsage);
-	Material* CreateMaterial(VkPipeline pipeline, VkPipelineLayout layout, const std::string& name);
+	Material* CreateMaterial(const VkPipeline* pipelines, VkPipelineLayout layout, const std::string& name);
 
 	Material* GetMaterial(const std::string& name);
 	Mesh* GetMesh(const std::string& name);
 	FrameData& GetCurrentFrame();
 
 	void UpdateCamera(int deltaX, int deltaY);
+	glm::mat4 GetViewMatrix() const;
+	glm::mat4 GetProjectionMatrix() const;
 	void DrawObjects(VkCommandBuffer cmd, RenderObject* first, int count);
 
 	void DrawGUI();
@@ -261,7 +298,9 @@ private:
 	void InitDefaultRenderPass();
 	void InitFramebuffers();
 	void InitSyncStructures();
+	void InitStaging();
 	void InitDescriptors();
+	void InitTextureStreaming();
 	void InitPipelines();
 	void InitScene();
 	void InitImGui();
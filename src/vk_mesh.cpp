@@ -2,12 +2,58 @@
 
 #include <tiny_obj_loader.h>
 #include <iostream>
+#include <algorithm>
 #include "vk_engine.h"
 #include "mesh_asset.h"
+#include "asset_archive.h"
+#include "vertex_kernels.h"
 #include "debug.h"
+#include "glm/gtx/transform.hpp"
 
 
-VertexInputDescription Vertex::GetVertexDescription()
+// Cooked P32N8C8V32 vertices are uploaded as Vertex without conversion
+static_assert(sizeof(Vertex) == sizeof(assets::Vertex_P32N8C8V32), "Vertex must match assets::Vertex_P32N8C8V32");
+static_assert(offsetof(Vertex, position) == offsetof(assets::Vertex_P32N8C8V32, position), "Vertex must match assets::Vertex_P32N8C8V32");
+static_assert(offsetof(Vertex, octNormal) == offsetof(assets::Vertex_P32N8C8V32, octNormal), "Vertex must match assets::Vertex_P32N8C8V32");
+static_assert(offsetof(Vertex, color) == offsetof(assets::Vertex_P32N8C8V32, color), "Vertex must match assets::Vertex_P32N8C8V32");
+static_assert(offsetof(Vertex, uv) == offsetof(assets::Vertex_P32N8C8V32, uv), "Vertex must match assets::Vertex_P32N8C8V32");
+
+
+// True when every index addresses one of vertexCount vertices
+template<typename T>
+static bool CheckIndices(const char* data, size_t size, size_t vertexCount)
+{
+	const T* indices = reinterpret_cast<const T*>(data);
+	T largest = 0;
+	for (size_t i = 0; i < size / sizeof(T); ++i)
+		largest = std::max(largest, indices[i]);
+	return size == 0 || largest < vertexCount;
+}
+
+
+// Moves the position (location 0, at the start of the vertex) into binding 0 on its own, and
+// every other attribute into binding 1 with offsets relative to the end of the position
+static void SplitPositionBinding(VertexInputDescription& description, uint32_t positionSize)
+{
+	const uint32_t vertexSize = description.bindings[0].stride;
+	description.bindings[0].stride = positionSize;
+
+	VkVertexInputBindingDescription attributeBinding = description.bindings[0];
+	attributeBinding.binding = 1;
+	attributeBinding.stride = vertexSize - positionSize;
+	description.bindings.push_back(attributeBinding);
+
+	for (VkVertexInputAttributeDescription& attribute : description.attributes)
+	{
+		if (attribute.location == 0)
+			continue;
+		attribute.binding = 1;
+		attribute.offset -= positionSize;
+	}
+}
+
+
+VertexInputDescription Vertex::GetVertexDescription(bool splitPositions)
 {
 	VertexInputDescription description;
 
@@ -47,10 +93,99 @@ VertexInputDescription Vertex::GetVertexDescription()
 	description.attributes.push_back(colorAttribute);
 	description.attributes.push_back(uvAttribute);
 
+	if (splitPositions)
+		SplitPositionBinding(description, sizeof(Vertex::position));
+
 	return description;
 }
 
 
+VertexInputDescription GetVertexDescription(VertexLayout layout)
+{
+	if (!IsQuantizedLayout(layout))
+		return Vertex::GetVertexDescription(IsSplitLayout(layout));
+
+	// Quantized: same shader inputs, read through normalizing formats
+	VertexInputDescription description;
+
+	VkVertexInputBindingDescription mainBinding = {};
+	mainBinding.binding = 0;
+	mainBinding.stride = sizeof(assets::Vertex_P16N8C8V16);
+	mainBinding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+	description.bindings.push_back(mainBinding);
+
+	VkVertexInputAttributeDescription positionAttribute = {};
+	positionAttribute.binding = 0;
+	positionAttribute.location = 0;
+	positionAttribute.format = VK_FORMAT_R16G16B16A16_UNORM;
+	positionAttribute.offset = offsetof(assets::Vertex_P16N8C8V16, position);
+
+	VkVertexInputAttributeDescription normalAttribute = {};
+	normalAttribute.binding = 0;
+	normalAttribute.location = 1;
+	normalAttribute.format = VK_FORMAT_R8G8_UNORM;
+	normalAttribute.offset = offsetof(assets::Vertex_P16N8C8V16, octNormal);
+
+	VkVertexInputAttributeDescription colorAttribute = {};
+	colorAttribute.binding = 0;
+	colorAttribute.location = 2;
+	colorAttribute.format = VK_FORMAT_R8G8B8A8_UNORM;
+	colorAttribute.offset = offsetof(assets::Vertex_P16N8C8V16, color);
+
+	VkVertexInputAttributeDescription uvAttribute = {};
+	uvAttribute.binding = 0;
+	uvAttribute.location = 3;
+	uvAttribute.format = VK_FORMAT_R16G16_SFLOAT;
+	uvAttribute.offset = offsetof(assets::Vertex_P16N8C8V16, uv);
+
+	description.attributes.push_back(positionAttribute);
+	description.attributes.push_back(normalAttribute);
+	description.attributes.push_back(colorAttribute);
+	description.attributes.push_back(uvAttribute);
+
+	if (IsSplitLayout(layout))
+		SplitPositionBinding(description, sizeof(assets::Vertex_P16N8C8V16::position));
+
+	return description;
+}
+
+
+VertexInputDescription GetPositionDescription(VertexLayout layout)
+{
+	VertexInputDescription description = GetVertexDescription(layout);
+	description.bindings.resize(1);
+	description.attributes.resize(1);
+	return description;
+}
+
+
+size_t GetVertexStride(VertexLayout layout)
+{
+	return IsQuantizedLayout(layout) ? sizeof(assets::Vertex_P16N8C8V16) : sizeof(Vertex);
+}
+
+
+size_t GetPositionStride(VertexLayout layout)
+{
+	if (!IsSplitLayout(layout))
+		return GetVertexStride(layout);
+	return IsQuantizedLayout(layout) ? sizeof(assets::Vertex_P16N8C8V16::position) : sizeof(Vertex::position);
+}
+
+
+bool IsQuantizedLayout(VertexLayout layout)
+{
+	return layout == VertexLayout::Quantized || layout == VertexLayout::QuantizedSplit;
+}
+
+
+bool IsSplitLayout(VertexLayout layout)
+{
+	return layout == VertexLayout::StandardSplit || layout == VertexLayout::QuantizedSplit;
+}
+
+
 glm::vec2 OctNormalWrap(glm::vec2 v)
 {
 	glm::vec2 wrap;
@@ -110,16 +245,42 @@ void Vertex::PackColor(glm::vec3 c)
 
 bool Mesh::LoadFromAsset(const char* filename)
 {
-	assets::AssetFile asset;
+	assets::AssetView asset;
 
-	bool loaded = assets::LoadBinary(filename, asset);
+	bool loaded = assets::LoadBinaryMapped(filename, asset, GetAssetVerifyFlags());
 	if (!loaded)
 	{
 		OutputMessage("Error loading mesh: %s", filename);
 		return false;
 	}
 
-	assets::MeshInfo info = assets::ReadMeshInfo(&asset);
+	return LoadFromAsset(asset);
+}
+
+
+bool Mesh::LoadFromAsset(const assets::ArchiveReader& archive, const char* name)
+{
+	assets::AssetView asset;
+
+	bool loaded = archive.LoadAsset(name, asset, GetAssetVerifyFlags());
+	if (!loaded)
+	{
+		OutputMessage("Error loading mesh from archive: %s", name);
+		return false;
+	}
+
+	return LoadFromAsset(asset);
+}
+
+
+bool Mesh::LoadFromAsset(const assets::AssetView& asset)
+{
+	assets::MeshInfo info;
+	if (!assets::ReadMeshInfo(&asset, info))
+	{
+		OutputMessage("Error reading mesh metadata");
+		return false;
+	}
 
 	std::vector<char> vertexBuffer;
 	std::vector<char> indexBuffer;
@@ -127,7 +288,11 @@ bool Mesh::LoadFromAsset(const char* filename)
 	vertexBuffer.resize(info.vertexBufferSize);
 	indexBuffer.resize(info.indexBufferSize);
 
-	assets::UnpackMesh(&info, asset.blob.data(), asset.blob.size(), vertexBuffer.data(), indexBuffer.data());
+	if (!assets::UnpackMesh(&info, asset.blob, asset.blobSize, vertexBuffer.data(), indexBuffer.data(), GetAssetVerifyFlags()))
+	{
+		OutputMessage("Error unpacking mesh: %s", info.sourceFile.c_str());
+		return false;
+	}
 
 	bounds.extents.x = info.bounds.extents[0];
 	bounds.extents.y = info.bounds.extents[1];
@@ -138,19 +303,69 @@ bool Mesh::LoadFromAsset(const char* filename)
 	bounds.origin.z = info.bounds.origin[2];
 	bounds.isValid = true;
 
+	lods.clear();
+	lods.reserve(info.lods.size());
+	for (const assets::MeshLod& lod : info.lods)
+		lods.push_back({ lod.firstIndex, lod.indexCount, lod.error });
+
+	clusters.clear();
+	clusters.reserve(info.meshlets.size());
+	for (const assets::Meshlet& meshlet : info.meshlets)
+	{
+		RenderCluster cluster;
+		cluster.firstIndex = meshlet.firstIndex;
+		cluster.indexCount = meshlet.indexCount;
+		cluster.center = glm::vec3(meshlet.center[0], meshlet.center[1], meshlet.center[2]);
+		cluster.radius = meshlet.radius;
+		cluster.coneApex = glm::vec3(meshlet.coneApex[0], meshlet.coneApex[1], meshlet.coneApex[2]);
+		cluster.coneAxis = glm::vec3(meshlet.coneAxis[0], meshlet.coneAxis[1], meshlet.coneAxis[2]);
+		cluster.coneCutoff = meshlet.coneCutoff;
+		clusters.push_back(cluster);
+	}
+
 	vertices.clear();
-	indices.clear();
+	vertexData.clear();
+	indexData.clear();
+	vertexLayout = VertexLayout::Standard;
+	dequantize = glm::mat4{ 1.0f };
+
+	// Indices are uploaded at the size they were cooked with
+	if (!indexBuffer.empty() && info.indexSize != sizeof(uint16_t) && info.indexSize != sizeof(uint32_t))
+	{
+		OutputMessage("Error loading mesh: unsupported index size %u: %s", info.indexSize, info.sourceFile.c_str());
+		return false;
+	}
+	indexType = (info.indexSize == sizeof(uint16_t)) ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+	indexData = std::move(indexBuffer);
 
-	indices.resize(indexBuffer.size() / sizeof(uint32_t));
-	uint32_t* unpackedIndices = (uint32_t*)indexBuffer.data();
-	for (int i = 0; i < indices.size(); ++i)
-		indices[i] = unpackedIndices[i];
+	// Split streams are only uploaded as cooked; the formats converted on load are interleaved
+	const bool splitStreams = (info.vertexStreams == assets::VertexStreams::Split);
+	if (splitStreams && info.vertexFormat != assets::VertexFormat::P16N8C8V16 && info.vertexFormat != assets::VertexFormat::P32N8C8V32)
+	{
+		OutputMessage("Error loading mesh: split vertex streams need P16N8C8V16 or P32N8C8V32: %s", info.sourceFile.c_str());
+		return false;
+	}
 
-	if (info.vertexFormat == assets::VertexFormat::PNCV_F32)
+	if (info.vertexFormat == assets::VertexFormat::P16N8C8V16)
+	{
+		// Uploaded as cooked; unorm positions in [0, 1] map back onto the bounds box
+		vertexLayout = splitStreams ? VertexLayout::QuantizedSplit : VertexLayout::Quantized;
+		vertexData = std::move(vertexBuffer);
+		dequantize = glm::translate(bounds.origin - bounds.extents) * glm::scale(bounds.extents * 2.0f);
+	}
+	else if (info.vertexFormat == assets::VertexFormat::P32N8C8V32)
+	{
+		// Already laid out as Vertex
+		vertexLayout = splitStreams ? VertexLayout::StandardSplit : VertexLayout::Standard;
+		vertexData = std::move(vertexBuffer);
+	}
+	else if (info.vertexFormat == assets::VertexFormat::PNCV_F32)
 	{
 		assets::Vertex_PNCV_F32* unpackedVertices = (assets::Vertex_PNCV_F32*)vertexBuffer.data();
 
 		vertices.resize(vertexBuffer.size() / sizeof(assets::Vertex_PNCV_F32));
+		if (!vertices.empty())
+			assets::EncodeOctNormals(unpackedVertices[0].normal, sizeof(assets::Vertex_PNCV_F32), &vertices[0].octNormal.x, sizeof(Vertex), vertices.size());
 
 		for (int i = 0; i < vertices.size(); ++i)
 		{
@@ -158,12 +373,6 @@ bool Mesh::LoadFromAsset(const char* filename)
 			vertices[i].position.y = unpackedVertices[i].position[1];
 			vertices[i].position.z = unpackedVertices[i].position[2];
 
-			glm::vec3 normal = glm::vec3(
-				unpackedVertices[i].normal[0],
-				unpackedVertices[i].normal[1],
-				unpackedVertices[i].normal[2]);
-			vertices[i].PackNormal(normal);
-
 			glm::vec3 color = glm::vec3(
 				unpackedVertices[i].color[0],
 				unpackedVertices[i].color[1],
@@ -202,6 +411,29 @@ bool Mesh::LoadFromAsset(const char* filename)
 			vertices[i].uv.y = unpackedVertices[i].uv[1];
 		}
 	}
+	else
+	{
+		OutputMessage("Error loading mesh: unknown vertex format %u: %s", static_cast<uint32_t>(info.vertexFormat), info.sourceFile.c_str());
+		return false;
+	}
+
+	// Nothing to upload; a zero-sized vertex buffer can't be created
+	if (GetVertexCount() == 0)
+	{
+		OutputMessage("Error loading mesh: no vertices: %s", info.sourceFile.c_str());
+		return false;
+	}
+
+	// The blob hash doesn't vouch for the indices making sense, and the GPU won't check them
+	const bool indicesValid = (indexType == VK_INDEX_TYPE_UINT16)
+		? CheckIndices<uint16_t>(indexData.data(), indexData.size(), GetVertexCount())
+		: CheckIndices<uint32_t>(indexData.data(), indexData.size(), GetVertexCount());
+	if (!indicesValid)
+	{
+		OutputMessage("Error loading mesh: indices address past the vertices: %s", info.sourceFile.c_str());
+		indexData.clear();
+		return false;
+	}
 
 	// log success
 
@@ -305,6 +537,31 @@ bool Mesh::LoadFromObj(const char* filename)
 }
 
 
+size_t Mesh::GetVertexCount() const
+{
+	if (!vertexData.empty())
+		return vertexData.size() / GetVertexStride(vertexLayout);
+	return vertices.size();
+}
+
+size_t Mesh::GetIndexCount() const
+{
+	return indexData.size() / ((indexType == VK_INDEX_TYPE_UINT16) ? sizeof(uint16_t) : sizeof(uint32_t));
+}
+
+
+int Mesh::SelectLod(float maxError) const
+{
+	if (lods.empty())
+		return -1;
+
+	int lod = 0;
+	while (lod + 1 < static_cast<int>(lods.size()) && lods[lod + 1].error <= maxError)
+		++lod;
+	return lod;
+}
+
+
 glm::vec3 Mesh::GetObjectCenter() const
 {
 	return (objPosMin + objPosMax) * 0.5f;
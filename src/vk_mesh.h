@@ -4,6 +4,14 @@
 #include <vector>
 #include <glm/vec3.hpp>
 #include <glm/vec2.hpp>
+#include <glm/mat4x4.hpp>
+
+
+namespace assets
+{
+	struct AssetView;
+	class ArchiveReader;
+}
 
 
 struct VertexInputDescription
@@ -21,12 +29,32 @@ struct Vertex
  	glm::vec<3, uint8_t> color;
 	glm::vec2 uv;
 
-	static VertexInputDescription GetVertexDescription();
+	// With splitPositions, binding 0 holds only the tightly packed positions and binding 1 the rest
+	static VertexInputDescription GetVertexDescription(bool splitPositions = false);
 
 	void PackNormal(glm::vec3 n);
 	void PackColor(glm::vec3 c);
 };
 
+// Vertex layouts a mesh can be uploaded in; mesh materials have a pipeline for each
+enum class VertexLayout : uint32_t
+{
+	Standard,	// Vertex, also cooked as assets::Vertex_P32N8C8V32
+	Quantized,	// assets::Vertex_P16N8C8V16 exactly as cooked, positions normalized to the mesh bounds
+	StandardSplit,	// Standard cooked as assets::VertexStreams::Split: every position, then the other attributes
+	QuantizedSplit,	// Quantized cooked the same way; both streams live in one buffer, bound twice
+};
+constexpr size_t VERTEX_LAYOUT_COUNT = 4;
+
+VertexInputDescription GetVertexDescription(VertexLayout layout);
+// Just the position attribute at location 0, for depth-only passes. Split layouts fetch only the
+// position stream through it.
+VertexInputDescription GetPositionDescription(VertexLayout layout);
+size_t GetVertexStride(VertexLayout layout);		// Bytes per vertex across all streams
+size_t GetPositionStride(VertexLayout layout);		// Bytes per vertex in binding 0
+bool IsQuantizedLayout(VertexLayout layout);
+bool IsSplitLayout(VertexLayout layout);
+
 struct RenderBounds
 {
 	glm::vec3 origin;
@@ -35,18 +63,52 @@ struct RenderBounds
 	bool isValid;
 };
 
+// A simplified version of the mesh, drawn from its own run of the index buffer
+struct RenderLod
+{
+	uint32_t firstIndex;
+	uint32_t indexCount;
+	float error;		// Furthest its surface strays from the full mesh, in mesh units
+};
+
+// Culling data for one run of the index buffer, loaded from the asset's meshlets
+struct RenderCluster
+{
+	uint32_t firstIndex;
+	uint32_t indexCount;
+	glm::vec3 center;
+	float radius;
+	glm::vec3 coneApex;
+	glm::vec3 coneAxis;
+	float coneCutoff;	// Back-facing from p when dot(normalize(coneApex - p), coneAxis) >= coneCutoff
+};
+
 struct Mesh
 {
-	std::vector<Vertex> vertices;
-	std::vector<uint32_t> indices;
+	std::vector<Vertex> vertices;		// Standard layout built on the CPU; empty when vertexData is used
+	std::vector<char> vertexData;		// Cooked vertices in vertexLayout, uploaded without conversion; split layouts keep both streams here
+	VertexLayout vertexLayout{ VertexLayout::Standard };
+	glm::mat4 dequantize{ 1.0f };		// Maps quantized positions into mesh space, applied ahead of the object transform
+	std::vector<char> indexData;		// Cooked indices in indexType, uploaded without conversion; empty for unindexed meshes, which draw every vertex in order
 	AllocatedBuffer vertexBuffer{ nullptr, nullptr };
 	AllocatedBuffer indexBuffer{ nullptr, nullptr };
+	VkIndexType indexType{ VK_INDEX_TYPE_UINT32 };	// The cooked index size
 
 	RenderBounds bounds;
+	std::vector<RenderLod> lods;			// Finest first; empty for assets cooked without LODs
+	std::vector<RenderCluster> clusters;	// Empty for assets cooked without meshlets
 
 	bool LoadFromAsset(const char* filename);
+	bool LoadFromAsset(const assets::ArchiveReader& archive, const char* name);
+	bool LoadFromAsset(const assets::AssetView& asset);
 	bool LoadFromObj(const char* filename);
 
+	size_t GetVertexCount() const;
+	size_t GetIndexCount() const;
+
+	// Coarsest LOD whose error stays under maxError (in mesh units), or -1 if there are none
+	int SelectLod(float maxError) const;
+
 	// Deprecated
 	glm::vec3 objPosMin{ 0.0f };
 	glm::vec3 objPosMax{ 0.0f };
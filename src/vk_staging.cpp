@@ -0,0 +1,146 @@
+#include "vk_staging.h"
+
+#include "debug.h"
+#include "vk_initializers.h"
+
+
+bool StagingRing::Init(VkDevice inDevice, VmaAllocator inAllocator, VkQueue inQueue, uint32_t queueFamily, VkDeviceSize size, uint32_t segmentCount)
+{
+	device = inDevice;
+	allocator = inAllocator;
+	queue = inQueue;
+
+	if (segmentCount == 0)
+		segmentCount = 1;
+
+	// Segments start on a generous boundary, so copies out of them satisfy any texel alignment
+	segmentSize = (size / segmentCount) & ~VkDeviceSize(255);
+	if (segmentSize == 0)
+		return false;
+
+	VkBufferCreateInfo bufferInfo = {};
+	bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+	bufferInfo.size = segmentSize * segmentCount;
+	bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+	VmaAllocationCreateInfo allocInfo = {};
+	allocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
+	allocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+	VmaAllocationInfo allocResult = {};
+	if (vmaCreateBuffer(allocator, &bufferInfo, &allocInfo, &buffer.buffer, &buffer.allocation, &allocResult) != VK_SUCCESS)
+	{
+		OutputMessage("Error creating %llu byte staging ring\n", static_cast<unsigned long long>(bufferInfo.size));
+		return false;
+	}
+	mapped = reinterpret_cast<char*>(allocResult.pMappedData);
+
+	segments.resize(segmentCount);
+	for (auto& segment : segments)
+	{
+		VkCommandPoolCreateInfo commandPoolInfo = vkinit::CommandPoolCreateInfo(queueFamily);
+		VK_CHECK(vkCreateCommandPool(device, &commandPoolInfo, nullptr, &segment.commandPool));
+
+		VkCommandBufferAllocateInfo cmdAllocInfo = vkinit::CommandBufferAllocateInfo(segment.commandPool, 1);
+		VK_CHECK(vkAllocateCommandBuffers(device, &cmdAllocInfo, &segment.commandBuffer));
+
+		VkFenceCreateInfo fenceCreateInfo = vkinit::FenceCreateInfo();
+		VK_CHECK(vkCreateFence(device, &fenceCreateInfo, nullptr, &segment.fence));
+	}
+
+	current = 0;
+	cursor = 0;
+
+	return true;
+}
+
+void StagingRing::Cleanup()
+{
+	if (segments.empty())
+		return;
+
+	Flush();
+
+	for (auto& segment : segments)
+	{
+		vkDestroyFence(device, segment.fence, nullptr);
+		vkDestroyCommandPool(device, segment.commandPool, nullptr);
+	}
+	segments.clear();
+
+	vmaDestroyBuffer(allocator, buffer.buffer, buffer.allocation);
+	buffer = { nullptr, nullptr };
+	mapped = nullptr;
+}
+
+void* StagingRing::Allocate(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset)
+{
+	if (size > segmentSize)
+		return nullptr;
+
+	VkDeviceSize start = (cursor + alignment - 1) / alignment * alignment;
+	if (start + size > segmentSize)
+	{
+		Submit();
+		start = 0;
+	}
+
+	cursor = start + size;
+	offset = current * segmentSize + start;
+
+	return mapped + offset;
+}
+
+VkCommandBuffer StagingRing::GetCommandBuffer()
+{
+	Segment& segment = segments[current];
+	if (!segment.recording)
+	{
+		VkCommandBufferBeginInfo cmdBeginInfo = vkinit::CommandBufferBeginInfo(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+		VK_CHECK(vkBeginCommandBuffer(segment.commandBuffer, &cmdBeginInfo));
+		segment.recording = true;
+	}
+	return segment.commandBuffer;
+}
+
+void StagingRing::Submit()
+{
+	Segment& segment = segments[current];
+	if (segment.recording)
+	{
+		VK_CHECK(vkEndCommandBuffer(segment.commandBuffer));
+
+		VkSubmitInfo submit = vkinit::SubmitInfo(&segment.commandBuffer);
+		VK_CHECK(vkQueueSubmit(queue, 1, &submit, segment.fence));
+
+		segment.recording = false;
+		segment.pending = true;
+	}
+
+	// The next segment's memory can only be written once the GPU has consumed it
+	current = (current + 1) % static_cast<uint32_t>(segments.size());
+	cursor = 0;
+	Retire(segments[current]);
+}
+
+void StagingRing::Flush()
+{
+	if (segments[current].recording)
+		Submit();
+
+	for (auto& segment : segments)
+		Retire(segment);
+
+	cursor = 0;
+}
+
+void StagingRing::Retire(Segment& segment)
+{
+	if (!segment.pending)
+		return;
+
+	vkWaitForFences(device, 1, &segment.fence, VK_TRUE, 9999999999);
+	vkResetFences(device, 1, &segment.fence);
+	vkResetCommandPool(device, segment.commandPool, 0);
+	segment.pending = false;
+}
\ No newline at end of file
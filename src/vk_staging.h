@@ -0,0 +1,56 @@
+#pragma once
+
+#include <vector>
+#include "vk_types.h"
+
+
+// One persistently mapped upload buffer, split into segments that each own a command buffer and
+// fence. Uploads are decoded straight into the mapping and recorded against the current segment;
+// when it fills up it's submitted and the ring moves on, only waiting if the GPU hasn't finished
+// with the next segment yet. Host memory used for uploads stays at the ring size no matter how
+// large the assets are.
+class StagingRing
+{
+public:
+	bool Init(VkDevice device, VmaAllocator allocator, VkQueue queue, uint32_t queueFamily, VkDeviceSize size, uint32_t segmentCount = 2);
+	void Cleanup();
+
+	// Returns mapped memory for size bytes, with offset set to its position in GetBuffer().
+	// May submit the current segment, so fetch the command buffer again afterwards.
+	// Returns nullptr if size doesn't fit in a single segment.
+	void* Allocate(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset);
+
+	// Command buffer of the current segment, begun on first use
+	VkCommandBuffer GetCommandBuffer();
+	VkBuffer GetBuffer() const { return buffer.buffer; }
+	VkDeviceSize GetSegmentSize() const { return segmentSize; }
+
+	// Submits the current segment and moves to the next one
+	void Submit();
+	// Submits any recorded work and waits for all of it to complete
+	void Flush();
+
+private:
+	struct Segment
+	{
+		VkCommandPool commandPool{ nullptr };
+		VkCommandBuffer commandBuffer{ nullptr };
+		VkFence fence{ nullptr };
+		bool recording{ false };
+		bool pending{ false };
+	};
+
+	void Retire(Segment& segment);
+
+	VkDevice device{ nullptr };
+	VmaAllocator allocator{ nullptr };
+	VkQueue queue{ nullptr };
+
+	AllocatedBuffer buffer{ nullptr, nullptr };
+	char* mapped{ nullptr };
+	VkDeviceSize segmentSize{ 0 };
+
+	std::vector<Segment> segments;
+	uint32_t current{ 0 };
+	VkDeviceSize cursor{ 0 };	// Offset into the current segment
+};
\ No newline at end of file
@@ -0,0 +1,556 @@
+#include "vk_texture_streaming.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include "debug.h"
+#include "vk_engine.h"
+#include "vk_initializers.h"
+#include "vk_textures.h"
+
+
+// Decodes mips firstMip .. endMip - 1 from their compressed chunks, which start at source
+static bool DecodeMips(const assets::TextureInfo& info, uint32_t firstMip, uint32_t endMip, const char* source, char* destination)
+{
+	const uint32_t endChunk = (endMip < info.pageLocations.size()) ? info.pageLocations[endMip].firstChunk : static_cast<uint32_t>(info.chunks.size());
+	for (uint32_t chunk = info.pageLocations[firstMip].firstChunk; chunk < endChunk; ++chunk)
+	{
+		if (!assets::UnpackTextureChunk(&info, chunk, source, destination))
+			return false;
+
+		source += info.chunks[chunk].compressedSize;
+		destination += info.chunks[chunk].originalSize;
+	}
+	return true;
+}
+
+// Compressed bytes from the start of firstMip to the start of endMip (or the end of the blob)
+static uint64_t GetBlobRange(const assets::TextureInfo& info, uint32_t firstMip, uint32_t endMip, uint64_t& begin)
+{
+	begin = info.pageLocations[firstMip].blobOffset;
+	const uint64_t end = (endMip < info.pageLocations.size()) ? info.pageLocations[endMip].blobOffset
+		: info.pageLocations.back().blobOffset + info.pages.back().compressedSize;
+	return end - begin;
+}
+
+static uint64_t GetMipsBytes(const assets::TextureInfo& info, uint32_t firstMip)
+{
+	return assets::GetTextureMipsSize(&info, firstMip, static_cast<uint32_t>(info.pages.size()) - firstMip);
+}
+
+bool TextureStreamer::Init(VulkanEngine& engine, VkDescriptorSetLayout textureSetLayout)
+{
+	VkDescriptorPoolSize size = { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, MAX_TEXTURES * FRAME_OVERLAP };
+
+	VkDescriptorPoolCreateInfo poolInfo = {};
+	poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	poolInfo.pPoolSizes = &size;
+	poolInfo.poolSizeCount = 1;
+	poolInfo.maxSets = MAX_TEXTURES * FRAME_OVERLAP;
+
+	if (vkCreateDescriptorPool(engine.device, &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS)
+		return false;
+
+	// Reads are few and large, so a couple of workers keep up
+	if (!io.Start(2))
+	{
+		vkDestroyDescriptorPool(engine.device, descriptorPool, nullptr);
+		descriptorPool = VK_NULL_HANDLE;
+		return false;
+	}
+
+	this->engine = &engine;
+	setLayout = textureSetLayout;
+	return true;
+}
+
+void TextureStreamer::Cleanup()
+{
+	if (engine == nullptr)
+		return;
+
+	io.Stop();
+	finished.clear();
+	readsInFlight = 0;
+
+	for (const Retired& old : retired)
+	{
+		vkDestroyImageView(engine->device, old.view, nullptr);
+		vmaDestroyImage(engine->allocator, old.image.image, old.image.allocation);
+	}
+	retired.clear();
+
+	for (auto& texture : textures)
+	{
+		vkDestroyImageView(engine->device, texture->view, nullptr);
+		vmaDestroyImage(engine->allocator, texture->image.image, texture->image.allocation);
+	}
+	textures.clear();
+	names.clear();
+	materialTextures.clear();
+	residentBytes = 0;
+
+	// Frees every set with it
+	vkDestroyDescriptorPool(engine->device, descriptorPool, nullptr);
+	descriptorPool = VK_NULL_HANDLE;
+	engine = nullptr;
+}
+
+bool TextureStreamer::Register(const std::string& name, const char* path, uint64_t offset)
+{
+	if (engine == nullptr || textures.size() >= MAX_TEXTURES || IsRegistered(name))
+		return false;
+
+	auto texture = std::make_unique<StreamedTexture>();
+	texture->path = path;
+
+	assets::AssetFile header;
+	uint64_t blobSize = 0;
+	if (!assets::LoadBinaryHeader(path, offset, header, texture->blobOffset, blobSize))
+	{
+		OutputMessage("Error loading cooked image asset: %s", path);
+		return false;
+	}
+
+	assets::TextureInfo& info = texture->info;
+	if (!assets::ReadTextureInfo(&header, info))
+	{
+		OutputMessage("Error reading cooked image metadata: %s", path);
+		return false;
+	}
+	if (info.pages.empty() || vkutil::GetImageFormat(info.textureFormat) == VK_FORMAT_UNDEFINED || assets::IsTextureTiled(&info))
+		return false;
+	// Every later read is a range of the blob worked out from the page table
+	if (assets::GetTextureBlobSize(&info) > blobSize)
+	{
+		OutputMessage("Cooked image is truncated: %s", path);
+		return false;
+	}
+
+	// Files cooked before chunking hold each page as one block, which may not fit a ring segment
+	for (const assets::TextureChunk& chunk : info.chunks)
+	{
+		if (chunk.originalSize > engine->stagingRing.GetSegmentSize())
+			return false;
+	}
+
+	texture->chunkRanges = assets::GetTextureChunkRanges(&info);
+
+	const uint32_t mipCount = static_cast<uint32_t>(info.pages.size());
+	uint32_t tailMip = mipCount - 1;
+	while (tailMip > 0 && std::max(info.pages[tailMip - 1].width, info.pages[tailMip - 1].height) <= RESIDENT_TAIL_DIM)
+		--tailMip;
+	texture->tailMip = tailMip;
+	texture->wantedMip = tailMip;
+
+	// The tail is small, so it's read here and the texture is usable straight away
+	uint64_t begin = 0;
+	std::vector<char> compressed(GetBlobRange(info, tailMip, mipCount, begin));
+	std::ifstream file(path, std::ios::binary);
+	file.seekg(texture->blobOffset + begin);
+	file.read(compressed.data(), compressed.size());
+
+	std::vector<char> pixels(GetMipsBytes(info, tailMip));
+	if (!file.good() || !DecodeMips(info, tailMip, mipCount, compressed.data(), pixels.data()) || !Rebuild(*texture, tailMip, pixels.data()))
+	{
+		OutputMessage("Error unpacking cooked image: %s", info.sourceFile.c_str());
+		return false;
+	}
+
+	names[name] = static_cast<uint32_t>(textures.size());
+	textures.push_back(std::move(texture));
+	return true;
+}
+
+bool TextureStreamer::BindMaterial(const std::string& name, Material* material, VkSampler sampler)
+{
+	auto found = names.find(name);
+	if (found == names.end())
+		return false;
+
+	StreamedTexture& texture = *textures[found->second];
+	if (texture.sets.empty())
+	{
+		std::vector<VkDescriptorSetLayout> layouts(FRAME_OVERLAP, setLayout);
+		texture.sets.resize(FRAME_OVERLAP);
+		texture.setViews.assign(FRAME_OVERLAP, VK_NULL_HANDLE);
+
+		VkDescriptorSetAllocateInfo allocInfo = {};
+		allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		allocInfo.descriptorPool = descriptorPool;
+		allocInfo.descriptorSetCount = FRAME_OVERLAP;
+		allocInfo.pSetLayouts = layouts.data();
+		if (vkAllocateDescriptorSets(engine->device, &allocInfo, texture.sets.data()) != VK_SUCCESS)
+		{
+			texture.sets.clear();
+			return false;
+		}
+
+		// Nothing is in flight yet, so every set can be written now
+		texture.sampler = sampler;
+		for (uint32_t i = 0; i < FRAME_OVERLAP; ++i)
+			WriteSet(texture, i);
+	}
+	else if (sampler != texture.sampler)
+	{
+		OutputMessage("Streamed texture %s is already bound with another sampler", name.c_str());
+		return false;
+	}
+
+	texture.materials.push_back(material);
+	materialTextures[material] = found->second;
+	material->textureSet = texture.sets[engine->frameNumber % FRAME_OVERLAP];
+	return true;
+}
+
+void TextureStreamer::WriteSet(StreamedTexture& texture, uint32_t frameIndex)
+{
+	VkDescriptorImageInfo imageBufferInfo = {};
+	imageBufferInfo.sampler = texture.sampler;
+	imageBufferInfo.imageView = texture.view;
+	imageBufferInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	VkWriteDescriptorSet write = vkinit::WriteDescriptorImage(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, texture.sets[frameIndex], &imageBufferInfo, 0);
+	vkUpdateDescriptorSets(engine->device, 1, &write, 0, nullptr);
+
+	texture.setViews[frameIndex] = texture.view;
+}
+
+bool TextureStreamer::Rebuild(StreamedTexture& texture, uint32_t firstMip, const char* pixels)
+{
+	const assets::TextureInfo& info = texture.info;
+	const uint32_t mipCount = static_cast<uint32_t>(info.pages.size());
+	const bool hasOld = texture.image.image != nullptr;
+	// Levels from here on are already on the GPU
+	const uint32_t uploadEnd = hasOld ? std::max(firstMip, texture.firstMip) : mipCount;
+	const uint32_t blockDim = assets::GetTextureBlockDim(info.textureFormat);
+	StagingRing& ring = engine->stagingRing;
+
+	VkExtent3D imageExtent;
+	imageExtent.width = info.pages[firstMip].width;
+	imageExtent.height = info.pages[firstMip].height;
+	imageExtent.depth = 1;
+
+	// Also a transfer source, for the next rebuild to copy from
+	const VkFormat format = vkutil::GetImageFormat(info.textureFormat);
+	VkImageCreateInfo dimgInfo = vkinit::ImageCreateInfo(format, VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT, imageExtent);
+	dimgInfo.mipLevels = mipCount - firstMip;
+
+	AllocatedImage newImage{ nullptr, nullptr, static_cast<int>(dimgInfo.mipLevels), format };
+	VmaAllocationCreateInfo dimgAllocInfo = {};
+	dimgAllocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+	if (vmaCreateImage(engine->allocator, &dimgInfo, &dimgAllocInfo, &newImage.image, &newImage.allocation, nullptr) != VK_SUCCESS)
+	{
+		OutputMessage("Out of memory for streamed texture: %s", info.sourceFile.c_str());
+		return false;
+	}
+
+	// Made before anything is recorded, so on failure the image can go straight away and the
+	// texture keeps its old image and view
+	VkImageViewCreateInfo viewInfo = vkinit::ImageViewCreateInfo(format, newImage.image, VK_IMAGE_ASPECT_COLOR_BIT);
+	viewInfo.subresourceRange.levelCount = dimgInfo.mipLevels;
+	VkImageView view = VK_NULL_HANDLE;
+	if (vkCreateImageView(engine->device, &viewInfo, nullptr, &view) != VK_SUCCESS)
+	{
+		OutputMessage("Error creating view for streamed texture: %s", info.sourceFile.c_str());
+		vmaDestroyImage(engine->allocator, newImage.image, newImage.allocation);
+		return false;
+	}
+
+	VkImageMemoryBarrier imageBarrierToTransfer = {};
+	imageBarrierToTransfer.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+	imageBarrierToTransfer.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	imageBarrierToTransfer.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	imageBarrierToTransfer.image = newImage.image;
+	imageBarrierToTransfer.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, dimgInfo.mipLevels, 0, 1 };
+	imageBarrierToTransfer.srcAccessMask = 0;
+	imageBarrierToTransfer.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+	vkCmdPipelineBarrier(ring.GetCommandBuffer(), VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageBarrierToTransfer);
+
+	// New levels go up a chunk at a time, the same way a streamed load does
+	const uint64_t pixelsStart = info.pageLocations[firstMip].dataOffset;
+	const uint32_t endChunk = (uploadEnd < mipCount) ? info.pageLocations[uploadEnd].firstChunk : static_cast<uint32_t>(info.chunks.size());
+	for (uint32_t i = info.pageLocations[firstMip].firstChunk; i < endChunk; ++i)
+	{
+		const assets::TextureChunk& chunk = info.chunks[i];
+		const assets::TextureChunkRange& range = texture.chunkRanges[i];
+		const assets::PageInfo& page = info.pages[range.page];
+		// Rows of blocks for BCn; the last one may run past the bottom of the mip
+		const uint32_t rowPitch = page.originalSize / std::max(1u, assets::GetTextureBlockRows(info.textureFormat, page.height));
+
+		VkDeviceSize stagingOffset = 0;
+		char* staging = reinterpret_cast<char*>(ring.Allocate(chunk.originalSize, 16, stagingOffset));
+		std::memcpy(staging, pixels + (info.pageLocations[range.page].dataOffset + range.pageOffset - pixelsStart), chunk.originalSize);
+
+		VkBufferImageCopy copyRegion = {};
+		copyRegion.bufferOffset = stagingOffset;
+		copyRegion.bufferRowLength = 0;
+		copyRegion.bufferImageHeight = 0;
+		copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		copyRegion.imageSubresource.baseArrayLayer = 0;
+		copyRegion.imageSubresource.layerCount = 1;
+		copyRegion.imageSubresource.mipLevel = range.page - firstMip;
+		const uint32_t firstRow = range.pageOffset / rowPitch * blockDim;
+		copyRegion.imageOffset = { 0, static_cast<int32_t>(firstRow), 0 };
+		copyRegion.imageExtent = { page.width, std::min(chunk.originalSize / rowPitch * blockDim, page.height - firstRow), 1 };
+
+		vkCmdCopyBufferToImage(ring.GetCommandBuffer(), ring.GetBuffer(), newImage.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copyRegion);
+	}
+
+	// Levels both images hold are copied across on the GPU
+	if (hasOld)
+	{
+		const uint32_t copyFirst = std::max(firstMip, texture.firstMip);
+
+		VkImageMemoryBarrier oldToSource = {};
+		oldToSource.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		oldToSource.oldLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		oldToSource.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+		oldToSource.image = texture.image.image;
+		oldToSource.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, copyFirst - texture.firstMip, mipCount - copyFirst, 0, 1 };
+		oldToSource.srcAccessMask = 0;
+		oldToSource.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+		// Frames already submitted may still be sampling it
+		vkCmdPipelineBarrier(ring.GetCommandBuffer(), VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &oldToSource);
+
+		std::vector<VkImageCopy> copies;
+		for (uint32_t level = copyFirst; level < mipCount; ++level)
+		{
+			VkImageCopy copy = {};
+			copy.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, level - texture.firstMip, 0, 1 };
+			copy.dstSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, level - firstMip, 0, 1 };
+			copy.extent = { info.pages[level].width, info.pages[level].height, 1 };
+			copies.push_back(copy);
+		}
+		vkCmdCopyImage(ring.GetCommandBuffer(), texture.image.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, newImage.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, static_cast<uint32_t>(copies.size()), copies.data());
+
+		VkImageMemoryBarrier oldToReadable = oldToSource;
+		oldToReadable.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+		oldToReadable.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		oldToReadable.srcAccessMask = 0;
+		oldToReadable.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+		vkCmdPipelineBarrier(ring.GetCommandBuffer(), VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &oldToReadable);
+	}
+
+	VkImageMemoryBarrier imageBarrierToReadable = imageBarrierToTransfer;
+	imageBarrierToReadable.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	imageBarrierToReadable.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	imageBarrierToReadable.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	imageBarrierToReadable.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+	vkCmdPipelineBarrier(ring.GetCommandBuffer(), VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageBarrierToReadable);
+
+	// Not waited on: the frame that first samples it is submitted later on the same queue
+	ring.Submit();
+
+	if (hasOld)
+	{
+		retired.push_back({ texture.image, texture.view, engine->frameNumber });
+		residentBytes -= GetMipsBytes(info, texture.firstMip);
+	}
+	residentBytes += GetMipsBytes(info, firstMip);
+
+	texture.image = newImage;
+	texture.view = view;
+	texture.firstMip = firstMip;
+	return true;
+}
+
+bool TextureStreamer::RequestMips(uint32_t index, uint32_t firstMip)
+{
+	StreamedTexture& texture = *textures[index];
+	const uint32_t endMip = texture.firstMip;
+
+	uint64_t begin = 0;
+	const uint64_t size = GetBlobRange(texture.info, firstMip, endMip, begin);
+
+	// Textures are never removed while reads are in flight, so the info stays put
+	const assets::TextureInfo* info = &texture.info;
+	const bool requested = io.Request(texture.path.c_str(), texture.blobOffset + begin, size, [this, index, firstMip, endMip, info](assets::AssetRead& read)
+		{
+			FinishedRead result{ index, firstMip, endMip, {}, read.ok };
+			if (result.ok)
+			{
+				result.pixels.resize(assets::GetTextureMipsSize(info, firstMip, endMip - firstMip));
+				result.ok = DecodeMips(*info, firstMip, endMip, read.data.data(), result.pixels.data());
+			}
+
+			std::lock_guard<std::mutex> lock(finishedMutex);
+			finished.push_back(std::move(result));
+		});
+
+	if (requested)
+	{
+		texture.reading = true;
+		++readsInFlight;
+	}
+	return requested;
+}
+
+// The mip whose texels are closest to the pixels its nearest visible object covers, treating the
+// texture as stretched once across the object's bounds. Textures no object shows keep what they have.
+void TextureStreamer::ChooseMips(const RenderObject* objects, size_t count)
+{
+	const glm::mat4 viewProj = engine->GetProjectionMatrix() * engine->GetViewMatrix();
+	const float pixelScale = static_cast<float>(engine->windowExtent.height) / (2.0f * tanf(glm::radians(engine->fieldOfView) * 0.5f));
+	const glm::vec3 eye = -engine->camPos;
+
+	// Frustum planes, pointing inwards (glm::perspective's depth runs -1 to 1)
+	const glm::mat4 m = glm::transpose(viewProj);
+	const glm::vec4 planes[] = { m[3] + m[0], m[3] - m[0], m[3] + m[1], m[3] - m[1], m[3] + m[2], m[3] - m[2] };
+
+	for (auto& texture : textures)
+		texture->wantedMip = ~0u;
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		const RenderObject& object = objects[i];
+		auto found = materialTextures.find(object.material);
+		if (found == materialTextures.end() || object.mesh == nullptr)
+			continue;
+
+		StreamedTexture& texture = *textures[found->second];
+		uint32_t mip = 0;
+		if (object.mesh->bounds.isValid)
+		{
+			const glm::mat4& model = object.transformMatrix;
+			const float scale = glm::max(glm::length(glm::vec3(model[0])), glm::max(glm::length(glm::vec3(model[1])), glm::length(glm::vec3(model[2]))));
+			const glm::vec3 center = glm::vec3(model * glm::vec4(object.mesh->bounds.origin, 1.0f));
+			const float radius = object.mesh->bounds.radius * scale;
+
+			bool visible = true;
+			for (const glm::vec4& plane : planes)
+				visible = visible && glm::dot(glm::vec3(plane), center) + plane.w >= -radius * glm::length(glm::vec3(plane));
+			if (!visible)
+				continue;
+
+			const float distance = glm::max(glm::length(center - eye) - radius, 0.1f);
+			const float pixels = glm::max(2.0f * radius * pixelScale / distance, 1.0f);
+			const float texels = static_cast<float>(std::max(texture.info.pages[0].width, texture.info.pages[0].height));
+			mip = static_cast<uint32_t>(glm::clamp(std::floor(std::log2(texels / pixels)), 0.0f, static_cast<float>(texture.tailMip)));
+		}
+
+		texture.wantedMip = std::min(texture.wantedMip, mip);
+		texture.lastSeen = engine->frameNumber;
+	}
+
+	for (auto& texture : textures)
+	{
+		if (texture->wantedMip == ~0u)
+			texture->wantedMip = texture->firstMip;
+	}
+}
+
+// Coarsens the wanted mips until they fit: first textures no object shows, least recently seen
+// first, down to their tails; then a level at a time off whichever visible texture is largest
+void TextureStreamer::FitBudget(uint64_t budgetBytes)
+{
+	uint64_t total = 0;
+	for (auto& texture : textures)
+		total += GetMipsBytes(texture->info, texture->wantedMip);
+	if (total <= budgetBytes)
+		return;
+
+	std::vector<StreamedTexture*> order;
+	for (auto& texture : textures)
+		order.push_back(texture.get());
+	std::sort(order.begin(), order.end(), [](const StreamedTexture* a, const StreamedTexture* b) { return a->lastSeen < b->lastSeen; });
+
+	for (StreamedTexture* texture : order)
+	{
+		if (total <= budgetBytes || texture->lastSeen == engine->frameNumber)
+			break;
+
+		total -= GetMipsBytes(texture->info, texture->wantedMip);
+		texture->wantedMip = texture->tailMip;
+		total += GetMipsBytes(texture->info, texture->wantedMip);
+	}
+
+	while (total > budgetBytes)
+	{
+		StreamedTexture* largest = nullptr;
+		for (StreamedTexture* texture : order)
+		{
+			if (texture->wantedMip < texture->tailMip && (largest == nullptr || GetMipsBytes(texture->info, texture->wantedMip) > GetMipsBytes(largest->info, largest->wantedMip)))
+				largest = texture;
+		}
+		if (largest == nullptr)
+			break;
+
+		total -= GetMipsBytes(largest->info, largest->wantedMip);
+		++largest->wantedMip;
+		total += GetMipsBytes(largest->info, largest->wantedMip);
+	}
+}
+
+void TextureStreamer::Update(const RenderObject* objects, size_t count, uint64_t budgetBytes)
+{
+	if (engine == nullptr)
+		return;
+	if (budgetBytes == 0)
+		budgetBytes = UINT64_MAX;
+
+	std::vector<FinishedRead> reads;
+	{
+		std::lock_guard<std::mutex> lock(finishedMutex);
+		reads.swap(finished);
+	}
+
+	for (FinishedRead& read : reads)
+	{
+		StreamedTexture& texture = *textures[read.texture];
+		texture.reading = false;
+		--readsInFlight;
+
+		if (!read.ok)
+			OutputMessage("Error streaming mips of cooked image: %s", texture.info.sourceFile.c_str());
+		// Dropped if the texture was demoted while reading, since the levels no longer join up
+		else if (read.endMip == texture.firstMip)
+			Rebuild(texture, read.firstMip, read.pixels.data());
+	}
+
+	ChooseMips(objects, count);
+	const uint64_t before = residentBytes;
+	FitBudget(budgetBytes);
+
+	for (uint32_t i = 0; i < textures.size(); ++i)
+	{
+		StreamedTexture& texture = *textures[i];
+
+		// A level of slack before visible textures demote, so they don't thrash at the boundary;
+		// anything pushed out by the budget goes straight away
+		if (texture.wantedMip > texture.firstMip && (texture.wantedMip > texture.firstMip + 1 || texture.lastSeen != engine->frameNumber || before > budgetBytes))
+			Rebuild(texture, texture.wantedMip, nullptr);
+		else if (texture.wantedMip < texture.firstMip && !texture.reading && readsInFlight < MAX_READS_IN_FLIGHT)
+			RequestMips(i, texture.wantedMip);
+	}
+
+	// This frame's sets are no longer in use, since its fence has been waited on
+	const uint32_t frameIndex = engine->frameNumber % FRAME_OVERLAP;
+	for (auto& texture : textures)
+	{
+		if (texture->sets.empty())
+			continue;
+
+		if (texture->setViews[frameIndex] != texture->view)
+			WriteSet(*texture, frameIndex);
+		for (Material* material : texture->materials)
+			material->textureSet = texture->sets[frameIndex];
+	}
+
+	// Once every frame in flight has moved on to the new sets (and the copies out of the old
+	// image, submitted before those frames, are done with it)
+	auto done = std::remove_if(retired.begin(), retired.end(), [this](const Retired& old)
+		{
+			if (old.frame + static_cast<int>(FRAME_OVERLAP) > engine->frameNumber)
+				return false;
+
+			vkDestroyImageView(engine->device, old.view, nullptr);
+			vmaDestroyImage(engine->allocator, old.image.image, old.image.allocation);
+			return true;
+		});
+	retired.erase(done, retired.end());
+}
\ No newline at end of file
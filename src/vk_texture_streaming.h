@@ -0,0 +1,114 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "vk_types.h"
+#include "texture_asset.h"
+#include "asset_io.h"
+
+class VulkanEngine;
+struct Material;
+struct RenderObject;
+
+
+// Keeps cooked textures resident at the mip level their objects need on screen, within a memory
+// budget. Each frame the objects using a texture ask for the mip whose texels roughly match the
+// pixels they cover; finer mips are read on the asset I/O workers and decoded there, then the
+// texture's image is rebuilt through the staging ring with the mips it already had copied across
+// on the GPU. Past the budget, the textures seen least recently drop back to their smallest mips.
+// Materials are rebound by the streamer, through one descriptor set per frame in flight, so a set
+// is only rewritten once the frame that used it has finished.
+class TextureStreamer
+{
+public:
+	bool Init(VulkanEngine& engine, VkDescriptorSetLayout textureSetLayout);
+	// Waits for outstanding reads and destroys every texture, so only call it with the GPU idle
+	void Cleanup();
+
+	// Adds the texture stored at offset in path, with just its smallest mips resident to start
+	bool Register(const std::string& name, const char* path, uint64_t offset);
+	// Points the material's texture set at a streamed texture from now on. Every material of a
+	// texture shares its sets, so they all have to use the same sampler.
+	bool BindMaterial(const std::string& name, Material* material, VkSampler sampler);
+
+	// Once a frame, after waiting for the frame's fence and before recording it: takes finished
+	// reads, picks the mip each texture needs from the objects that use it, then promotes, demotes
+	// and evicts to stay within budgetBytes (0 for no limit)
+	void Update(const RenderObject* objects, size_t count, uint64_t budgetBytes);
+
+	bool IsRegistered(const std::string& name) const { return names.find(name) != names.end(); }
+	uint64_t GetResidentBytes() const { return residentBytes; }
+	uint32_t GetTextureCount() const { return static_cast<uint32_t>(textures.size()); }
+
+private:
+	// Levels no smaller than this on their longer side are streamed; the rest always stay resident
+	static constexpr uint32_t RESIDENT_TAIL_DIM = 64;
+	static constexpr uint32_t MAX_READS_IN_FLIGHT = 4;
+	static constexpr uint32_t MAX_TEXTURES = 256;
+
+	struct StreamedTexture
+	{
+		std::string path;
+		uint64_t blobOffset{ 0 };	// File offset of the asset's blob
+		assets::TextureInfo info;
+		std::vector<assets::TextureChunkRange> chunkRanges;
+		uint32_t tailMip{ 0 };		// First of the mips that are always resident
+
+		AllocatedImage image{ nullptr, nullptr, 0, VK_FORMAT_UNDEFINED };
+		VkImageView view{ VK_NULL_HANDLE };
+		uint32_t firstMip{ 0 };		// Finest level resident, level 0 of image
+
+		uint32_t wantedMip{ 0 };
+		int lastSeen{ -1 };			// Frame an object using it was last in view
+		bool reading{ false };
+
+		std::vector<Material*> materials;
+		VkSampler sampler{ VK_NULL_HANDLE };
+		std::vector<VkDescriptorSet> sets;		// One per frame in flight
+		std::vector<VkImageView> setViews;		// The view each set was last written with
+	};
+
+	// Decoded mips firstMip .. endMip - 1 of a texture, back from the workers
+	struct FinishedRead
+	{
+		uint32_t texture;
+		uint32_t firstMip;
+		uint32_t endMip;
+		std::vector<char> pixels;
+		bool ok;
+	};
+
+	// Image starts a texture's level firstMip, from decoded pixels for levels up to the ones it
+	// already holds and a GPU copy for the rest
+	bool Rebuild(StreamedTexture& texture, uint32_t firstMip, const char* pixels);
+	bool RequestMips(uint32_t index, uint32_t firstMip);
+	void ChooseMips(const RenderObject* objects, size_t count);
+	void FitBudget(uint64_t budgetBytes);
+	void WriteSet(StreamedTexture& texture, uint32_t frameIndex);
+
+	VulkanEngine* engine{ nullptr };
+	VkDescriptorSetLayout setLayout{ VK_NULL_HANDLE };
+	VkDescriptorPool descriptorPool{ VK_NULL_HANDLE };
+
+	std::vector<std::unique_ptr<StreamedTexture>> textures;
+	std::unordered_map<std::string, uint32_t> names;
+	std::unordered_map<const Material*, uint32_t> materialTextures;
+	uint64_t residentBytes{ 0 };		// Uncompressed size of every resident mip
+
+	// Images and views replaced by a rebuild, destroyed once no frame in flight can use them
+	struct Retired
+	{
+		AllocatedImage image;
+		VkImageView view;
+		int frame;
+	};
+	std::vector<Retired> retired;
+
+	assets::AssetIO io;
+	std::mutex finishedMutex;
+	std::vector<FinishedRead> finished;
+	uint32_t readsInFlight{ 0 };
+};
\ No newline at end of file
@@ -1,22 +1,47 @@
 #include "vk_textures.h"
 
 #include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <cmath>
 #include "debug.h"
 #include "vk_initializers.h"
 #include "asset_core.h"
 #include "texture_asset.h"
+#include "asset_archive.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 
 
+// Colour formats are sampled as sRGB; BC4 and BC5 hold data channels such as roughness or normals
+VkFormat vkutil::GetImageFormat(assets::TextureFormat format)
+{
+	switch (format)
+	{
+	case assets::TextureFormat::RGBA8:
+		return VK_FORMAT_R8G8B8A8_SRGB; // VK_FORMAT_R8G8B8A8_UNORM
+	case assets::TextureFormat::BC1:
+		return VK_FORMAT_BC1_RGB_SRGB_BLOCK;
+	case assets::TextureFormat::BC3:
+		return VK_FORMAT_BC3_SRGB_BLOCK;
+	case assets::TextureFormat::BC4:
+		return VK_FORMAT_BC4_UNORM_BLOCK;
+	case assets::TextureFormat::BC5:
+		return VK_FORMAT_BC5_UNORM_BLOCK;
+	case assets::TextureFormat::BC7:
+		return VK_FORMAT_BC7_SRGB_BLOCK;
+	default:
+		return VK_FORMAT_UNDEFINED;
+	}
+}
+
 bool vkutil::LoadImageFromAsset(VulkanEngine& engine, const char* filepath, AllocatedImage& outImage)
 {
-	assets::AssetFile asset;
-	std::vector<MipmapInfo> mips;
+	assets::AssetView asset;
 
 	START_TIMER( load )
-	bool loaded = assets::LoadBinary(filepath, asset);
+	bool loaded = assets::LoadBinaryMapped(filepath, asset, GetAssetVerifyFlags());
 	if (!loaded)
 	{
 		OutputMessage("Error loading cooked image asset: %s", filepath);
@@ -24,18 +49,46 @@ bool vkutil::LoadImageFromAsset(VulkanEngine& engine, const char* filepath, Allo
 	}
 	END_TIMER("Texture load", load)
 
-	assets::TextureInfo info = assets::ReadTextureInfo(&asset);
+	return LoadImageFromAsset(engine, asset, outImage);
+}
+
+bool vkutil::LoadImageFromAsset(VulkanEngine& engine, const assets::ArchiveReader& archive, const char* name, AllocatedImage& outImage)
+{
+	assets::AssetView asset;
 
-	VkDeviceSize compressedImageSize = info.dataSize;
-	VkFormat imageFmt{};
-	switch (info.textureFormat)
+	bool loaded = archive.LoadAsset(name, asset, GetAssetVerifyFlags());
+	if (!loaded)
 	{
-	case assets::TextureFormat::RGBA8:
-		imageFmt = VK_FORMAT_R8G8B8A8_SRGB; // VK_FORMAT_R8G8B8A8_UNORM
-		break;
-	default:
+		OutputMessage("Error loading cooked image asset from archive: %s", name);
+		return false;
+	}
+
+	return LoadImageFromAsset(engine, asset, outImage);
+}
+
+bool vkutil::LoadImageFromAsset(VulkanEngine& engine, const assets::AssetView& asset, AllocatedImage& outImage, uint32_t firstMip)
+{
+	std::vector<MipmapInfo> mips;
+
+	assets::TextureInfo info;
+	if (!assets::ReadTextureInfo(&asset, info) || info.pages.empty())
+	{
+		OutputMessage("Error reading cooked image metadata");
 		return false;
 	}
+	if (assets::IsTextureTiled(&info))
+	{
+		OutputMessage("Tiled textures are loaded through a TileCache: %s", info.sourceFile.c_str());
+		return false;
+	}
+
+	firstMip = std::min(firstMip, static_cast<uint32_t>(info.pages.size()) - 1);
+	const uint32_t mipCount = static_cast<uint32_t>(info.pages.size()) - firstMip;
+
+	VkDeviceSize compressedImageSize = assets::GetTextureMipsSize(&info, firstMip, mipCount);
+	const VkFormat imageFmt = GetImageFormat(info.textureFormat);
+	if (imageFmt == VK_FORMAT_UNDEFINED)
+		return false;
 
 	START_TIMER(upload)
 // 	VK_MEMORY_PROPERTY_HOST_CACHED_BIT
@@ -44,21 +97,34 @@ bool vkutil::LoadImageFromAsset(VulkanEngine& engine, const char* filepath, Allo
 	void* data;
 	vmaMapMemory(engine.allocator, stagingBuffer.allocation, &data);
 	size_t offset = 0;
-	for (int i = 0; i < info.pages.size(); ++i)
+	for (uint32_t i = firstMip; i < info.pages.size(); ++i)
 	{
 		MipmapInfo mip;
 		mip.dataOffset = offset;
 		mip.dataSize = info.pages[i].originalSize;
+		mip.width = info.pages[i].width;
+		mip.height = info.pages[i].height;
 		mips.push_back(mip);
 
-		assets::UnpackTexturePage(&info, i, asset.blob.data(), reinterpret_cast<char*>(data) + offset);
-
 		offset += mip.dataSize;
 	}
 
+	bool unpacked = assets::UnpackTextureMips(&info, firstMip, mipCount, asset.blob, asset.blobSize, reinterpret_cast<char*>(data));
+
+	// The content hash covers every mip, so it can only be checked on a full load
+	if (unpacked && firstMip == 0 && (GetAssetVerifyFlags() & assets::VerifyContent))
+		unpacked = assets::CheckTextureContent(&info, reinterpret_cast<char*>(data));
+
 	vmaUnmapMemory(engine.allocator, stagingBuffer.allocation);
 
-	outImage = UploadMipmappedImage(info.pages[0].width, info.pages[0].height, imageFmt, engine, stagingBuffer, mips);
+	if (!unpacked)
+	{
+		OutputMessage("Error unpacking cooked image: %s", info.sourceFile.c_str());
+		vmaDestroyBuffer(engine.allocator, stagingBuffer.buffer, stagingBuffer.allocation);
+		return false;
+	}
+
+	outImage = UploadMipmappedImage(mips[0].width, mips[0].height, imageFmt, engine, stagingBuffer, mips);
 
 	vmaDestroyBuffer(engine.allocator, stagingBuffer.buffer, stagingBuffer.allocation);
 	END_TIMER("Texture upload", upload)
@@ -66,6 +132,190 @@ bool vkutil::LoadImageFromAsset(VulkanEngine& engine, const char* filepath, Allo
 	return true;
 }
 
+bool vkutil::LoadImageStreamed(VulkanEngine& engine, const char* path, uint64_t offset, AllocatedImage& outImage, uint32_t firstMip)
+{
+	assets::AssetFile header;
+	uint64_t blobOffset = 0;
+	uint64_t blobSize = 0;
+	if (!assets::LoadBinaryHeader(path, offset, header, blobOffset, blobSize))
+	{
+		OutputMessage("Error loading cooked image asset: %s", path);
+		return false;
+	}
+
+	assets::TextureInfo info;
+	if (!assets::ReadTextureInfo(&header, info))
+	{
+		OutputMessage("Error reading cooked image metadata: %s", path);
+		return false;
+	}
+	const VkFormat imageFmt = GetImageFormat(info.textureFormat);
+	if (info.pages.empty() || imageFmt == VK_FORMAT_UNDEFINED)
+		return false;
+	if (assets::GetTextureBlobSize(&info) > blobSize)
+	{
+		OutputMessage("Cooked image is truncated: %s", path);
+		return false;
+	}
+	if (assets::IsTextureTiled(&info))
+	{
+		OutputMessage("Tiled textures are loaded through a TileCache: %s", info.sourceFile.c_str());
+		return false;
+	}
+
+	const uint32_t blockDim = assets::GetTextureBlockDim(info.textureFormat);
+	StagingRing& ring = engine.stagingRing;
+
+	firstMip = std::min(firstMip, static_cast<uint32_t>(info.pages.size()) - 1);
+	const assets::PageLocation& firstPage = info.pageLocations[firstMip];
+
+	uint32_t largestChunk = 0;
+	for (size_t i = firstPage.firstChunk; i < info.chunks.size(); ++i)
+		largestChunk = std::max(largestChunk, info.chunks[i].originalSize);
+
+	// Files cooked before chunking hold each page as one block, which may not fit a ring segment
+	if (largestChunk > ring.GetSegmentSize())
+	{
+		assets::MappedFile file;
+		assets::AssetView asset;
+		if (!file.Open(path) || offset > file.Size()
+			|| !assets::ParseBinary(file.Data() + offset, file.Size() - offset, asset, GetAssetVerifyFlags()))
+			return false;
+		return LoadImageFromAsset(engine, asset, outImage, firstMip);
+	}
+
+	// Mips above firstMip are never read from disk
+	std::ifstream inFile(path, std::ios::binary);
+	inFile.seekg(blobOffset + firstPage.blobOffset);
+	if (!inFile.good())
+		return false;
+
+	START_TIMER(stream)
+
+	VkExtent3D imageExtent;
+	imageExtent.width = info.pages[firstMip].width;
+	imageExtent.height = info.pages[firstMip].height;
+	imageExtent.depth = 1;
+
+	VkImageCreateInfo dimgInfo = vkinit::ImageCreateInfo(imageFmt, VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT, imageExtent);
+	dimgInfo.mipLevels = static_cast<uint32_t>(info.pages.size()) - firstMip;
+
+	AllocatedImage newImage;
+	VmaAllocationCreateInfo dimgAllocInfo = {};
+	dimgAllocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+	vmaCreateImage(engine.allocator, &dimgInfo, &dimgAllocInfo, &newImage.image, &newImage.allocation, nullptr);
+
+	VkImageSubresourceRange range;
+	range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+	range.baseMipLevel = 0;
+	range.levelCount = dimgInfo.mipLevels;
+	range.baseArrayLayer = 0;
+	range.layerCount = 1;
+
+	VkImageMemoryBarrier imageBarrierToTransfer = {};
+	imageBarrierToTransfer.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+	imageBarrierToTransfer.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	imageBarrierToTransfer.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	imageBarrierToTransfer.image = newImage.image;
+	imageBarrierToTransfer.subresourceRange = range;
+	imageBarrierToTransfer.srcAccessMask = 0;
+	imageBarrierToTransfer.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+	vkCmdPipelineBarrier(ring.GetCommandBuffer(), VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageBarrierToTransfer);
+
+	// Chunks are stored in page order, so both hashes can be fed as the chunks go by. They cover
+	// the whole texture, so a partial load can't be checked against them.
+	const uint32_t verify = (firstMip == 0) ? GetAssetVerifyFlags() : assets::VerifyNone;
+	assets::StreamHash blobHash;
+	assets::StreamHash contentHash;
+
+	std::vector<assets::TextureChunkRange> chunkRanges = assets::GetTextureChunkRanges(&info);
+	std::vector<char> compressed;
+	bool unpacked = true;
+	for (size_t i = firstPage.firstChunk; i < info.chunks.size() && unpacked; ++i)
+	{
+		const assets::TextureChunk& chunk = info.chunks[i];
+		const assets::PageInfo& page = info.pages[chunkRanges[i].page];
+		// Rows of blocks for BCn; the last one may run past the bottom of the mip
+		const uint32_t rowPitch = page.originalSize / std::max(1u, assets::GetTextureBlockRows(info.textureFormat, page.height));
+
+		compressed.resize(chunk.compressedSize);
+		inFile.read(compressed.data(), chunk.compressedSize);
+		if (!inFile.good() || rowPitch == 0)
+		{
+			unpacked = false;
+			break;
+		}
+
+		if (verify & assets::VerifyBlob)
+			blobHash.Update(compressed.data(), chunk.compressedSize);
+
+		VkDeviceSize stagingOffset = 0;
+		char* staging = reinterpret_cast<char*>(ring.Allocate(chunk.originalSize, 16, stagingOffset));
+		unpacked = assets::UnpackTextureChunk(&info, i, compressed.data(), staging);
+		if (!unpacked)
+			break;
+
+		if (verify & assets::VerifyContent)
+			contentHash.Update(staging, chunk.originalSize);
+
+		VkBufferImageCopy copyRegion = {};
+		copyRegion.bufferOffset = stagingOffset;
+		copyRegion.bufferRowLength = 0;
+		copyRegion.bufferImageHeight = 0;
+		copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		copyRegion.imageSubresource.baseArrayLayer = 0;
+		copyRegion.imageSubresource.layerCount = 1;
+		copyRegion.imageSubresource.mipLevel = chunkRanges[i].page - firstMip;
+		const uint32_t firstRow = chunkRanges[i].pageOffset / rowPitch * blockDim;
+		copyRegion.imageOffset = { 0, static_cast<int32_t>(firstRow), 0 };
+		copyRegion.imageExtent = { page.width, std::min(chunk.originalSize / rowPitch * blockDim, page.height - firstRow), 1 };
+
+		vkCmdCopyBufferToImage(ring.GetCommandBuffer(), ring.GetBuffer(), newImage.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copyRegion);
+	}
+
+	VkImageMemoryBarrier imageBarrierToReadable = imageBarrierToTransfer;
+	imageBarrierToReadable.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	imageBarrierToReadable.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	imageBarrierToReadable.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	imageBarrierToReadable.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+	vkCmdPipelineBarrier(ring.GetCommandBuffer(), VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageBarrierToReadable);
+
+	ring.Flush();
+
+	if (unpacked && (verify & assets::VerifyBlob) && header.blobHash != 0 && blobHash.Digest() != header.blobHash)
+	{
+		OutputMessage("Blob checksum mismatch, file is corrupt or truncated: %s", path);
+		unpacked = false;
+	}
+	if (unpacked && (verify & assets::VerifyContent) && info.contentHash != 0 && contentHash.Digest() != info.contentHash)
+	{
+		OutputMessage("Content checksum mismatch: %s", path);
+		unpacked = false;
+	}
+
+	if (!unpacked)
+	{
+		OutputMessage("Error unpacking cooked image: %s", info.sourceFile.c_str());
+		vmaDestroyImage(engine.allocator, newImage.image, newImage.allocation);
+		return false;
+	}
+
+	engine.mainDeletionQueue.PushFunction([=, &engine]()
+		{
+			vmaDestroyImage(engine.allocator, newImage.image, newImage.allocation);
+		});
+
+	newImage.mipLevels = dimgInfo.mipLevels;
+	newImage.format = imageFmt;
+	outImage = newImage;
+
+	END_TIMER("Texture stream", stream)
+
+	return true;
+}
+
 bool vkutil::LoadImageFromFile(VulkanEngine& engine, const char* file, AllocatedImage& outImage)
 {
 	int width, height, channels;
@@ -153,6 +403,8 @@ bool vkutil::LoadImageFromFile(VulkanEngine& engine, const char* file, Allocated
 
 	OutputMessage("Texture loaded: %s\n", file);
 
+	newImage.mipLevels = 1;
+	newImage.format = imageFormat;
 	outImage = newImage;
 
 	return true;
@@ -219,6 +471,7 @@ AllocatedImage vkutil::UploadImage(int width, int height, VkFormat fmt, VulkanEn
 		});
 
 	newImage.mipLevels = 1;
+	newImage.format = fmt;
 	return newImage;
 }
 
@@ -259,6 +512,11 @@ AllocatedImage vkutil::UploadMipmappedImage(int width, int height, VkFormat fmt,
 
 			for (int i = 0; i < mips.size(); ++i)
 			{
+				// Block-compressed data covers whole blocks, but the copy has to stop at the mip's
+				// real edge, which for the smallest mips is inside the first block
+				const uint32_t levelWidth = std::max(1u, imageExtent.width >> i);
+				const uint32_t levelHeight = std::max(1u, imageExtent.height >> i);
+
 				VkBufferImageCopy copyRegion = {};
 				copyRegion.bufferOffset = mips[i].dataOffset;
 				copyRegion.bufferRowLength = 0;
@@ -267,12 +525,9 @@ AllocatedImage vkutil::UploadMipmappedImage(int width, int height, VkFormat fmt,
 				copyRegion.imageSubresource.baseArrayLayer = 0;
 				copyRegion.imageSubresource.layerCount = 1;
 				copyRegion.imageSubresource.mipLevel = i;
-				copyRegion.imageExtent = imageExtent;
+				copyRegion.imageExtent = { std::min(mips[i].width, levelWidth), std::min(mips[i].height, levelHeight), 1 };
 
 				vkCmdCopyBufferToImage(cmd, stagingBuffer.buffer, newImage.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copyRegion);
-
-				imageExtent.width /= 2;
-				imageExtent.height /= 2;
 			}
 
 			VkImageMemoryBarrier imageBarrierToReadable = imageBarrierToTransfer;
@@ -290,6 +545,259 @@ AllocatedImage vkutil::UploadMipmappedImage(int width, int height, VkFormat fmt,
 		});
 
 	newImage.mipLevels = dimgInfo.mipLevels;
+	newImage.format = fmt;
 
 	return newImage;
+}
+
+bool vkutil::TileCache::Init(VulkanEngine& engine, const char* path, uint64_t offset, uint32_t slotCount)
+{
+	assets::AssetFile header;
+	uint64_t blobSize = 0;
+	if (!assets::LoadBinaryHeader(path, offset, header, blobOffset, blobSize))
+	{
+		OutputMessage("Error loading cooked image asset: %s", path);
+		return false;
+	}
+
+	if (!assets::ReadTextureInfo(&header, info))
+	{
+		OutputMessage("Error reading cooked image metadata: %s", path);
+		return false;
+	}
+	format = GetImageFormat(info.textureFormat);
+	if (info.pages.empty() || format == VK_FORMAT_UNDEFINED || !assets::IsTextureTiled(&info) || slotCount == 0)
+	{
+		OutputMessage("Not a tiled texture: %s", path);
+		return false;
+	}
+	if (assets::GetTextureBlobSize(&info) > blobSize)
+	{
+		OutputMessage("Cooked image is truncated: %s", path);
+		return false;
+	}
+
+	const uint32_t tileDim = assets::GetTextureTileDim(&info);
+	slotColumns = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(slotCount))));
+	const uint32_t slotRows = (slotCount + slotColumns - 1) / slotColumns;
+	if (slotColumns * tileDim > engine.gpuProperties.limits.maxImageDimension2D || assets::GetTextureTileBytes(&info) > engine.stagingRing.GetSegmentSize())
+	{
+		OutputMessage("Tile cache of %u slots doesn't fit an image or staging segment: %s", slotCount, path);
+		return false;
+	}
+
+	file.open(path, std::ios::binary);
+	if (!file.good())
+		return false;
+
+	this->engine = &engine;
+	chunkRanges = assets::GetTextureChunkRanges(&info);
+	tileSlots.assign(info.chunks.size(), TILE_ABSENT);
+	slots.assign(slotCount, Slot{ ~0u, -1 });
+	queue.clear();
+
+	VkExtent3D imageExtent;
+	imageExtent.width = slotColumns * tileDim;
+	imageExtent.height = slotRows * tileDim;
+	imageExtent.depth = 1;
+
+	VkImageCreateInfo dimgInfo = vkinit::ImageCreateInfo(format, VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT, imageExtent);
+
+	VmaAllocationCreateInfo dimgAllocInfo = {};
+	dimgAllocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+	vmaCreateImage(engine.allocator, &dimgInfo, &dimgAllocInfo, &atlas.image, &atlas.allocation, nullptr);
+	atlas.mipLevels = 1;
+	atlas.format = format;
+
+	// Readable from the start, empty slots and all, so it can be bound before anything lands
+	VkImageMemoryBarrier imageBarrierToReadable = {};
+	imageBarrierToReadable.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+	imageBarrierToReadable.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	imageBarrierToReadable.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	imageBarrierToReadable.image = atlas.image;
+	imageBarrierToReadable.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+	imageBarrierToReadable.srcAccessMask = 0;
+	imageBarrierToReadable.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+	StagingRing& ring = engine.stagingRing;
+	vkCmdPipelineBarrier(ring.GetCommandBuffer(), VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageBarrierToReadable);
+	ring.Submit();
+
+	return true;
+}
+
+void vkutil::TileCache::Cleanup()
+{
+	if (engine != nullptr && atlas.image != nullptr)
+		vmaDestroyImage(engine->allocator, atlas.image, atlas.allocation);
+
+	atlas = { nullptr, nullptr, 0, VK_FORMAT_UNDEFINED };
+	file.close();
+	engine = nullptr;
+}
+
+uint32_t vkutil::TileCache::RequestTiles(float u0, float v0, float u1, float v1, uint32_t mip)
+{
+	if (engine == nullptr)
+		return 0;
+
+	mip = std::min(mip, static_cast<uint32_t>(info.pages.size()) - 1);
+	const assets::PageInfo& page = info.pages[mip];
+
+	// Texels the rect touches, its far edges included
+	auto firstTile = [this](float uv, uint32_t size)
+	{
+		const int texel = static_cast<int>(std::floor(uv * size));
+		return static_cast<uint32_t>(std::min(std::max(texel, 0), static_cast<int>(size) - 1)) / info.tileSize;
+	};
+	auto lastTile = [this](float uv, uint32_t size)
+	{
+		const int texel = static_cast<int>(std::ceil(uv * size)) - 1;
+		return static_cast<uint32_t>(std::min(std::max(texel, 0), static_cast<int>(size) - 1)) / info.tileSize;
+	};
+
+	const uint32_t x0 = firstTile(std::min(u0, u1), page.width);
+	const uint32_t x1 = lastTile(std::max(u0, u1), page.width);
+	const uint32_t y0 = firstTile(std::min(v0, v1), page.height);
+	const uint32_t y1 = lastTile(std::max(v0, v1), page.height);
+
+	uint32_t missing = 0;
+	for (uint32_t y = y0; y <= y1; ++y)
+	{
+		for (uint32_t x = x0; x <= x1; ++x)
+		{
+			const uint32_t tile = assets::GetTextureTileChunk(&info, mip, x, y);
+			int32_t& state = tileSlots[tile];
+			if (state >= 0)
+			{
+				slots[state].lastUsed = engine->frameNumber;
+				continue;
+			}
+
+			if (state == TILE_ABSENT)
+			{
+				state = TILE_QUEUED;
+				queue.push_back(tile);
+			}
+			++missing;
+		}
+	}
+
+	return missing;
+}
+
+// A free slot, or else the one requested longest ago, as long as that wasn't this frame
+int32_t vkutil::TileCache::AcquireSlot()
+{
+	int32_t oldest = -1;
+	for (int32_t i = 0; i < static_cast<int32_t>(slots.size()); ++i)
+	{
+		if (slots[i].tile == ~0u)
+			return i;
+		if (slots[i].lastUsed < engine->frameNumber && (oldest < 0 || slots[i].lastUsed < slots[oldest].lastUsed))
+			oldest = i;
+	}
+
+	if (oldest >= 0)
+	{
+		tileSlots[slots[oldest].tile] = TILE_ABSENT;
+		slots[oldest].tile = ~0u;
+	}
+	return oldest;
+}
+
+uint32_t vkutil::TileCache::Update(uint32_t maxTiles)
+{
+	if (engine == nullptr || queue.empty())
+		return 0;
+
+	StagingRing& ring = engine->stagingRing;
+	const uint32_t tileDim = assets::GetTextureTileDim(&info);
+	const uint32_t tileBytes = assets::GetTextureTileBytes(&info);
+
+	VkImageMemoryBarrier imageBarrierToTransfer = {};
+	imageBarrierToTransfer.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+	imageBarrierToTransfer.oldLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	imageBarrierToTransfer.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	imageBarrierToTransfer.image = atlas.image;
+	imageBarrierToTransfer.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+	imageBarrierToTransfer.srcAccessMask = 0;
+	imageBarrierToTransfer.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+	// Earlier frames may still be sampling the slots about to be overwritten
+	vkCmdPipelineBarrier(ring.GetCommandBuffer(), VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageBarrierToTransfer);
+
+	uint32_t uploaded = 0;
+	size_t next = 0;
+	for (; next < queue.size() && uploaded < maxTiles; ++next)
+	{
+		const uint32_t tile = queue[next];
+		const assets::TextureChunk& chunk = info.chunks[tile];
+
+		const int32_t slot = AcquireSlot();
+		if (slot < 0)
+			break;
+
+		compressed.resize(chunk.compressedSize);
+		file.seekg(blobOffset + chunkRanges[tile].blobOffset);
+		file.read(compressed.data(), chunk.compressedSize);
+
+		VkDeviceSize stagingOffset = 0;
+		char* staging = reinterpret_cast<char*>(ring.Allocate(tileBytes, 16, stagingOffset));
+		if (!file.good() || staging == nullptr || !assets::UnpackTextureChunk(&info, tile, compressed.data(), staging))
+		{
+			OutputMessage("Error reading tile %u of cooked image: %s", tile, info.sourceFile.c_str());
+			file.clear();
+			tileSlots[tile] = TILE_ABSENT;
+			continue;
+		}
+
+		const VkOffset2D origin = GetSlotOrigin(slot);
+
+		VkBufferImageCopy copyRegion = {};
+		copyRegion.bufferOffset = stagingOffset;
+		copyRegion.bufferRowLength = 0;
+		copyRegion.bufferImageHeight = 0;
+		copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		copyRegion.imageSubresource.baseArrayLayer = 0;
+		copyRegion.imageSubresource.layerCount = 1;
+		copyRegion.imageSubresource.mipLevel = 0;
+		copyRegion.imageOffset = { origin.x, origin.y, 0 };
+		copyRegion.imageExtent = { tileDim, tileDim, 1 };
+
+		vkCmdCopyBufferToImage(ring.GetCommandBuffer(), ring.GetBuffer(), atlas.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copyRegion);
+
+		slots[slot] = Slot{ tile, engine->frameNumber };
+		tileSlots[tile] = slot;
+		++uploaded;
+	}
+	queue.erase(queue.begin(), queue.begin() + next);
+
+	VkImageMemoryBarrier imageBarrierToReadable = imageBarrierToTransfer;
+	imageBarrierToReadable.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	imageBarrierToReadable.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	imageBarrierToReadable.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	imageBarrierToReadable.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+	vkCmdPipelineBarrier(ring.GetCommandBuffer(), VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageBarrierToReadable);
+
+	// Submitted without waiting: the frame's own submission comes later on the same queue
+	ring.Submit();
+
+	return uploaded;
+}
+
+int32_t vkutil::TileCache::FindTile(uint32_t mip, uint32_t x, uint32_t y) const
+{
+	if (mip >= info.pages.size() || x >= assets::GetTextureTileColumns(&info, mip) || y >= assets::GetTextureTileRows(&info, mip))
+		return -1;
+
+	const int32_t state = tileSlots[assets::GetTextureTileChunk(&info, mip, x, y)];
+	return (state >= 0) ? state : -1;
+}
+
+VkOffset2D vkutil::TileCache::GetSlotOrigin(uint32_t slot) const
+{
+	const uint32_t tileDim = assets::GetTextureTileDim(&info);
+	return { static_cast<int32_t>(slot % slotColumns * tileDim), static_cast<int32_t>(slot / slotColumns * tileDim) };
 }
\ No newline at end of file
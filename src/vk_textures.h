@@ -1,7 +1,15 @@
 #pragma once
 
+#include <fstream>
 #include "vk_types.h"
 #include "vk_engine.h"
+#include "texture_asset.h"
+
+namespace assets
+{
+	struct AssetView;
+	class ArchiveReader;
+}
 
 namespace vkutil
 {
@@ -9,11 +17,77 @@ namespace vkutil
 	{
 		size_t dataSize;
 		size_t dataOffset;
+		uint32_t width;
+		uint32_t height;
 	};
 
+	// Vulkan format a cooked texture format is uploaded and sampled as, VK_FORMAT_UNDEFINED if none
+	VkFormat GetImageFormat(assets::TextureFormat format);
+
 	bool LoadImageFromAsset(VulkanEngine& engine, const char* file, AllocatedImage& outImage);
+	bool LoadImageFromAsset(VulkanEngine& engine, const assets::ArchiveReader& archive, const char* name, AllocatedImage& outImage);
+	// firstMip drops the larger mips: the image starts at that level and nothing above it is decoded
+	bool LoadImageFromAsset(VulkanEngine& engine, const assets::AssetView& asset, AllocatedImage& outImage, uint32_t firstMip = 0);
+	// Reads and decodes the texture stored at offset in path one chunk at a time, through the engine's staging ring
+	bool LoadImageStreamed(VulkanEngine& engine, const char* path, uint64_t offset, AllocatedImage& outImage, uint32_t firstMip = 0);
 	bool LoadImageFromFile(VulkanEngine& engine, const char* file, AllocatedImage& outImage);
 
 	AllocatedImage UploadImage(int width, int height, VkFormat fmt, VulkanEngine& engine, AllocatedBuffer& stagingBuffer);
 	AllocatedImage UploadMipmappedImage(int width, int height, VkFormat fmt, VulkanEngine& engine, AllocatedBuffer& stagingBuffer, ::std::vector<MipmapInfo> mips);
+
+	// Holds the requested tiles of one tiled texture in a fixed atlas image of tile-sized slots.
+	// Only the texture's metadata stays in memory: tiles are read from the file, decoded and
+	// uploaded through the engine's staging ring as they're asked for, and when the atlas is full
+	// the slots least recently requested are reused. Tiles requested this frame are never evicted.
+	class TileCache
+	{
+	public:
+		// Opens the tiled texture stored at offset in path, with room for slotCount tiles
+		bool Init(VulkanEngine& engine, const char* path, uint64_t offset, uint32_t slotCount);
+		// Destroys the atlas, so only call it once the GPU is done with it
+		void Cleanup();
+
+		// Queues the tiles of mip under the UV rect [u0, u1] x [v0, v1], clamped to the texture,
+		// and marks the resident ones as used this frame. Returns how many aren't resident yet.
+		uint32_t RequestTiles(float u0, float v0, float u1, float v1, uint32_t mip);
+		// Uploads up to maxTiles queued tiles in the order they were requested, stopping early if
+		// every slot holds a tile requested this frame. Returns how many were uploaded.
+		uint32_t Update(uint32_t maxTiles);
+
+		// Slot holding tile (x, y) of mip, or -1 when it isn't resident
+		int32_t FindTile(uint32_t mip, uint32_t x, uint32_t y) const;
+		// Top left of a slot in the atlas; the tile's own texels start tileBorder in from there
+		VkOffset2D GetSlotOrigin(uint32_t slot) const;
+
+		const assets::TextureInfo& GetInfo() const { return info; }
+		VkImage GetAtlas() const { return atlas.image; }
+		VkFormat GetFormat() const { return format; }
+
+	private:
+		static constexpr int32_t TILE_ABSENT = -1;
+		static constexpr int32_t TILE_QUEUED = -2;
+
+		struct Slot
+		{
+			uint32_t tile;		// Chunk index of the tile it holds, ~0u when free
+			int lastUsed;		// Frame it was last requested in
+		};
+
+		int32_t AcquireSlot();
+
+		VulkanEngine* engine{ nullptr };
+		assets::TextureInfo info;
+		std::vector<assets::TextureChunkRange> chunkRanges;
+		std::ifstream file;
+		uint64_t blobOffset{ 0 };
+		std::vector<char> compressed;
+
+		AllocatedImage atlas{ nullptr, nullptr, 0, VK_FORMAT_UNDEFINED };
+		VkFormat format{ VK_FORMAT_UNDEFINED };
+		uint32_t slotColumns{ 0 };
+
+		std::vector<Slot> slots;
+		std::vector<int32_t> tileSlots;		// Per tile, by chunk index: a slot, TILE_ABSENT or TILE_QUEUED
+		std::vector<uint32_t> queue;
+	};
 }
\ No newline at end of file
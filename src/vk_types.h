@@ -16,4 +16,5 @@ struct AllocatedImage
 	VkImage image;
 	VmaAllocation allocation;
 	int mipLevels;
+	VkFormat format;
 };
\ No newline at end of file